@@ -201,6 +201,36 @@ export declare const enum EBoundsType {
     ScaleToHeight = 5,
     MaxOnly = 6
 }
+export declare const enum ESnapshotField {
+    ItemUidLow = 0,
+    ItemUidHigh = 1,
+    SourceUidLow = 2,
+    SourceUidHigh = 3,
+    ItemIdLow = 4,
+    ItemIdHigh = 5,
+    SourceType = 6,
+    Flags = 7,
+    PositionX = 8,
+    PositionY = 9,
+    ScaleX = 10,
+    ScaleY = 11,
+    Rotation = 12,
+    Alignment = 13,
+    BoundsX = 14,
+    BoundsY = 15,
+    BoundsType = 16,
+    BoundsAlignment = 17,
+    CropLeft = 18,
+    CropTop = 19,
+    CropRight = 20,
+    CropBottom = 21,
+    ScaleFilter = 22
+}
+export declare const enum ESnapshotFlags {
+    Visible = 1,
+    Selected = 2,
+    Locked = 4
+}
 export declare const enum EColorSpace {
     Default = 0,
     CS601 = 1,
@@ -261,6 +291,10 @@ export declare const IPC: IIPC;
 export interface ISettings {
     [key: string]: any;
 }
+export interface ISettingsPatch {
+    path: string;
+    value: boolean | number | string | ISettings | ISettings[];
+}
 export interface IVec2 {
     readonly x: number;
     readonly y: number;
@@ -278,6 +312,30 @@ export interface ITransformInfo {
     readonly boundsAlignment: number;
     readonly bounds: IVec2;
 }
+export interface ISceneSnapshot {
+    readonly count: number;
+    readonly stride: number;
+    readonly buffer: ArrayBuffer;
+    readonly f32: Float32Array;
+    readonly u32: Uint32Array;
+    readonly i32: Int32Array;
+    readonly names: string[];
+    readonly types: string[];
+}
+export interface ISceneItemUpdate {
+    item: ISceneItem;
+    position?: IVec2;
+    scale?: IVec2;
+    rotation?: number;
+    alignment?: EAlignment;
+    bounds?: IVec2;
+    boundsType?: EBoundsType;
+    boundsAlignment?: number;
+    crop?: ICropInfo;
+    scaleFilter?: EScaleType;
+    visible?: boolean;
+    selected?: boolean;
+}
 export interface ICropInfo {
     readonly left: number;
     readonly right: number;
@@ -485,9 +543,12 @@ export interface IFilter extends ISource {
 }
 export interface IInputFactory extends IFactoryTypes {
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): IInput;
+    createAsync(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): Promise<IInput>;
     createPrivate(id: string, name: string, settings?: ISettings): IInput;
     fromName(name: string): IInput;
     getPublicSources(): IInput[];
+    getTypeProperties(id: string): IProperties;
+    getTypeDefaults(id: string): ISettings;
 }
 export declare const enum EInteractionFlags {
     None = 0,
@@ -546,6 +607,7 @@ export interface IInput extends ISource {
 }
 export interface ISceneFactory {
     create(name: string): IScene;
+    createAsync(name: string): Promise<IScene>;
     createPrivate(name: string): IScene;
     fromName(name: string): IScene;
 }
@@ -557,6 +619,8 @@ export interface IScene extends ISource {
     findItem(id: string | number): ISceneItem;
     getItemAtIdx(idx: number): ISceneItem;
     getItems(): ISceneItem[];
+    getSnapshot(): ISceneSnapshot;
+    updateItems(updates: ISceneItemUpdate[]): number[];
     connect(sigType: ESceneSignalType, cb: (info: ISettings) => void): ICallbackData;
     disconnect(data: ICallbackData): void;
 }
@@ -575,6 +639,7 @@ export interface ISceneItem {
     scaleFilter: EScaleType;
     visible: boolean;
     readonly transformInfo: ITransformInfo;
+    getTransformInfoAsync(): Promise<ITransformInfo>;
     crop: ICropInfo;
     moveUp(): void;
     moveDown(): void;
@@ -582,6 +647,7 @@ export interface ISceneItem {
     moveBottom(): void;
     move(position: number): void;
     remove(): void;
+    removeAsync(): Promise<void>;
     deferUpdateBegin(): void;
     deferUpdateEnd(): void;
 }
@@ -601,6 +667,10 @@ export interface IConfigurable {
     readonly configurable: boolean;
     readonly properties: IProperties;
     readonly settings: ISettings;
+    updateAsync(settings: ISettings): Promise<boolean>;
+    patchSettings(patch: ISettingsPatch[]): void;
+    getPropertiesAsync(): Promise<IProperties>;
+    getSettingsAsync(): Promise<ISettings>;
 }
 export interface ISource extends IConfigurable, IReleasable {
     remove(): void;
@@ -279,6 +279,42 @@ export const enum EBoundsType {
     MaxOnly
 }
 
+/**
+ * Word offsets into one record of an {@link ISceneSnapshot}.
+ * 64-bit handles are split in two words, low word first.
+ */
+export const enum ESnapshotField {
+    ItemUidLow = 0,
+    ItemUidHigh = 1,
+    SourceUidLow = 2,
+    SourceUidHigh = 3,
+    ItemIdLow = 4,
+    ItemIdHigh = 5,
+    SourceType = 6,
+    Flags = 7,
+    PositionX = 8,
+    PositionY = 9,
+    ScaleX = 10,
+    ScaleY = 11,
+    Rotation = 12,
+    Alignment = 13,
+    BoundsX = 14,
+    BoundsY = 15,
+    BoundsType = 16,
+    BoundsAlignment = 17,
+    CropLeft = 18,
+    CropTop = 19,
+    CropRight = 20,
+    CropBottom = 21,
+    ScaleFilter = 22
+}
+
+export const enum ESnapshotFlags {
+    Visible = 1,
+    Selected = 2,
+    Locked = 4
+}
+
 export const enum EColorSpace {
     Default,
     CS601,
@@ -349,6 +385,15 @@ export interface ISettings {
     [key: string]: any;
 }
 
+/**
+ * A single change to a settings object
+ */
+export interface ISettingsPatch {
+    /** Dot separated keys, e.g. 'font.size' */
+    path: string;
+    value: boolean | number | string | ISettings | ISettings[];
+}
+
 /**
  * Used for various 2-dimensional functions
  */
@@ -380,6 +425,45 @@ export interface ITransformInfo {
     readonly bounds: IVec2;
 }
 
+/**
+ * Every item of a scene, fetched in a single call.
+ *
+ * Item i is the record of `stride` words starting at `i * stride`, see
+ * {@link ESnapshotField}. Read float fields (position, scale, rotation,
+ * bounds) through `f32`, crop through `i32` and everything else through `u32`.
+ */
+export interface ISceneSnapshot {
+    readonly count: number;
+    readonly stride: number;
+    readonly buffer: ArrayBuffer;
+    readonly f32: Float32Array;
+    readonly u32: Uint32Array;
+    readonly i32: Int32Array;
+    /** Source name of each item */
+    readonly names: string[];
+    /** Source type id of each item */
+    readonly types: string[];
+}
+
+/**
+ * Changes to apply to one item with {@link IScene.updateItems}.
+ * Fields left undefined are not touched.
+ */
+export interface ISceneItemUpdate {
+    item: ISceneItem;
+    position?: IVec2;
+    scale?: IVec2;
+    rotation?: number;
+    alignment?: EAlignment;
+    bounds?: IVec2;
+    boundsType?: EBoundsType;
+    boundsAlignment?: number;
+    crop?: ICropInfo;
+    scaleFilter?: EScaleType;
+    visible?: boolean;
+    selected?: boolean;
+}
+
 /**
  * Interface describing the crop of an item.
  */
@@ -884,6 +968,13 @@ export interface IInputFactory extends IFactoryTypes {
      */
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): IInput;
 
+    /**
+     * Same as {@link create}, without blocking the event loop
+     * while the input is being created.
+     * @returns - Resolves with the instance, rejects on failure
+     */
+    createAsync(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): Promise<IInput>;
+
     /**
      * Create a new instance of an ObsInput that's private
      * Private in this context means any function that returns an 
@@ -906,6 +997,19 @@ export interface IInputFactory extends IFactoryTypes {
      * Fetches a list of all public input sources available.
      */
     getPublicSources(): IInput[];
+
+    /**
+     * Obtains the properties of an input type with its default values,
+     * without creating an input. Cached until modules load or the locale changes.
+     * @param id - The type of input source, possibly from {@link types}
+     */
+    getTypeProperties(id: string): IProperties;
+
+    /**
+     * Obtains the default settings of an input type.
+     * @param id - The type of input source, possibly from {@link types}
+     */
+    getTypeDefaults(id: string): ISettings;
 }
 
 
@@ -1034,6 +1138,13 @@ export interface ISceneFactory {
      */
     create(name: string): IScene;
 
+    /**
+     * Same as {@link create}, without blocking the event loop
+     * @param name - Name of the scene to create
+     * @returns - Resolves with the instance, rejects on failure
+     */
+    createAsync(name: string): Promise<IScene>;
+
     /**
      * Create a new scene instance that's private
      * @param name - Name of the scene to create
@@ -1106,6 +1217,22 @@ export interface IScene extends ISource {
      */
     getItems(): ISceneItem[];
 
+    /**
+     * Fetch all items within the scene along with their source, transform,
+     * crop, bounds and flags
+     * @returns - Packed records of every item, in scene order
+     */
+    getSnapshot(): ISceneSnapshot;
+
+    /**
+     * Apply changes to many items of this scene at once. Every item gets
+     * a single transform update and the whole list is applied under one
+     * scene lock.
+     * @param updates - Items and the fields to change on each
+     * @returns - One status per update, 0 if it was applied
+     */
+    updateItems(updates: ISceneItemUpdate[]): number[];
+
     /**
      * Connect a callback to a particular signal 
      * associated with this scene. 
@@ -1173,6 +1300,9 @@ export interface ISceneItem {
      */
     readonly transformInfo: ITransformInfo;
 
+    /** Same as {@link transformInfo}, without blocking the event loop */
+    getTransformInfoAsync(): Promise<ITransformInfo>;
+
     /** Current crop applied to the item */
     crop: ICropInfo;
 
@@ -1197,6 +1327,9 @@ export interface ISceneItem {
     /** Remove the item from the scene it's attached to (destroys the item!) */
     remove(): void;
 
+    /** Same as {@link remove}, without blocking the event loop */
+    removeAsync(): Promise<void>;
+
     /** Prevent updating of the item to prevent data races */
     deferUpdateBegin(): void;
 
@@ -1283,6 +1416,25 @@ export interface IConfigurable {
      * Object holding current settings of the source
      */
     readonly settings: ISettings;
+
+    /**
+     * Same as {@link update}, without blocking the event loop
+     * while the source applies its new settings.
+     */
+    updateAsync(settings: ISettings): Promise<boolean>;
+
+    /**
+     * Changes only the given settings. Patches received within the
+     * same video frame are merged and applied with a single update.
+     * @param patch - Changes to apply, in order
+     */
+    patchSettings(patch: ISettingsPatch[]): void;
+
+    /** Same as {@link properties}, without blocking the event loop */
+    getPropertiesAsync(): Promise<IProperties>;
+
+    /** Same as {@link settings}, without blocking the event loop */
+    getSettingsAsync(): Promise<ISettings>;
 }
 
 /**
@@ -0,0 +1,171 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#include "async-call.hpp"
+#include <list>
+#include <mutex>
+#include <uv.h>
+#include "controller.hpp"
+#include "error.hpp"
+
+namespace async
+{
+	struct pending_call
+	{
+		std::vector<ipc::value>                response;
+		resolver_t                             resolver;
+		Nan::Persistent<v8::Promise::Resolver> promise;
+		Nan::Persistent<v8::Object>            self;
+	};
+
+	// Replies arrive on the IPC reader threads and are settled in batches on
+	//  the loop thread. The handle only keeps the loop alive while calls are
+	//  outstanding.
+	static uv_async_t*              completion  = nullptr;
+	static size_t                   outstanding = 0;
+	static std::mutex               completed_lock;
+	static std::list<pending_call*> completed;
+
+	// Same checks as ValidateResponse, without throwing.
+	static bool validate(const std::vector<ipc::value>& response, std::string& error, bool& invalid_reference)
+	{
+		invalid_reference = false;
+
+		if (response.size() == 0) {
+			error = "Failed to make IPC call, verify IPC status.";
+			return false;
+		}
+
+		if ((response.size() == 1) && (response[0].type == ipc::type::Null)) {
+			error = response[0].value_str;
+			return false;
+		}
+
+		ErrorCode code = (ErrorCode)response[0].value_union.ui64;
+		if (code != ErrorCode::Ok) {
+			if (response.size() == 1) {
+				error = "Error without description.";
+				return false;
+			}
+
+			invalid_reference = (code == ErrorCode::InvalidReference);
+			error             = response[1].value_str;
+			return false;
+		}
+
+		return true;
+	}
+
+	static void settle(pending_call* call)
+	{
+		Nan::HandleScope                 scope;
+		v8::Local<v8::Promise::Resolver> promise = Nan::New(call->promise);
+		v8::Local<v8::Object>            self;
+		if (!call->self.IsEmpty())
+			self = Nan::New(call->self);
+
+		std::string error;
+		bool        invalid_reference;
+		if (!validate(call->response, error, invalid_reference)) {
+			v8::Local<v8::Value> exception =
+			    invalid_reference ? Nan::ReferenceError(error.c_str()) : Nan::Error(error.c_str());
+			promise->Reject(Nan::GetCurrentContext(), exception).FromMaybe(false);
+			return;
+		}
+
+		if (!call->resolver) {
+			promise->Resolve(Nan::GetCurrentContext(), Nan::Undefined()).FromMaybe(false);
+			return;
+		}
+
+		// Resolvers may throw like their synchronous counterparts, turn that into a rejection.
+		Nan::TryCatch        tc;
+		v8::Local<v8::Value> value = call->resolver(call->response, self);
+		if (tc.HasCaught()) {
+			promise->Reject(Nan::GetCurrentContext(), tc.Exception()).FromMaybe(false);
+			return;
+		}
+		promise->Resolve(Nan::GetCurrentContext(), value.IsEmpty() ? Nan::Undefined() : value).FromMaybe(false);
+	}
+
+	static void on_completion(uv_async_t*)
+	{
+		std::list<pending_call*> calls;
+		{
+			std::unique_lock<std::mutex> ul(completed_lock);
+			calls.swap(completed);
+		}
+
+		for (pending_call* call : calls) {
+			settle(call);
+			call->promise.Reset();
+			call->self.Reset();
+			delete call;
+		}
+
+		outstanding -= calls.size();
+		if (outstanding == 0)
+			uv_unref((uv_handle_t*)completion);
+
+		// Node only runs microtasks after callbacks it made itself.
+		v8::Isolate::GetCurrent()->RunMicrotasks();
+	}
+
+	static void complete(pending_call* call)
+	{
+		std::unique_lock<std::mutex> ul(completed_lock);
+		completed.push_back(call);
+		uv_async_send(completion);
+	}
+} // namespace async
+
+v8::Local<v8::Promise> async::call(
+    const std::string&      cname,
+    const std::string&      fname,
+    std::vector<ipc::value> args,
+    resolver_t              resolver,
+    v8::Local<v8::Object>   self)
+{
+	if (!completion) {
+		completion = new uv_async_t;
+		uv_async_init(uv_default_loop(), completion, on_completion);
+		uv_unref((uv_handle_t*)completion);
+	}
+
+	v8::Local<v8::Promise::Resolver> promise = v8::Promise::Resolver::New(Nan::GetCurrentContext()).ToLocalChecked();
+
+	pending_call* pending = new pending_call;
+	pending->resolver     = std::move(resolver);
+	pending->promise.Reset(promise);
+	if (!self.IsEmpty())
+		pending->self.Reset(self);
+
+	if (outstanding++ == 0)
+		uv_ref((uv_handle_t*)completion);
+
+	uint64_t id = Controller::GetInstance().call(
+	    cname, fname, std::move(args), [pending](const std::vector<ipc::value>& response) {
+		    pending->response = response;
+		    complete(pending);
+	    });
+	if (id == 0) {
+		// Not sent, settles as a failed IPC call.
+		complete(pending);
+	}
+
+	return promise->GetPromise();
+}
@@ -0,0 +1,46 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include <nan.h>
+#include "ipc-value.hpp"
+
+// Promise-returning IPC calls.
+//
+// The call is sent as a pipelined Controller::call, so the event loop keeps
+//  running while the server works and any number of calls can be in flight.
+//  The promise is settled on the loop thread: errors reject with the same
+//  message the synchronous variant would throw, successful replies are handed
+//  to the resolver to build the result.
+namespace async
+{
+	// Builds the resolved value from a reply whose first entry is ErrorCode::Ok.
+	// `self` is the object the call was made on, kept alive until the reply
+	//  arrives, or empty for free functions.
+	typedef std::function<v8::Local<v8::Value>(std::vector<ipc::value>& response, v8::Local<v8::Object> self)>
+	    resolver_t;
+
+	v8::Local<v8::Promise> call(
+	    const std::string&      cname,
+	    const std::string&      fname,
+	    std::vector<ipc::value> args,
+	    resolver_t              resolver = nullptr,
+	    v8::Local<v8::Object>   self     = v8::Local<v8::Object>());
+} // namespace async
@@ -19,6 +19,7 @@
 #include "callback-manager.hpp"
 #include "controller.hpp"
 #include "error.hpp"
+#include "event-bus.hpp"
 #include "utility-v8.hpp"
 
 #include <node.h>
@@ -71,23 +72,37 @@ void CallbackManager::callback_handler(void* data, std::shared_ptr<SourceSizeInf
 	args[0] = rslt;
 	Nan::Call(m_callback_function, 1, args);
 }
-void CallbackManager::start_worker()
+void CallbackManager::subscribe()
 {
-	if (!m_worker_stop)
-		return;
-	// Launch worker thread.
-	m_worker_stop = false;
-	m_worker      = std::thread(std::bind(&CallbackManager::worker, this));
+	EventBus::GetInstance().subscribe(event_frame::type::source_size, [this](event_frame::reader& payload) {
+		std::shared_ptr<SourceSizeInfoData> data = std::make_shared<SourceSizeInfoData>();
+
+		uint32_t count = 0;
+		payload.read(count);
+		for (uint32_t idx = 0; idx < count; idx++) {
+			SourceSizeInfo* item = new SourceSizeInfo;
+
+			uint64_t uid;
+			payload.read(uid);
+			payload.read(item->name);
+			payload.read(item->width);
+			payload.read(item->height);
+			if (!payload.read(item->flags)) {
+				delete item;
+				break;
+			}
+			data->items.push_back(item);
+		}
+		if (data->items.empty())
+			return;
+
+		data->param = this;
+		m_async_callback->queue(std::move(data));
+	});
 }
-void CallbackManager::stop_worker()
+void CallbackManager::unsubscribe()
 {
-	if (m_worker_stop != false)
-		return;
-	// Stop worker thread.
-	m_worker_stop = true;
-	if (m_worker.joinable()) {
-		m_worker.join();
-	}
+	EventBus::GetInstance().unsubscribe(event_frame::type::source_size);
 }
 
 static v8::Persistent<v8::Object> cm_CallbackObject;
@@ -108,56 +123,10 @@ void RegisterSourceCallback(const v8::FunctionCallbackInfo<v8::Value>& args)
 	cm->m_callback_function.Reset(callback);
 	cm->start_async_runner();
 	cm->set_keepalive(args.This());
-	cm->start_worker();
+	cm->subscribe();
 	args.GetReturnValue().Set(utilv8::ToValue(true));
 }
 
-void CallbackManager::worker()
-{
-	size_t totalSleepMS = 0;
-
-	while (!m_worker_stop) {
-		auto tp_start = std::chrono::high_resolution_clock::now();
-
-		// Validate Connection
-		auto conn = Controller::GetInstance().GetConnection();
-		if (!conn) {
-			goto do_sleep;
-		}
-
-		// Call
-		{
-			std::vector<ipc::value> response = conn->call_synchronous_helper("CallbackManager", "QuerySourceSize", {});
-			if (!response.size() || (response.size() == 1)) {
-				goto do_sleep;
-			}
-
-			ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-			if (error == ErrorCode::Ok) {
-				std::shared_ptr<SourceSizeInfoData> data = std::make_shared<SourceSizeInfoData>();
-				for (int i = 2; i < (response[1].value_union.ui32*4) + 2; i++) {
-					SourceSizeInfo* item = new SourceSizeInfo;
-
-					item->name   = response[i++].value_str;
-					item->width  = response[i++].value_union.ui32;
-					item->height = response[i++].value_union.ui32;
-					item->flags  = response[i].value_union.ui32;
-					data->items.push_back(item);
-				}
-				data->param = this;
-				m_async_callback->queue(std::move(data));
-			}
-		}
-
-	do_sleep:
-		auto tp_end  = std::chrono::high_resolution_clock::now();
-		auto dur     = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
-		totalSleepMS = sleepIntervalMS - dur.count();
-		std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
-	}
-	return;
-}
-
 void CallbackManager::set_keepalive(v8::Local<v8::Object> obj)
 {
 	if (!m_async_callback)
@@ -167,7 +136,7 @@ void CallbackManager::set_keepalive(v8::Local<v8::Object> obj)
 
 void RemoveSourceCallback(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
-	cm->stop_worker();
+	cm->unsubscribe();
 	cm->stop_async_runner();
 }
 
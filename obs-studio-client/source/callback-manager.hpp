@@ -48,11 +48,7 @@ class CallbackManager : public Nan::ObjectWrap,
 	friend utilv8::ManagedObject<CallbackManager>;
 	friend utilv8::CallbackData<SourceSizeInfoData, CallbackManager>;
 
-	uint32_t sleepIntervalMS = 1000;
-
 	public:
-	std::thread   m_worker;
-	bool          m_worker_stop = true;
 	std::mutex    m_worker_lock;
 	cm_Callback*  m_async_callback = nullptr;
 	Nan::Callback m_callback_function;
@@ -63,9 +59,8 @@ class CallbackManager : public Nan::ObjectWrap,
 	void start_async_runner();
 	void stop_async_runner();
 	void callback_handler(void* data, std::shared_ptr<SourceSizeInfoData> sourceSizes);
-	void start_worker();
-	void stop_worker();
-	void worker();
+	void subscribe();
+	void unsubscribe();
 	void set_keepalive(v8::Local<v8::Object>);
 
 	std::list<cm_Callback*> callbacks;
@@ -226,7 +226,7 @@ static void write_pid_file(std::string& pid_path, uint64_t pid)
 
 #endif
 
-Controller::Controller() {}
+Controller::Controller() : m_nextRequestId(1) {}
 
 Controller::~Controller() {}
 
@@ -306,6 +306,7 @@ std::shared_ptr<ipc::client> Controller::connect(
 		return nullptr;
 	}
 
+	m_uri        = uri;
 	m_connection = cl;
 	return m_connection;
 }
@@ -316,6 +317,11 @@ void Controller::disconnect()
 		m_connection->call_synchronous_helper("System", "Shutdown", {});
 		m_isServer = false;
 	}
+	{
+		std::unique_lock<std::mutex> ulock(m_eventConnectionMtx);
+		m_eventConnection = nullptr;
+	}
+	FailPending();
 	m_connection = nullptr;
 }
 
@@ -324,6 +330,70 @@ std::shared_ptr<ipc::client> Controller::GetConnection()
 	return m_connection;
 }
 
+std::shared_ptr<ipc::client> Controller::GetEventConnection()
+{
+	std::unique_lock<std::mutex> ulock(m_eventConnectionMtx);
+	if (m_eventConnection || !m_connection)
+		return m_eventConnection;
+
+	try {
+		m_eventConnection = std::make_shared<ipc::client>(m_uri);
+	} catch (...) {
+		m_eventConnection = nullptr;
+	}
+	return m_eventConnection;
+}
+
+uint64_t Controller::call(
+    const std::string& cname, const std::string& fname, std::vector<ipc::value> args, reply_t reply)
+{
+	auto conn = m_connection;
+	if (!conn)
+		return 0;
+
+	uint64_t id = m_nextRequestId++;
+	{
+		std::unique_lock<std::mutex> ulock(m_pendingMtx);
+		m_pending.emplace(id, std::move(reply));
+	}
+
+	if (!conn->call(cname, fname, std::move(args), OnReply, reinterpret_cast<void*>(uintptr_t(id)))) {
+		std::unique_lock<std::mutex> ulock(m_pendingMtx);
+		m_pending.erase(id);
+		return 0;
+	}
+	return id;
+}
+
+void Controller::OnReply(const void* data, const std::vector<ipc::value>& response)
+{
+	Controller& self = GetInstance();
+	uint64_t    id   = uint64_t(reinterpret_cast<uintptr_t>(data));
+
+	reply_t reply;
+	{
+		std::unique_lock<std::mutex> ulock(self.m_pendingMtx);
+		auto                         found = self.m_pending.find(id);
+		if (found == self.m_pending.end())
+			return;
+		reply = std::move(found->second);
+		self.m_pending.erase(found);
+	}
+	reply(response);
+}
+
+void Controller::FailPending()
+{
+	std::unordered_map<uint64_t, reply_t> pending;
+	{
+		std::unique_lock<std::mutex> ulock(m_pendingMtx);
+		pending.swap(m_pending);
+	}
+	for (auto& kv : pending) {
+		kv.second({});
+	}
+}
+
 void js_setServerPath(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
 	auto isol = args.GetIsolate();
@@ -17,8 +17,12 @@
 ******************************************************************************/
 
 #pragma once
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include "ipc-client.hpp"
 
 #ifdef _WIN32
@@ -71,8 +75,35 @@ class Controller
 
 	std::shared_ptr<ipc::client> GetConnection();
 
+	// Secondary connection reserved for blocking event polls, so that a
+	// waiting poll never delays calls made on the main connection.
+	std::shared_ptr<ipc::client> GetEventConnection();
+
+	typedef std::function<void(const std::vector<ipc::value>& response)> reply_t;
+
+	// Pipelined call: sends the request and returns its ID without waiting
+	//  for the reply, so any number of calls can be outstanding at once.
+	//  Replies are matched back by ID and `reply` runs on the IPC reader
+	//  thread. An empty response means the call was lost with its connection.
+	//
+	// The request goes over the main connection, which the server handles
+	//  strictly in order, so it stays ordered with every other call made
+	//  there, synchronous or not. Returns 0, without ever calling `reply`, if
+	//  the request could not be sent.
+	uint64_t call(const std::string& cname, const std::string& fname, std::vector<ipc::value> args, reply_t reply);
+
 	private:
+	static void OnReply(const void* data, const std::vector<ipc::value>& response);
+	void        FailPending();
+
 	bool                         m_isServer = false;
+	std::string                  m_uri;
 	std::shared_ptr<ipc::client> m_connection;
+	std::shared_ptr<ipc::client> m_eventConnection;
+	std::mutex                   m_eventConnectionMtx;
 	ProcessInfo                  procId;
+
+	std::unordered_map<uint64_t, reply_t> m_pending;
+	std::mutex                            m_pendingMtx;
+	std::atomic<uint64_t>                 m_nextRequestId;
 };
@@ -0,0 +1,125 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "event-bus.hpp"
+#include <chrono>
+#include "controller.hpp"
+#include "error.hpp"
+
+// Upper bound for a single blocking Events.Poll, this only limits how long
+//  stopping the reader may take.
+static const uint32_t poll_timeout_ms = 250;
+
+EventBus::EventBus() : m_meter_interval(0), m_types(0), m_worker_stop(true) {}
+
+EventBus::~EventBus()
+{
+	m_worker_stop = true;
+	if (m_worker.joinable()) {
+		m_worker.join();
+	}
+}
+
+void EventBus::subscribe(event_frame::type type, handler_t handler)
+{
+	std::unique_lock<std::mutex> ul(m_lock);
+	m_handlers[type] = handler;
+	m_types |= 1u << uint32_t(type);
+
+	if (!m_worker_stop)
+		return;
+
+	// Launch the reader thread.
+	m_worker_stop = false;
+	m_worker      = std::thread(std::bind(&EventBus::worker, this));
+}
+
+void EventBus::unsubscribe(event_frame::type type)
+{
+	std::thread stopped_worker;
+
+	{
+		std::unique_lock<std::mutex> ul(m_lock);
+		m_handlers.erase(type);
+		m_types &= ~(1u << uint32_t(type));
+
+		if (!m_handlers.empty() || m_worker_stop)
+			return;
+
+		// Last handler is gone, stop the reader thread. Joining happens without
+		//  the lock since the reader takes it to dispatch.
+		m_worker_stop = true;
+		stopped_worker.swap(m_worker);
+	}
+
+	if (stopped_worker.joinable()) {
+		stopped_worker.join();
+	}
+}
+
+void EventBus::set_meter_interval(uint32_t interval_ms)
+{
+	m_meter_interval = interval_ms;
+}
+
+void EventBus::dispatch(std::vector<char> const& events)
+{
+	std::unique_lock<std::mutex> ul(m_lock);
+
+	size_t              offset = 0;
+	event_frame::type   type;
+	event_frame::reader payload;
+	while (event_frame::read_frame(events, offset, type, payload)) {
+		// Only polled for subscribed types, so this is a handler that went
+		//  away while the poll was in flight.
+		auto handler = m_handlers.find(type);
+		if (handler == m_handlers.end()) {
+			continue;
+		}
+		handler->second(payload);
+	}
+}
+
+void EventBus::worker()
+{
+	while (!m_worker_stop) {
+		// Validate Connection
+		auto conn = Controller::GetInstance().GetEventConnection();
+		if (!conn) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(poll_timeout_ms));
+			continue;
+		}
+
+		// Call, the server holds the reply until an event is pending.
+		try {
+			std::vector<ipc::value> response = conn->call_synchronous_helper(
+			    "Events",
+			    "Poll",
+			    {ipc::value(poll_timeout_ms), ipc::value(m_meter_interval.load()), ipc::value(m_types.load())});
+			if ((response.size() < 2) || (response[0].type == ipc::type::Null)
+			    || ((ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok)) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(poll_timeout_ms));
+				continue;
+			}
+
+			dispatch(response[1].value_bin);
+		} catch (std::exception e) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(poll_timeout_ms));
+		}
+	}
+}
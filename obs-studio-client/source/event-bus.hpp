@@ -0,0 +1,70 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "event-frame.hpp"
+
+// Client end of the server's event channel (Events.Poll).
+//
+// A single reader thread polls the event connection and hands every event to
+//  the handler subscribed for its type. Only subscribed types are polled, the
+//  server keeps the others queued until a handler shows up. Handlers run on the reader thread and
+//  are expected to forward into their own utilv8::managed_callback.
+class EventBus
+{
+	public:
+	typedef std::function<void(event_frame::reader&)> handler_t;
+
+	static EventBus& GetInstance()
+	{
+		static EventBus _inst;
+		return _inst;
+	}
+
+	private:
+	EventBus();
+	~EventBus();
+
+	public: // C++11
+	EventBus(EventBus const&) = delete;
+	void operator=(EventBus const&) = delete;
+
+	public:
+	// The reader runs while at least one handler is subscribed.
+	void subscribe(event_frame::type type, handler_t handler);
+	void unsubscribe(event_frame::type type);
+
+	// How often the server may flush volmeter frames, 0 if no meter listens.
+	void set_meter_interval(uint32_t interval_ms);
+
+	private:
+	void worker();
+	void dispatch(std::vector<char> const& events);
+
+	std::mutex                             m_lock;
+	std::map<event_frame::type, handler_t> m_handlers;
+	std::atomic<uint32_t>                  m_meter_interval;
+	std::atomic<uint32_t>                  m_types;
+	std::thread                            m_worker;
+	std::atomic<bool>                      m_worker_stop;
+};
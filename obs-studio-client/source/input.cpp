@@ -20,6 +20,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <string>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "filter.hpp"
@@ -44,9 +45,12 @@ void osn::Input::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
 	// Function Template
 	utilv8::SetTemplateField(fnctemplate, "types", Types);
 	utilv8::SetTemplateField(fnctemplate, "create", Create);
+	utilv8::SetTemplateField(fnctemplate, "createAsync", CreateAsync);
 	utilv8::SetTemplateField(fnctemplate, "createPrivate", CreatePrivate);
 	utilv8::SetTemplateField(fnctemplate, "fromName", FromName);
 	utilv8::SetTemplateField(fnctemplate, "getPublicSources", GetPublicSources);
+	utilv8::SetTemplateField(fnctemplate, "getTypeProperties", GetTypeProperties);
+	utilv8::SetTemplateField(fnctemplate, "getTypeDefaults", GetTypeDefaults);
 
 	// Prototype Template
 
@@ -100,12 +104,54 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Types(Nan::NAN_METHOD_ARGS_TYPE info)
 	info.GetReturnValue().Set(utilv8::ToValue<std::string>(types));
 }
 
+Nan::NAN_METHOD_RETURN_TYPE osn::Input::GetTypeProperties(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	std::string type;
+
+	ASSERT_INFO_LENGTH(info, 1);
+	ASSERT_GET_VALUE(info[0], type);
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(type)});
+
+	if (!ValidateResponse(response))
+		return;
+
+	// There is no source behind type properties, modified() is a no-op on them.
+	info.GetReturnValue().Set(osn::ISource::ArenaToProperties(response[1].value_bin, info.This()));
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::Input::GetTypeDefaults(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	std::string type;
+
+	ASSERT_INFO_LENGTH(info, 1);
+	ASSERT_GET_VALUE(info[0], type);
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetDefaults", {ipc::value(type)});
+
+	if (!ValidateResponse(response))
+		return;
+
+	v8::Local<v8::String> jsondata = Nan::New<v8::String>(response[1].value_str).ToLocalChecked();
+	v8::Local<v8::Value>  json     = v8::JSON::Parse(info.GetIsolate()->GetCurrentContext(), jsondata).ToLocalChecked();
+	info.GetReturnValue().Set(json);
+}
+
 Nan::NAN_METHOD_RETURN_TYPE osn::Input::Create(Nan::NAN_METHOD_ARGS_TYPE info)
 {
 	std::string           type;
 	std::string           name;
-	v8::Local<v8::String> settings = Nan::New<v8::String>("").ToLocalChecked();
-	v8::Local<v8::String> hotkeys  = Nan::New<v8::String>("").ToLocalChecked();
+	std::vector<char>     settings;
+	v8::Local<v8::String> hotkeys = Nan::New<v8::String>("").ToLocalChecked();
 
 	// Parameters: <string> Type, <string> Name[,<object> settings]
 	ASSERT_INFO_LENGTH_AT_LEAST(info, 2);
@@ -127,7 +173,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Create(Nan::NAN_METHOD_ARGS_TYPE info)
 		if (!info[2]->IsUndefined()) {
 			v8::Local<v8::Object> setobj;
 			ASSERT_GET_VALUE(info[2], setobj);
-			settings = v8::JSON::Stringify(info.GetIsolate()->GetCurrentContext(), setobj).ToLocalChecked();
+			if (!utilv8::EncodeSettings(setobj, settings))
+				return;
 		}
 	}
 
@@ -135,12 +182,10 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Create(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
+	// Empty settings decode to none, they only keep the hotkeys in place.
 	auto params = std::vector<ipc::value>{ipc::value(type), ipc::value(name)};
-	if (settings->Length() != 0) {
-		std::string value;
-		if (utilv8::FromValue(settings, value)) {
-			params.push_back(ipc::value(value));
-		}
+	if (!settings.empty() || hotkeys->Length() != 0) {
+		params.push_back(ipc::value(settings));
 	}
 	if (hotkeys->Length() != 0) {
 		std::string value;
@@ -159,11 +204,57 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Create(Nan::NAN_METHOD_ARGS_TYPE info)
 	info.GetReturnValue().Set(osn::Input::Store(obj));
 }
 
-Nan::NAN_METHOD_RETURN_TYPE osn::Input::CreatePrivate(Nan::NAN_METHOD_ARGS_TYPE info)
+Nan::NAN_METHOD_RETURN_TYPE osn::Input::CreateAsync(Nan::NAN_METHOD_ARGS_TYPE info)
 {
 	std::string           type;
 	std::string           name;
-	v8::Local<v8::String> settings = Nan::New<v8::String>("").ToLocalChecked();
+	std::vector<char>     settings;
+	v8::Local<v8::String> hotkeys = Nan::New<v8::String>("").ToLocalChecked();
+
+	// Parameters: <string> Type, <string> Name[,<object> settings[,<object> hotkeys]]
+	ASSERT_INFO_LENGTH_AT_LEAST(info, 2);
+
+	ASSERT_GET_VALUE(info[0], type);
+	ASSERT_GET_VALUE(info[1], name);
+
+	if (info.Length() >= 4) {
+		ASSERT_INFO_LENGTH(info, 4);
+		if (!info[3]->IsUndefined()) {
+			v8::Local<v8::Object> hksobj;
+			ASSERT_GET_VALUE(info[3], hksobj);
+			hotkeys = v8::JSON::Stringify(info.GetIsolate()->GetCurrentContext(), hksobj).ToLocalChecked();
+		}
+	}
+	if (info.Length() >= 3) {
+		if (!info[2]->IsUndefined()) {
+			v8::Local<v8::Object> setobj;
+			ASSERT_GET_VALUE(info[2], setobj);
+			if (!utilv8::EncodeSettings(setobj, settings))
+				return;
+		}
+	}
+
+	auto        params = std::vector<ipc::value>{ipc::value(type), ipc::value(name)};
+	std::string value;
+	if (!settings.empty() || hotkeys->Length() != 0) {
+		params.push_back(ipc::value(settings));
+	}
+	if (hotkeys->Length() != 0 && utilv8::FromValue(hotkeys, value)) {
+		params.push_back(ipc::value(value));
+	}
+
+	info.GetReturnValue().Set(
+	    async::call("Input", "Create", std::move(params), [](std::vector<ipc::value>& response, v8::Local<v8::Object>) {
+		    osn::Input* obj = new osn::Input(response[1].value_union.ui64);
+		    return v8::Local<v8::Value>(osn::Input::Store(obj));
+	    }));
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::Input::CreatePrivate(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	std::string       type;
+	std::string       name;
+	std::vector<char> settings;
 
 	// Parameters: <string> Type, <string> Name[,<object> settings]
 	ASSERT_INFO_LENGTH_AT_LEAST(info, 2);
@@ -178,7 +269,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::CreatePrivate(Nan::NAN_METHOD_ARGS_TYPE
 		v8::Local<v8::Object> setobj;
 		ASSERT_GET_VALUE(info[2], setobj);
 
-		settings = v8::JSON::Stringify(info.GetIsolate()->GetCurrentContext(), setobj).ToLocalChecked();
+		if (!utilv8::EncodeSettings(setobj, settings))
+			return;
 	}
 
 	auto conn = GetConnection();
@@ -186,11 +278,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::CreatePrivate(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	auto params = std::vector<ipc::value>{ipc::value(type), ipc::value(name)};
-	if (settings->Length() != 0) {
-		std::string value;
-		if (utilv8::FromValue(settings, value)) {
-			params.push_back(ipc::value(value));
-		}
+	if (!settings.empty()) {
+		params.push_back(ipc::value(settings));
 	}
 
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "CreatePrivate", {std::move(params)});
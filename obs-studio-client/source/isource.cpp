@@ -19,6 +19,8 @@
 #include "isource.hpp"
 #include <error.hpp>
 #include <functional>
+#include <unordered_map>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "obs-property.hpp"
 #include "properties.hpp"
@@ -29,6 +31,23 @@
 Nan::Persistent<v8::FunctionTemplate> osn::ISource::prototype = Nan::Persistent<v8::FunctionTemplate>();
 osn::ISource*                         sourceObject;
 
+// Properties of every source as last received, the base the server diffs
+//  against. Only touched from the JavaScript thread.
+struct PropertiesCache
+{
+	struct entry
+	{
+		std::string                    name;
+		std::shared_ptr<osn::Property> property; // Null for types not exposed to JavaScript.
+	};
+
+	uint64_t           version = 0;
+	std::vector<entry> props;
+};
+
+static std::unordered_map<uint64_t, PropertiesCache> properties_caches;
+static ipc::client*                                  properties_caches_conn = nullptr;
+
 osn::ISource::~ISource()
 {
 }
@@ -47,6 +66,10 @@ void osn::ISource::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
 	utilv8::SetTemplateAccessorProperty(objtemplate, "properties", GetProperties);
 	utilv8::SetTemplateAccessorProperty(objtemplate, "settings", GetSettings);
 	utilv8::SetTemplateField(objtemplate, "update", Update);
+	utilv8::SetTemplateField(objtemplate, "getPropertiesAsync", GetPropertiesAsync);
+	utilv8::SetTemplateField(objtemplate, "getSettingsAsync", GetSettingsAsync);
+	utilv8::SetTemplateField(objtemplate, "updateAsync", UpdateAsync);
+	utilv8::SetTemplateField(objtemplate, "patchSettings", PatchSettings);
 	utilv8::SetTemplateField(objtemplate, "load", Load);
 	utilv8::SetTemplateField(objtemplate, "save", Save);
 
@@ -75,6 +98,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::Release(Nan::NAN_METHOD_ARGS_TYPE info
 		return;
 
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "Release", {ipc::value(obj->sourceId)});
+	properties_caches.erase(obj->sourceId);
 
 	if (!ValidateResponse(response))
 		return;
@@ -92,6 +116,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::Remove(Nan::NAN_METHOD_ARGS_TYPE info)
 		return;
 
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "Remove", {ipc::value(is->sourceId)});
+	properties_caches.erase(is->sourceId);
 
 	if (!ValidateResponse(response))
 		return;
@@ -121,205 +146,391 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::IsConfigurable(Nan::NAN_METHOD_ARGS_TY
 	return;
 }
 
-Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetProperties(Nan::NAN_METHOD_ARGS_TYPE info)
+// Converts one record of a property arena from a Source.GetProperties or
+//  Source.GetPropertiesDiff reply. Values are read straight out of the reply,
+//  strings are only copied once into the property that keeps them.
+static std::shared_ptr<osn::Property> ToProperty(obs::PropertyReader& record, obs::string_ref& name)
 {
-	osn::ISource* hndl = nullptr;
-	if (!utilv8::SafeUnwrap<osn::ISource>(info, hndl)) {
-		return;
+	uint8_t         type = 0, enabled = 0, visible = 0, field_type = 0;
+	obs::string_ref description, long_description, value;
+
+	record.read(type);
+	record.read(name);
+	record.read(description);
+	record.read(long_description);
+	record.read(enabled);
+	if (!record.read(visible)) {
+		return nullptr;
 	}
 
-	auto conn = GetConnection();
-	if (!conn)
-		return;
-
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(hndl->sourceId)});
-
-	if (!ValidateResponse(response))
-		return;
-
-	if (response.size() == 1) {
-		info.GetReturnValue().Set(Nan::Null());
-		return;
+	std::shared_ptr<osn::Property> pr;
+
+	switch (obs::Property::Type(type)) {
+	case obs::Property::Type::Boolean: {
+		std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
+		uint8_t                              v   = 0;
+		if (!record.read(v))
+			return nullptr;
+		pr2->bool_value.value = !!v;
+		pr                    = pr2;
+		break;
 	}
-
-	// Parse the massive structure of properties we were just sent.
-	osn::property_map_t pmap;
-	for (size_t idx = 1; idx < response.size(); ++idx) {
-		// !FIXME! Use the already existing obs::Property object instead of copying data.
-		auto raw_property = obs::Property::deserialize(response[idx].value_bin);
-
-		std::shared_ptr<osn::Property> pr;
-
-		switch (raw_property->type()) {
-		case obs::Property::Type::Boolean: {
-			std::shared_ptr<obs::BooleanProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::BooleanProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->bool_value.value                    = cast_property->value;
-			pr                                       = std::static_pointer_cast<osn::Property>(pr2);
-		    break;
-		}
-		case obs::Property::Type::Integer: {
-			std::shared_ptr<obs::IntegerProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::IntegerProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type                          = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->int_value.min                       = cast_property->minimum;
-			pr2->int_value.max                       = cast_property->maximum;
-			pr2->int_value.step                      = cast_property->step;
-			pr2->int_value.value                     = cast_property->value;
-			pr                                       = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Color: {
-			std::shared_ptr<obs::ColorProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::ColorProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type                          = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->int_value.value                     = cast_property->value;
-			pr                                       = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Float: {
-			std::shared_ptr<obs::FloatProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::FloatProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type                          = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->float_value.min                     = cast_property->minimum;
-			pr2->float_value.max                     = cast_property->maximum;
-			pr2->float_value.step                    = cast_property->step;
-			pr2->float_value.value                   = cast_property->value;
-			pr                                       = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Text: {
-			std::shared_ptr<obs::TextProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::TextProperty>(raw_property);
-			std::shared_ptr<osn::TextProperty> pr2 = std::make_shared<osn::TextProperty>();
-			pr2->field_type                        = osn::TextProperty::Type(cast_property->field_type);
-			pr2->value                             = cast_property->value;
-			pr                                     = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Path: {
-			std::shared_ptr<obs::PathProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::PathProperty>(raw_property);
-			std::shared_ptr<osn::PathProperty> pr2 = std::make_shared<osn::PathProperty>();
-			pr2->field_type                        = osn::PathProperty::Type(cast_property->field_type);
-			pr2->filter                            = cast_property->filter;
-			pr2->default_path                      = cast_property->default_path;
-			pr2->value                             = cast_property->value;
-			pr                                     = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::List: {
-			std::shared_ptr<obs::ListProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::ListProperty>(raw_property);
-			std::shared_ptr<osn::ListProperty> pr2 = std::make_shared<osn::ListProperty>();
-			pr2->field_type                        = osn::ListProperty::Type(cast_property->field_type);
-			pr2->item_format                       = osn::ListProperty::Format(cast_property->format);
-
-			switch (cast_property->format) {
+	case obs::Property::Type::Integer: {
+		std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
+		record.read(field_type);
+		record.read(pr2->int_value.min);
+		record.read(pr2->int_value.max);
+		record.read(pr2->int_value.step);
+		if (!record.read(pr2->int_value.value))
+			return nullptr;
+		pr2->field_type = osn::NumberProperty::Type(field_type);
+		pr              = pr2;
+		break;
+	}
+	case obs::Property::Type::Color: {
+		std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
+		record.read(field_type);
+		if (!record.read(pr2->int_value.value))
+			return nullptr;
+		pr2->field_type = osn::NumberProperty::Type(field_type);
+		pr              = pr2;
+		break;
+	}
+	case obs::Property::Type::Float: {
+		std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
+		record.read(field_type);
+		record.read(pr2->float_value.min);
+		record.read(pr2->float_value.max);
+		record.read(pr2->float_value.step);
+		if (!record.read(pr2->float_value.value))
+			return nullptr;
+		pr2->field_type = osn::NumberProperty::Type(field_type);
+		pr              = pr2;
+		break;
+	}
+	case obs::Property::Type::Text: {
+		std::shared_ptr<osn::TextProperty> pr2 = std::make_shared<osn::TextProperty>();
+		record.read(field_type);
+		if (!record.read(value))
+			return nullptr;
+		pr2->field_type = osn::TextProperty::Type(field_type);
+		value.assign_to(pr2->value);
+		pr = pr2;
+		break;
+	}
+	case obs::Property::Type::Path: {
+		std::shared_ptr<osn::PathProperty> pr2 = std::make_shared<osn::PathProperty>();
+		obs::string_ref                    filter, default_path;
+		record.read(field_type);
+		record.read(filter);
+		record.read(default_path);
+		if (!record.read(value))
+			return nullptr;
+		pr2->field_type = osn::PathProperty::Type(field_type);
+		filter.assign_to(pr2->filter);
+		default_path.assign_to(pr2->default_path);
+		value.assign_to(pr2->value);
+		pr = pr2;
+		break;
+	}
+	case obs::Property::Type::List: {
+		std::shared_ptr<osn::ListProperty> pr2    = std::make_shared<osn::ListProperty>();
+		uint8_t                            format = 0;
+		uint32_t                           count  = 0;
+		record.read(field_type);
+		record.read(format);
+		if (!record.read(count))
+			return nullptr;
+		pr2->field_type  = osn::ListProperty::Type(field_type);
+		pr2->item_format = osn::ListProperty::Format(format);
+
+		for (uint32_t idx = 0; idx < count; idx++) {
+			osn::ListProperty::Item item;
+			obs::string_ref         item_name;
+			uint8_t                 item_enabled = 0;
+			record.read(item_name);
+			record.read(item_enabled);
+			item_name.assign_to(item.name);
+			item.disabled = !item_enabled;
+			switch (obs::ListProperty::Format(format)) {
 			case obs::ListProperty::Format::Integer:
-				pr2->current_value_int = cast_property->current_value_int;
+				record.read(item.value_int);
 				break;
 			case obs::ListProperty::Format::Float:
-				pr2->current_value_float = cast_property->current_value_float;
+				record.read(item.value_float);
 				break;
 			case obs::ListProperty::Format::String:
-				pr2->current_value_str = cast_property->current_value_str;
+				record.read(value);
+				value.assign_to(item.value_str);
 				break;
 			}
+			pr2->items.push_back(std::move(item));
+		}
 
-			for (auto& item : cast_property->items) {
-				osn::ListProperty::Item item2;
-				item2.name     = item.name;
-				item2.disabled = !item.enabled;
-				switch (cast_property->format) {
-				case obs::ListProperty::Format::Integer:
-					item2.value_int = item.value_int;
-					break;
-				case obs::ListProperty::Format::Float:
-					item2.value_float = item.value_float;
-					break;
-				case obs::ListProperty::Format::String:
-					item2.value_str = item.value_string;
-					break;
-				}
-				pr2->items.push_back(std::move(item2));
-			}
-			pr = std::static_pointer_cast<osn::Property>(pr2);
+		bool ok = true;
+		switch (obs::ListProperty::Format(format)) {
+		case obs::ListProperty::Format::Integer:
+			ok = record.read(pr2->current_value_int);
 			break;
-		}
-		case obs::Property::Type::Font: {
-			std::shared_ptr<obs::FontProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::FontProperty>(raw_property);
-			std::shared_ptr<osn::FontProperty> pr2 = std::make_shared<osn::FontProperty>();
-			pr2->face                              = cast_property->face;
-			pr2->style                             = cast_property->style;
-			pr2->path                              = cast_property->path;
-			pr2->sizeF                             = cast_property->sizeF;
-			pr2->flags                             = cast_property->flags;
-            pr = std::static_pointer_cast<osn::Property>(pr2);
+		case obs::ListProperty::Format::Float:
+			ok = record.read(pr2->current_value_float);
 			break;
-		}
-		case obs::Property::Type::EditableList: {
-			std::shared_ptr<obs::EditableListProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::EditableListProperty>(raw_property);
-			std::shared_ptr<osn::EditableListProperty> pr2 = std::make_shared<osn::EditableListProperty>();
-			pr2->field_type                                = osn::EditableListProperty::Type(cast_property->field_type);
-			pr2->filter                                    = cast_property->filter;
-			pr2->default_path                              = cast_property->default_path;
-			pr2->value                                     = cast_property->value;
-			pr                                             = std::static_pointer_cast<osn::Property>(pr2);
+		case obs::ListProperty::Format::String:
+			ok = record.read(value);
+			value.assign_to(pr2->current_value_str);
 			break;
 		}
-		case obs::Property::Type::FrameRate: {
-			std::shared_ptr<obs::FrameRateProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::FrameRateProperty>(raw_property);
-			std::shared_ptr<osn::FrameRateProperty> pr2 = std::make_shared<osn::FrameRateProperty>();
-			for (auto& option : cast_property->ranges) {
-				std::pair<osn::FrameRateProperty::FrameRate, osn::FrameRateProperty::FrameRate> range2;
-				range2.first.numerator    = option.minimum.first;
-				range2.first.denominator  = option.minimum.second;
-				range2.second.numerator   = option.maximum.first;
-				range2.second.denominator = option.maximum.second;
-				pr2->ranges.push_back(std::move(range2));
-			}
-			for (auto& option : cast_property->options) {
-				osn::FrameRateProperty::Option option2;
-				option2.name        = option.name;
-				option2.description = option.description;
-				pr2->options.push_back(std::move(option2));
-			}
+		if (!ok)
+			return nullptr;
+		pr = pr2;
+		break;
+	}
+	case obs::Property::Type::Font: {
+		std::shared_ptr<osn::FontProperty> pr2 = std::make_shared<osn::FontProperty>();
+		obs::string_ref                    face, style, path;
+		record.read(face);
+		record.read(style);
+		record.read(path);
+		record.read(pr2->sizeF);
+		if (!record.read(pr2->flags))
+			return nullptr;
+		face.assign_to(pr2->face);
+		style.assign_to(pr2->style);
+		path.assign_to(pr2->path);
+		pr = pr2;
+		break;
+	}
+	case obs::Property::Type::EditableList: {
+		std::shared_ptr<osn::EditableListProperty> pr2 = std::make_shared<osn::EditableListProperty>();
+		obs::string_ref                            filter, default_path;
+		record.read(field_type);
+		record.read(filter);
+		record.read(default_path);
+		if (!record.read(value))
+			return nullptr;
+		pr2->field_type = osn::EditableListProperty::Type(field_type);
+		filter.assign_to(pr2->filter);
+		default_path.assign_to(pr2->default_path);
+		value.assign_to(pr2->value);
+		pr = pr2;
+		break;
+	}
+	case obs::Property::Type::FrameRate: {
+		// Not exposed to JavaScript yet.
+		return nullptr;
+	}
+	default: {
+		pr = std::make_shared<osn::Property>();
+		break;
+	}
+	}
 
-			break;
+	name.assign_to(pr->name);
+	description.assign_to(pr->description);
+	long_description.assign_to(pr->long_description);
+	pr->type    = osn::Property::Type(type);
+	pr->enabled = !!enabled;
+	pr->visible = !!visible;
+	return pr;
+}
+
+static PropertiesCache& GetPropertiesCache(uint64_t sourceId)
+{
+	// Versions mean nothing to a different server.
+	ipc::client* conn = Controller::GetInstance().GetConnection().get();
+	if (conn != properties_caches_conn) {
+		properties_caches.clear();
+		properties_caches_conn = conn;
+	}
+	return properties_caches[sourceId];
+}
+
+// Applies a validated Source.GetPropertiesDiff reply to the cache. Fails if
+//  the reply is based on another version than the cached one.
+static bool ApplyPropertiesDiff(uint64_t sourceId, uint64_t known, std::vector<ipc::value>& response)
+{
+	PropertiesCache& cache   = GetPropertiesCache(sourceId);
+	uint64_t         version = response[1].value_union.ui64;
+	size_t           idx     = 3;
+
+	switch (obs::PropertiesDiff(response[2].value_union.ui32)) {
+	case obs::PropertiesDiff::Unchanged:
+		return cache.version == known;
+	case obs::PropertiesDiff::Delta: {
+		if (cache.version != known)
+			return false;
+
+		uint32_t removed = response[idx++].value_union.ui32;
+		for (uint32_t n = 0; n < removed; n++) {
+			std::string& name = response[idx++].value_str;
+			for (auto iter = cache.props.begin(); iter != cache.props.end(); ++iter) {
+				if (iter->name == name) {
+					cache.props.erase(iter);
+					break;
+				}
+			}
 		}
-		default: {
-			pr = std::make_shared<osn::Property>();
-			break;
+
+		// Indices are ascending, every earlier slot is final when a property is placed.
+		std::vector<char> const& indices = response[idx++].value_bin;
+		obs::PropertyReader      arena(response[idx++].value_bin);
+		uint32_t                 upserts = 0;
+		if (!arena.read(upserts) || indices.size() != upserts * sizeof(uint32_t))
+			return false;
+		for (uint32_t n = 0; n < upserts; n++) {
+			PropertiesCache::entry entry;
+			obs::PropertyReader    record;
+			obs::string_ref        name;
+			uint32_t               at = 0;
+			std::memcpy(&at, &indices[n * sizeof(uint32_t)], sizeof(uint32_t));
+			if (!arena.read(record))
+				return false;
+			entry.property = ToProperty(record, name);
+			name.assign_to(entry.name);
+			if (at < cache.props.size() && cache.props[at].name == entry.name) {
+				cache.props[at] = std::move(entry);
+			} else if (at <= cache.props.size()) {
+				cache.props.insert(cache.props.begin() + at, std::move(entry));
+			} else {
+				return false;
+			}
 		}
+		break;
+	}
+	case obs::PropertiesDiff::Full: {
+		obs::PropertyReader arena(response[idx].value_bin);
+		uint32_t            count = 0;
+		arena.read(count);
+		cache.props.clear();
+		cache.props.reserve(count);
+		for (uint32_t n = 0; n < count; n++) {
+			PropertiesCache::entry entry;
+			obs::PropertyReader    record;
+			obs::string_ref        name;
+			if (!arena.read(record))
+				return false;
+			entry.property = ToProperty(record, name);
+			name.assign_to(entry.name);
+			cache.props.push_back(std::move(entry));
 		}
+		break;
+	}
+	default:
+		return false;
+	}
 
-		if (pr) {
-			pr->name             = raw_property->name;
-			pr->description      = raw_property->description;
-			pr->long_description = raw_property->long_description;
-			pr->type             = osn::Property::Type(raw_property->type());
-			pr->enabled          = raw_property->enabled;
-			pr->visible          = raw_property->visible;
+	cache.version = version;
+	return true;
+}
 
-			pmap.emplace(idx - 1, pr);
-		}
+// Properties are never modified once received, so unchanged ones are shared
+//  by every Properties object handed out.
+static v8::Local<v8::Value> ToProperties(uint64_t sourceId, v8::Local<v8::Object> owner)
+{
+	PropertiesCache& cache = GetPropertiesCache(sourceId);
+	if (cache.props.empty()) {
+		return Nan::Null();
+	}
+
+	osn::property_map_t pmap;
+	for (size_t idx = 0; idx < cache.props.size(); idx++) {
+		if (cache.props[idx].property)
+			pmap.emplace(idx, cache.props[idx].property);
+	}
+
+	osn::Properties* props = new osn::Properties(std::move(pmap), owner);
+	return osn::Properties::Store(props);
+}
+
+v8::Local<v8::Value> osn::ISource::ArenaToProperties(std::vector<char> const& buf, v8::Local<v8::Object> owner)
+{
+	obs::PropertyReader arena(buf);
+	uint32_t            count = 0;
+	arena.read(count);
+
+	osn::property_map_t pmap;
+	for (uint32_t idx = 0; idx < count; idx++) {
+		obs::PropertyReader record;
+		obs::string_ref     name;
+		if (!arena.read(record))
+			break;
+		std::shared_ptr<osn::Property> property = ToProperty(record, name);
+		if (property)
+			pmap.emplace(idx, property);
 	}
+	if (pmap.empty()) {
+		return Nan::Null();
+	}
+
+	osn::Properties* props = new osn::Properties(std::move(pmap), owner);
+	return osn::Properties::Store(props);
+}
+
+// Brings the cached properties of a source up to date, falling back to a full
+//  fetch if the cache moved on while a reply was in flight.
+static bool FetchProperties(uint64_t sourceId, uint64_t known, std::vector<ipc::value>& response)
+{
+	if (ApplyPropertiesDiff(sourceId, known, response))
+		return true;
 
-	// obj = std::move(pmap);
-	osn::Properties* props = new osn::Properties(std::move(pmap), info.This());
-	info.GetReturnValue().Set(osn::Properties::Store(props));
+	auto conn = GetConnection();
+	if (!conn)
+		return false;
+
+	response = conn->call_synchronous_helper(
+	    "Source", "GetPropertiesDiff", {ipc::value(sourceId), ipc::value(uint64_t(0))});
+	if (!ValidateResponse(response))
+		return false;
+
+	return ApplyPropertiesDiff(sourceId, 0, response);
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetProperties(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	osn::ISource* hndl = nullptr;
+	if (!utilv8::SafeUnwrap<osn::ISource>(info, hndl)) {
+		return;
+	}
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	uint64_t                known    = GetPropertiesCache(hndl->sourceId).version;
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Source", "GetPropertiesDiff", {ipc::value(hndl->sourceId), ipc::value(known)});
+
+	if (!ValidateResponse(response))
+		return;
+
+	if (!FetchProperties(hndl->sourceId, known, response))
+		return;
+
+	info.GetReturnValue().Set(ToProperties(hndl->sourceId, info.This()));
 	return;
 }
 
+Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetPropertiesAsync(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	osn::ISource* hndl = nullptr;
+	if (!utilv8::SafeUnwrap<osn::ISource>(info, hndl)) {
+		return;
+	}
+
+	uint64_t sourceId = hndl->sourceId;
+	uint64_t known    = GetPropertiesCache(sourceId).version;
+	info.GetReturnValue().Set(async::call(
+	    "Source",
+	    "GetPropertiesDiff",
+	    {ipc::value(sourceId), ipc::value(known)},
+	    [sourceId, known](std::vector<ipc::value>& response, v8::Local<v8::Object> self) {
+		    if (!FetchProperties(sourceId, known, response))
+			    return v8::Local<v8::Value>(Nan::Null());
+		    return ToProperties(sourceId, self);
+	    },
+	    info.This()));
+}
+
 Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetSettings(Nan::NAN_METHOD_ARGS_TYPE info)
 {
 	osn::ISource* hndl = nullptr;
@@ -337,9 +548,11 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetSettings(Nan::NAN_METHOD_ARGS_TYPE
 	if (!ValidateResponse(response))
 		return;
 
-	v8::Local<v8::String> jsondata = Nan::New<v8::String>(response[1].value_str).ToLocalChecked();
-	v8::Local<v8::Value>  json     = v8::JSON::Parse(info.GetIsolate()->GetCurrentContext(), jsondata).ToLocalChecked();
-	info.GetReturnValue().Set(json);
+	v8::Local<v8::Value> settings = utilv8::DecodeSettings(response[1].value_bin);
+	if (settings.IsEmpty())
+		return;
+
+	info.GetReturnValue().Set(settings);
 	return;
 }
 
@@ -354,18 +567,16 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::Update(Nan::NAN_METHOD_ARGS_TYPE info)
 		return;
 	}
 
-	// Turn json into string
-	v8::Local<v8::String> jsondata = v8::JSON::Stringify(info.GetIsolate()->GetCurrentContext(), json).ToLocalChecked();
-	v8::String::Utf8Value jsondatautf8(jsondata);
+	std::vector<char> settings;
+	if (!utilv8::EncodeSettings(json, settings))
+		return;
 
 	auto conn = GetConnection();
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Source",
-	    "Update",
-	    {ipc::value(hndl->sourceId), ipc::value(std::string(*jsondatautf8, (size_t)jsondatautf8.length()))});
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Source", "Update", {ipc::value(hndl->sourceId), ipc::value(settings)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -374,6 +585,75 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::Update(Nan::NAN_METHOD_ARGS_TYPE info)
 	return;
 }
 
+Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetSettingsAsync(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	osn::ISource* hndl = nullptr;
+	if (!utilv8::SafeUnwrap<osn::ISource>(info, hndl)) {
+		return;
+	}
+
+	info.GetReturnValue().Set(async::call(
+	    "Source",
+	    "GetSettings",
+	    {ipc::value(hndl->sourceId)},
+	    [](std::vector<ipc::value>& response, v8::Local<v8::Object>) {
+		    return utilv8::DecodeSettings(response[1].value_bin);
+	    },
+	    info.This()));
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::ISource::UpdateAsync(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	v8::Local<v8::Object> json;
+	ASSERT_GET_VALUE(info[0], json);
+
+	// Retrieve Object
+	osn::ISource* hndl = nullptr;
+	if (!Retrieve(info.This(), hndl)) {
+		return;
+	}
+
+	std::vector<char> settings;
+	if (!utilv8::EncodeSettings(json, settings))
+		return;
+
+	info.GetReturnValue().Set(async::call(
+	    "Source",
+	    "Update",
+	    {ipc::value(hndl->sourceId), ipc::value(settings)},
+	    [](std::vector<ipc::value>&, v8::Local<v8::Object>) { return v8::Local<v8::Value>(Nan::True()); },
+	    info.This()));
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::ISource::PatchSettings(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	ASSERT_INFO_LENGTH(info, 1);
+	if (!info[0]->IsArray()) {
+		Nan::ThrowTypeError("Expected an array of patch operations.");
+		return;
+	}
+	v8::Local<v8::Array> ops = info[0].As<v8::Array>();
+
+	// Retrieve Object
+	osn::ISource* hndl = nullptr;
+	if (!Retrieve(info.This(), hndl)) {
+		return;
+	}
+
+	std::vector<char> patch;
+	if (!utilv8::EncodeSettingsPatch(ops, patch))
+		return;
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Source", "Patch", {ipc::value(hndl->sourceId), ipc::value(patch)});
+
+	ValidateResponse(response);
+}
+
 Nan::NAN_METHOD_RETURN_TYPE osn::ISource::Load(Nan::NAN_METHOD_ARGS_TYPE info)
 {
 	osn::ISource* is;
@@ -16,9 +16,11 @@
 
 ******************************************************************************/
 
+#include "call-stats.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "nodeobs_api.hpp"
+#include "settings-buffer.hpp"
 #include "utility-v8.hpp"
 
 #include <node.h>
@@ -196,6 +198,122 @@ Nan::NAN_METHOD_RETURN_TYPE api::OBS_API_ProcessHotkeyStatus(const v8::FunctionC
 		return;
 }
 
+Nan::NAN_METHOD_RETURN_TYPE api::OBS_API_getLogMessages(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	uint32_t type;
+	uint64_t after;
+	uint32_t maxCount;
+
+	ASSERT_GET_VALUE(args[0], type);
+	ASSERT_GET_VALUE(args[1], after);
+	ASSERT_GET_VALUE(args[2], maxCount);
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "API", "OBS_API_getLogMessages", {ipc::value(type), ipc::value(after), ipc::value(maxCount)});
+
+	if (!ValidateResponse(response))
+		return;
+
+	v8::Local<v8::Object> result   = v8::Object::New(args.GetIsolate());
+	v8::Local<v8::Array>  messages = v8::Array::New(args.GetIsolate());
+
+	// Each message is a sequence number, a log level and the text
+	for (size_t i = 0; i < (response.size() - 3) / 3; i++) {
+		size_t                responseIndex = i * 3 + 3;
+		v8::Local<v8::Object> object        = v8::Object::New(args.GetIsolate());
+
+		object->Set(
+		    v8::String::NewFromUtf8(args.GetIsolate(), "sequence"),
+		    v8::Number::New(args.GetIsolate(), double(response[responseIndex + 0].value_union.ui64)));
+		object->Set(
+		    v8::String::NewFromUtf8(args.GetIsolate(), "level"),
+		    v8::Number::New(args.GetIsolate(), response[responseIndex + 1].value_union.i32));
+		object->Set(
+		    v8::String::NewFromUtf8(args.GetIsolate(), "message"),
+		    v8::String::NewFromUtf8(args.GetIsolate(), response[responseIndex + 2].value_str.c_str()));
+
+		messages->Set(uint32_t(i), object);
+	}
+
+	result->Set(
+	    v8::String::NewFromUtf8(args.GetIsolate(), "last"),
+	    v8::Number::New(args.GetIsolate(), double(response[1].value_union.ui64)));
+	result->Set(
+	    v8::String::NewFromUtf8(args.GetIsolate(), "missed"),
+	    v8::Boolean::New(args.GetIsolate(), response[2].value_union.ui32 != 0));
+	result->Set(v8::String::NewFromUtf8(args.GetIsolate(), "messages"), messages);
+
+	args.GetReturnValue().Set(result);
+}
+
+Nan::NAN_METHOD_RETURN_TYPE api::GetCallStats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("System", "GetCallStats", {});
+
+	if (!ValidateResponse(response))
+		return;
+
+	const std::vector<char>& buffer = response[1].value_bin;
+	settings_buffer::reader  r(buffer.data(), buffer.size());
+	v8::Local<v8::Array>     functions = v8::Array::New(args.GetIsolate());
+
+	size_t count = 0;
+	r.read(count);
+	for (size_t i = 0; i < count; i++) {
+		std::string collection, name;
+		uint64_t    calls = 0, totalNs = 0, maxNs = 0;
+		uint32_t    used  = 0;
+		r.read(collection);
+		r.read(name);
+		r.read(calls);
+		r.read(totalNs);
+		r.read(maxNs);
+		if (!r.read(used))
+			break;
+
+		// Each bucket is the smallest duration it holds, in microseconds, and its call count
+		v8::Local<v8::Array> buckets = v8::Array::New(args.GetIsolate());
+		for (uint32_t j = 0; j < used; j++) {
+			uint16_t index       = 0;
+			uint32_t bucketCalls = 0;
+			r.read(index);
+			r.read(bucketCalls);
+
+			v8::Local<v8::Array> bucket = v8::Array::New(args.GetIsolate());
+			bucket->Set(0, v8::Number::New(args.GetIsolate(), double(call_stats::bucket_lower(index))));
+			bucket->Set(1, v8::Number::New(args.GetIsolate(), bucketCalls));
+			buckets->Set(j, bucket);
+		}
+
+		v8::Local<v8::Object> object = v8::Object::New(args.GetIsolate());
+		object->Set(
+		    v8::String::NewFromUtf8(args.GetIsolate(), "collection"),
+		    v8::String::NewFromUtf8(args.GetIsolate(), collection.c_str()));
+		object->Set(
+		    v8::String::NewFromUtf8(args.GetIsolate(), "name"),
+		    v8::String::NewFromUtf8(args.GetIsolate(), name.c_str()));
+		object->Set(
+		    v8::String::NewFromUtf8(args.GetIsolate(), "count"), v8::Number::New(args.GetIsolate(), double(calls)));
+		object->Set(
+		    v8::String::NewFromUtf8(args.GetIsolate(), "totalNs"), v8::Number::New(args.GetIsolate(), double(totalNs)));
+		object->Set(
+		    v8::String::NewFromUtf8(args.GetIsolate(), "maxNs"), v8::Number::New(args.GetIsolate(), double(maxNs)));
+		object->Set(v8::String::NewFromUtf8(args.GetIsolate(), "buckets"), buckets);
+
+		functions->Set(uint32_t(i), object);
+	}
+
+	args.GetReturnValue().Set(functions);
+}
+
 INITIALIZER(nodeobs_api)
 {
 	initializerFunctions.push([](v8::Local<v8::Object> exports) {
@@ -206,5 +324,7 @@ INITIALIZER(nodeobs_api)
 		NODE_SET_METHOD(exports, "StopCrashHandler", api::StopCrashHandler);
 		NODE_SET_METHOD(exports, "OBS_API_QueryHotkeys", api::OBS_API_QueryHotkeys);
 		NODE_SET_METHOD(exports, "OBS_API_ProcessHotkeyStatus", api::OBS_API_ProcessHotkeyStatus);
+		NODE_SET_METHOD(exports, "OBS_API_getLogMessages", api::OBS_API_getLogMessages);
+		NODE_SET_METHOD(exports, "GetCallStats", api::GetCallStats);
 	});
 }
@@ -17,11 +17,12 @@
 ******************************************************************************/
 
 #include "nodeobs_autoconfig.hpp"
+#include "event-bus.hpp"
 #include "shared.hpp"
 
 AutoConfig::~AutoConfig()
 {
-	stop_worker();
+	unsubscribe();
 	stop_async_runner();
 }
 
@@ -69,24 +70,31 @@ void AutoConfig::callback_handler(void* data, std::shared_ptr<AutoConfigInfo> it
 	Nan::Call(m_callback_function, 1, args);
 }
 
-void AutoConfig::start_worker()
+void AutoConfig::subscribe()
 {
-	if (!m_worker_stop)
+	if (m_subscribed)
 		return;
-	// Launch worker thread.
-	m_worker_stop = false;
-	m_worker      = std::thread(std::bind(&AutoConfig::worker, this));
-}
+	m_subscribed = true;
+
+	EventBus::GetInstance().subscribe(event_frame::type::autoconfig, [this](event_frame::reader& payload) {
+		std::shared_ptr<AutoConfigInfo> data = std::make_shared<AutoConfigInfo>();
+
+		payload.read(data->event);
+		payload.read(data->description);
+		if (!payload.read(data->percentage))
+			return;
+		data->param = this;
 
-void AutoConfig::stop_worker()
+		m_async_callback->queue(std::move(data));
+	});
+}
+void AutoConfig::unsubscribe()
 {
-	if (m_worker_stop != false)
+	if (!m_subscribed)
 		return;
-	// Stop worker thread.
-	m_worker_stop = true;
-	if (m_worker.joinable()) {
-		m_worker.join();
-	}
+	m_subscribed = false;
+
+	EventBus::GetInstance().unsubscribe(event_frame::type::autoconfig);
 }
 
 void AutoConfig::set_keepalive(v8::Local<v8::Object> obj)
@@ -96,48 +104,6 @@ void AutoConfig::set_keepalive(v8::Local<v8::Object> obj)
 	m_async_callback->set_keepalive(obj);
 }
 
-void AutoConfig::worker()
-{
-	size_t totalSleepMS = 0;
-
-	while (!m_worker_stop) {
-		auto tp_start = std::chrono::high_resolution_clock::now();
-
-		// Validate Connection
-		auto conn = Controller::GetInstance().GetConnection();
-		if (!conn) {
-			goto do_sleep;
-		}
-
-		// Call
-		{
-			std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "Query", {});
-			if (!response.size() || (response.size() == 1)) {
-				goto do_sleep;
-			}
-
-			ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-			if (error == ErrorCode::Ok) {
-				std::shared_ptr<AutoConfigInfo> data = std::make_shared<AutoConfigInfo>();
-
-				data->event       = response[1].value_str;
-				data->description = response[2].value_str;
-				data->percentage  = response[3].value_union.fp64;
-				data->param       = this;
-
-				m_async_callback->queue(std::move(data));
-			}
-		}
-
-	do_sleep:
-		auto tp_end  = std::chrono::high_resolution_clock::now();
-		auto dur     = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
-		totalSleepMS = sleepIntervalMS - dur.count();
-		std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
-	}
-	return;
-}
-
 static v8::Persistent<v8::Object> autoConfigCallbackObject;
 
 void autoConfig::InitializeAutoConfig(const v8::FunctionCallbackInfo<v8::Value>& args)
@@ -171,7 +137,7 @@ void autoConfig::InitializeAutoConfig(const v8::FunctionCallbackInfo<v8::Value>&
 	autoConfigObject->m_callback_function.Reset(callback);
 	autoConfigObject->start_async_runner();
 	autoConfigObject->set_keepalive(args.This());
-	autoConfigObject->start_worker();
+	autoConfigObject->subscribe();
 	args.GetReturnValue().Set(true);
 }
 
@@ -293,7 +259,7 @@ void autoConfig::TerminateAutoConfig(const v8::FunctionCallbackInfo<v8::Value>&
 		return;
 	}
 
-	autoConfigObject->stop_worker();
+	autoConfigObject->unsubscribe();
 	autoConfigObject->stop_async_runner();
 	delete autoConfigObject;
 }
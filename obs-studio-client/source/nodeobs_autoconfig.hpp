@@ -40,12 +40,10 @@ class AutoConfig : public Nan::ObjectWrap,
 	friend utilv8::ManagedObject<AutoConfig>;
 	friend utilv8::CallbackData<AutoConfigInfo, AutoConfig>;
 
-	uint32_t sleepIntervalMS = 33;
+	bool m_subscribed = false;
 
 	public:
-	std::thread m_worker;
-	bool        m_worker_stop = true;
-	std::mutex  m_worker_lock;
+	std::mutex m_worker_lock;
 
 	AutoConfigCallback* m_async_callback = nullptr;
 	Nan::Callback       m_callback_function;
@@ -56,9 +54,8 @@ class AutoConfig : public Nan::ObjectWrap,
 	void start_async_runner();
 	void stop_async_runner();
 	void callback_handler(void* data, std::shared_ptr<AutoConfigInfo> item);
-	void start_worker();
-	void stop_worker();
-	void worker();
+	void subscribe();
+	void unsubscribe();
 	void set_keepalive(v8::Local<v8::Object>);
 
 	std::list<AutoConfigCallback*> callbacks;
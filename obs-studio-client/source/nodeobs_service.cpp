@@ -17,8 +17,10 @@
 ******************************************************************************/
 
 #include "nodeobs_service.hpp"
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "error.hpp"
+#include "event-bus.hpp"
 #include "utility-v8.hpp"
 
 #include <node.h>
@@ -64,27 +66,34 @@ void Service::callback_handler(void* data, std::shared_ptr<SignalInfo> item)
 	argv->ToObject()->Set(v8::String::NewFromUtf8(isolate, "code"), v8::Number::New(isolate, item->code));
 	argv->ToObject()->Set(
 	    v8::String::NewFromUtf8(isolate, "error"), v8::String::NewFromUtf8(isolate, item->errorMessage.c_str()));
+	// Server monotonic clock in milliseconds, only meaningful relative to other signals.
+	argv->ToObject()->Set(
+	    v8::String::NewFromUtf8(isolate, "timestamp"), v8::Number::New(isolate, double(item->timestamp) / 1000000.0));
 	args[0] = argv;
 
 	Nan::Call(m_callback_function, 1, args);
 }
-void Service::start_worker()
+void Service::subscribe()
 {
-	if (!m_worker_stop)
-		return;
-	// Launch worker thread.
-	m_worker_stop = false;
-	m_worker      = std::thread(std::bind(&Service::worker, this));
+	EventBus::GetInstance().subscribe(event_frame::type::output_signal, [this](event_frame::reader& payload) {
+		std::shared_ptr<SignalInfo> data = std::make_shared<SignalInfo>();
+
+		int32_t code = 0;
+		payload.read(data->outputType);
+		payload.read(data->signal);
+		payload.read(code);
+		payload.read(data->errorMessage);
+		if (!payload.read(data->timestamp))
+			return;
+		data->code  = code;
+		data->param = this;
+
+		m_async_callback->queue(std::move(data));
+	});
 }
-void Service::stop_worker()
+void Service::unsubscribe()
 {
-	if (m_worker_stop != false)
-		return;
-	// Stop worker thread.
-	m_worker_stop = true;
-	if (m_worker.joinable()) {
-		m_worker.join();
-	}
+	EventBus::GetInstance().unsubscribe(event_frame::type::output_signal);
 }
 
 void service::OBS_service_resetAudioContext(const v8::FunctionCallbackInfo<v8::Value>& args)
@@ -183,6 +192,29 @@ void service::OBS_service_stopReplayBuffer(const v8::FunctionCallbackInfo<v8::Va
 	ValidateResponse(response);
 }
 
+void service::OBS_service_startStreamingAsync(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	args.GetReturnValue().Set(async::call("Service", "OBS_service_startStreaming", {}));
+}
+
+void service::OBS_service_startRecordingAsync(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	args.GetReturnValue().Set(async::call("Service", "OBS_service_startRecording", {}));
+}
+
+void service::OBS_service_stopStreamingAsync(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	bool forceStop;
+	ASSERT_GET_VALUE(args[0], forceStop);
+
+	args.GetReturnValue().Set(async::call("Service", "OBS_service_stopStreaming", {ipc::value(forceStop)}));
+}
+
+void service::OBS_service_stopRecordingAsync(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	args.GetReturnValue().Set(async::call("Service", "OBS_service_stopRecording", {}));
+}
+
 static v8::Persistent<v8::Object> serviceCallbackObject;
 
 void service::OBS_service_connectOutputSignals(const v8::FunctionCallbackInfo<v8::Value>& args)
@@ -208,7 +240,7 @@ void service::OBS_service_connectOutputSignals(const v8::FunctionCallbackInfo<v8
 	serviceObject->m_callback_function.Reset(callback);
 	serviceObject->start_async_runner();
 	serviceObject->set_keepalive(args.This());
-	serviceObject->start_worker();
+	serviceObject->subscribe();
 	args.GetReturnValue().Set(true);
 }
 
@@ -238,49 +270,6 @@ void service::OBS_service_getLastReplay(const v8::FunctionCallbackInfo<v8::Value
 	args.GetReturnValue().Set(v8::String::NewFromUtf8(v8::Isolate::GetCurrent(), response.at(1).value_str.c_str()));
 }
 
-void Service::worker()
-{
-	size_t totalSleepMS = 0;
-
-	while (!m_worker_stop) {
-		auto tp_start = std::chrono::high_resolution_clock::now();
-
-		// Validate Connection
-		auto conn = Controller::GetInstance().GetConnection();
-		if (!conn) {
-			goto do_sleep;
-		}
-
-		// Call
-		{
-			std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "Query", {});
-			if (!response.size() || (response.size() == 1)) {
-				goto do_sleep;
-			}
-
-			ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-			if (error == ErrorCode::Ok) {
-				std::shared_ptr<SignalInfo> data = std::make_shared<SignalInfo>();
-
-				data->outputType   = response[1].value_str;
-				data->signal       = response[2].value_str;
-				data->code         = response[3].value_union.i32;
-				data->errorMessage = response[4].value_str;
-				data->param        = this;
-
-				m_async_callback->queue(std::move(data));
-			}
-		}
-
-	do_sleep:
-		auto tp_end  = std::chrono::high_resolution_clock::now();
-		auto dur     = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
-		totalSleepMS = sleepIntervalMS - dur.count();
-		std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
-	}
-	return;
-}
-
 void Service::set_keepalive(v8::Local<v8::Object> obj)
 {
 	if (!m_async_callback)
@@ -290,7 +279,7 @@ void Service::set_keepalive(v8::Local<v8::Object> obj)
 
 void service::OBS_service_removeCallback(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
-	serviceObject->stop_worker();
+	serviceObject->unsubscribe();
 	serviceObject->stop_async_runner();
 }
 
@@ -313,6 +302,14 @@ INITIALIZER(nodeobs_service)
 
 		NODE_SET_METHOD(exports, "OBS_service_stopReplayBuffer", service::OBS_service_stopReplayBuffer);
 
+		NODE_SET_METHOD(exports, "OBS_service_startStreamingAsync", service::OBS_service_startStreamingAsync);
+
+		NODE_SET_METHOD(exports, "OBS_service_startRecordingAsync", service::OBS_service_startRecordingAsync);
+
+		NODE_SET_METHOD(exports, "OBS_service_stopStreamingAsync", service::OBS_service_stopStreamingAsync);
+
+		NODE_SET_METHOD(exports, "OBS_service_stopRecordingAsync", service::OBS_service_stopRecordingAsync);
+
 		NODE_SET_METHOD(exports, "OBS_service_connectOutputSignals", service::OBS_service_connectOutputSignals);
 
 		NODE_SET_METHOD(exports, "OBS_service_removeCallback", service::OBS_service_removeCallback);
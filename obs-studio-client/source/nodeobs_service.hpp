@@ -19,7 +19,6 @@
 #include <mutex>
 #include <nan.h>
 #include <node.h>
-#include <thread>
 #include "utility-v8.hpp"
 
 struct SignalInfo
@@ -28,6 +27,7 @@ struct SignalInfo
 	std::string signal;
 	int         code;
 	std::string errorMessage;
+	uint64_t    timestamp;
 	void*       param;
 };
 
@@ -41,12 +41,8 @@ class Service : public Nan::ObjectWrap, public utilv8::InterfaceObject<Service>,
 	friend utilv8::ManagedObject<Service>;
 	friend utilv8::CallbackData<SignalInfo, Service>;
 
-	uint32_t sleepIntervalMS = 33;
-
 	public:
-	std::thread m_worker;
-	bool        m_worker_stop = true;
-	std::mutex  m_worker_lock;
+	std::mutex m_worker_lock;
 
 	ServiceCallback* m_async_callback = nullptr;
 	Nan::Callback    m_callback_function;
@@ -57,9 +53,8 @@ class Service : public Nan::ObjectWrap, public utilv8::InterfaceObject<Service>,
 	void start_async_runner();
 	void stop_async_runner();
 	void callback_handler(void* data, std::shared_ptr<SignalInfo> item);
-	void start_worker();
-	void stop_worker();
-	void worker();
+	void subscribe();
+	void unsubscribe();
 	void set_keepalive(v8::Local<v8::Object>);
 
 	std::list<ServiceCallback*> callbacks;
@@ -77,6 +72,11 @@ namespace service
 	static void OBS_service_stopRecording(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void OBS_service_stopReplayBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
 
+	static void OBS_service_startStreamingAsync(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_service_startRecordingAsync(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_service_stopStreamingAsync(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_service_stopRecordingAsync(const v8::FunctionCallbackInfo<v8::Value>& args);
+
 	static void OBS_service_connectOutputSignals(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void OBS_service_removeCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void OBS_service_processReplayBufferHotkey(const v8::FunctionCallbackInfo<v8::Value>& args);
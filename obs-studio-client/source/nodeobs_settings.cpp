@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "nodeobs_settings.hpp"
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "utility-v8.hpp"
@@ -27,108 +28,45 @@
 #include "shared.hpp"
 #include "utility.hpp"
 
-std::vector<settings::SubCategory>
-    serializeCategory(uint32_t subCategoriesCount, uint32_t sizeStruct, std::vector<char> buffer)
+// Parses the sub categories straight out of the reply, returns false if it
+//  is truncated.
+static bool parseCategory(
+    uint32_t                            subCategoriesCount,
+    const char*                         data,
+    size_t                              size,
+    std::vector<settings::SubCategory>& category)
 {
-	std::vector<settings::SubCategory> category;
-
-	uint32_t indexData = 0;
-	for (int i = 0; i < int(subCategoriesCount); i++) {
-		settings::SubCategory sc;
-
-		size_t* sizeMessage = reinterpret_cast<size_t*>(buffer.data() + indexData);
-		indexData += sizeof(size_t);
-
-		std::string name(buffer.data() + indexData, *sizeMessage);
-		indexData += uint32_t(*sizeMessage);
-
-		size_t* paramsCount = reinterpret_cast<size_t*>(buffer.data() + indexData);
-		indexData += sizeof(size_t);
-
-		settings::Parameter param;
-		for (size_t j = 0; j < *paramsCount; j++) {
-			size_t* sizeName = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string name(buffer.data() + indexData, *sizeName);
-			indexData += uint32_t(*sizeName);
-
-			size_t* sizeDescription = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string description(buffer.data() + indexData, *sizeDescription);
-			indexData += uint32_t(*sizeDescription);
-
-			size_t* sizeType = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string type(buffer.data() + indexData, *sizeType);
-			indexData += uint32_t(*sizeType);
-
-			size_t* sizeSubType = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string subType(buffer.data() + indexData, *sizeSubType);
-			indexData += uint32_t(*sizeSubType);
-
-			bool* enabled = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			bool* masked = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			bool* visible = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			double* minVal = reinterpret_cast<double*>(buffer.data() + indexData);
-			indexData += sizeof(double);
-
-			double* maxVal = reinterpret_cast<double*>(buffer.data() + indexData);
-			indexData += sizeof(double);
-
-			double* stepVal = reinterpret_cast<double*>(buffer.data() + indexData);
-			indexData += sizeof(double);
-
-			size_t* sizeOfCurrentValue = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::vector<char> currentValue;
-			currentValue.resize(*sizeOfCurrentValue);
-			memcpy(currentValue.data(), buffer.data() + indexData, *sizeOfCurrentValue);
-			indexData += uint32_t(*sizeOfCurrentValue);
-
-			size_t* sizeOfValues = reinterpret_cast<size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			size_t* countValues = reinterpret_cast<size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::vector<char> values;
-			values.resize(*sizeOfValues);
-			memcpy(values.data(), buffer.data() + indexData, *sizeOfValues);
-			indexData += uint32_t(*sizeOfValues);
-
-			param.name         = name;
-			param.description  = description;
-			param.type         = type;
-			param.subType      = subType;
-			param.enabled      = *enabled;
-			param.masked       = *masked;
-			param.visible      = *visible;
-			param.minVal       = *minVal;
-			param.maxVal       = *maxVal;
-			param.stepVal      = *stepVal;
-			param.currentValue = currentValue;
-			param.values       = values;
-			param.countValues  = *countValues;
-
-			sc.params.push_back(param);
+	settings_buffer::reader r(data, size);
+
+	category.resize(subCategoriesCount);
+	for (settings::SubCategory& sc : category) {
+		size_t paramsCount = 0;
+		r.read(sc.name);
+		if (!r.read(paramsCount))
+			return false;
+
+		sc.paramsCount = uint32_t(paramsCount);
+		sc.params.resize(paramsCount);
+		for (settings::Parameter& param : sc.params) {
+			r.read(param.name);
+			r.read(param.description);
+			r.read(param.type);
+			r.read(param.subType);
+			r.read(param.enabled);
+			r.read(param.masked);
+			r.read(param.visible);
+			r.read(param.minVal);
+			r.read(param.maxVal);
+			r.read(param.stepVal);
+			r.read(param.sizeOfCurrentValue);
+			r.read(param.currentValue, param.sizeOfCurrentValue);
+			r.read(param.sizeOfValues);
+			r.read(param.countValues);
+			if (!r.read(param.values, param.sizeOfValues))
+				return false;
 		}
-		sc.name        = name;
-		sc.paramsCount = uint32_t(*paramsCount);
-		category.push_back(sc);
 	}
-	return category;
+	return true;
 }
 
 void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value>& args)
@@ -149,14 +87,24 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 	v8::Isolate*         isolate = v8::Isolate::GetCurrent();
 	v8::Local<v8::Array> rval    = v8::Array::New(isolate);
 
-	std::vector<settings::SubCategory> categorySettings = serializeCategory(
-	    uint32_t(response[1].value_union.ui64), uint32_t(response[2].value_union.ui64), response[3].value_bin);
+	const std::vector<char>& buffer = response[3].value_bin;
+	size_t                   size   = size_t(response[2].value_union.ui64);
+
+	std::vector<settings::SubCategory> categorySettings;
+	if (!parseCategory(
+	        uint32_t(response[1].value_union.ui64),
+	        buffer.data(),
+	        size < buffer.size() ? size : buffer.size(),
+	        categorySettings)) {
+		Nan::ThrowError("Settings buffer is truncated.");
+		return;
+	}
 
 	for (int i = 0; i < categorySettings.size(); i++) {
 		v8::Local<v8::Object> subCategory           = v8::Object::New(isolate);
 		v8::Local<v8::Array>  subCategoryParameters = v8::Array::New(isolate);
 
-		std::vector<settings::Parameter> params = categorySettings.at(i).params;
+		const std::vector<settings::Parameter>& params = categorySettings.at(i).params;
 
 		for (int j = 0; j < params.size(); j++) {
 			v8::Local<v8::Object> parameter = v8::Object::New(isolate);
@@ -189,7 +137,7 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 						v8::String::NewFromUtf8(isolate, value.c_str()));
 				}
 				else if (params.at(j).type.compare("OBS_PROPERTY_INT") == 0) {
-					int64_t *value = reinterpret_cast<int64_t*>(params.at(j).currentValue.data());
+					const int64_t *value = reinterpret_cast<const int64_t*>(params.at(j).currentValue.data());
 					parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
 						v8::Integer::New(isolate, int32_t(*value)));
 
@@ -202,7 +150,7 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 				} else if (
 				    params.at(j).type.compare("OBS_PROPERTY_UINT") == 0
 				    || params.at(j).type.compare("OBS_PROPERTY_BITMASK") == 0) {
-					uint64_t *value = reinterpret_cast<uint64_t*>(params.at(j).currentValue.data());
+					const uint64_t *value = reinterpret_cast<const uint64_t*>(params.at(j).currentValue.data());
 					parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
 						v8::Integer::New(isolate, int32_t(*value)));
 
@@ -214,12 +162,12 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 					    v8::String::NewFromUtf8(isolate, "stepVal"), v8::Number::New(isolate, params.at(j).stepVal));
 				}
 				else if (params.at(j).type.compare("OBS_PROPERTY_BOOL") == 0) {
-					bool *value = reinterpret_cast<bool*>(params.at(j).currentValue.data());
+					const bool *value = reinterpret_cast<const bool*>(params.at(j).currentValue.data());
 					parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
 						v8::Boolean::New(isolate, (*value)));
 				}
 				else if (params.at(j).type.compare("OBS_PROPERTY_DOUBLE") == 0) {
-					double *value = reinterpret_cast<double*>(params.at(j).currentValue.data());
+					const double *value = reinterpret_cast<const double*>(params.at(j).currentValue.data());
 					parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
 						v8::Number::New(isolate, *value));
 
@@ -232,7 +180,7 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 				}
 				else if (params.at(j).type.compare("OBS_PROPERTY_LIST") == 0) {
 					if (params.at(j).subType.compare("OBS_COMBO_FORMAT_INT") == 0) {
-						int64_t *value = reinterpret_cast<int64_t*>(params.at(j).currentValue.data());
+						const int64_t *value = reinterpret_cast<const int64_t*>(params.at(j).currentValue.data());
 						parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
 							v8::Integer::New(isolate, int32_t(*value)));
 
@@ -245,7 +193,7 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 								v8::Number::New(isolate, params.at(j).stepVal));
 					}
 					else if (params.at(j).subType.compare("OBS_COMBO_FORMAT_FLOAT") == 0) {
-						double *value = reinterpret_cast<double*>(params.at(j).currentValue.data());
+						const double *value = reinterpret_cast<const double*>(params.at(j).currentValue.data());
 						parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
 							v8::Number::New(isolate, *value));
 
@@ -277,12 +225,13 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 				v8::Local<v8::Object> valueObject = v8::Object::New(isolate);
 
 				if (params.at(j).subType.compare("OBS_COMBO_FORMAT_INT") == 0) {
-					size_t* sizeName = reinterpret_cast<std::size_t*>(params.at(j).values.data() + indexData);
+					const size_t* sizeName =
+					    reinterpret_cast<const std::size_t*>(params.at(j).values.data() + indexData);
 					indexData += sizeof(size_t);
 					std::string name(params.at(j).values.data() + indexData, *sizeName);
 					indexData += uint32_t(*sizeName);
 
-					int64_t* value = reinterpret_cast<int64_t*>(params.at(j).values.data() + indexData);
+					const int64_t* value = reinterpret_cast<const int64_t*>(params.at(j).values.data() + indexData);
 
 					indexData += sizeof(int64_t);
 
@@ -290,13 +239,13 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 						v8::Integer::New(isolate, int32_t(*value)));
 				}
 				else if (params.at(j).subType.compare("OBS_COMBO_FORMAT_FLOAT") == 0) {
-					size_t *sizeName =
-						reinterpret_cast<std::size_t*>(params.at(j).values.data() + indexData);
+					const size_t *sizeName =
+						reinterpret_cast<const std::size_t*>(params.at(j).values.data() + indexData);
 					indexData += sizeof(size_t);
 					std::string name(params.at(j).values.data() + indexData, *sizeName);
 					indexData += uint32_t(*sizeName);
 
-					double* value = reinterpret_cast<double*>(params.at(j).values.data() + indexData);
+					const double* value = reinterpret_cast<const double*>(params.at(j).values.data() + indexData);
 
 					indexData += sizeof(double);
 
@@ -304,13 +253,14 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 						v8::Number::New(isolate, *value));
 				}
 				else {
-					size_t *sizeName =
-						reinterpret_cast<std::size_t*>(params.at(j).values.data() + indexData);
+					const size_t *sizeName =
+						reinterpret_cast<const std::size_t*>(params.at(j).values.data() + indexData);
 					indexData += sizeof(size_t);
 					std::string name(params.at(j).values.data() + indexData, *sizeName);
 					indexData += uint32_t(*sizeName);
 
-					size_t* sizeValue = reinterpret_cast<std::size_t*>(params.at(j).values.data() + indexData);
+					const size_t* sizeValue =
+					    reinterpret_cast<const std::size_t*>(params.at(j).values.data() + indexData);
 					indexData += sizeof(size_t);
 					std::string value(params.at(j).values.data() + indexData, *sizeValue);
 					indexData += uint32_t(*sizeValue);
@@ -447,11 +397,14 @@ std::vector<char> deserializeCategory(uint32_t* subCategoriesCount, uint32_t* si
 		sucCategories.push_back(sc);
 	}
 
-	for (int i = 0; i < sucCategories.size(); i++) {
-		std::vector<char> serializedBuf = sucCategories.at(i).serialize();
+	size_t size = 0;
+	for (const settings::SubCategory& sc : sucCategories)
+		size += sc.serializedSize();
+	buffer.reserve(size);
 
-		buffer.insert(buffer.end(), serializedBuf.begin(), serializedBuf.end());
-	}
+	settings_buffer::writer w(buffer);
+	for (const settings::SubCategory& sc : sucCategories)
+		sc.serialize(w);
 
 	*subCategoriesCount = uint32_t(sucCategories.size());
 	*sizeStruct         = uint32_t(buffer.size());
@@ -481,6 +434,22 @@ void settings::OBS_settings_saveSettings(const v8::FunctionCallbackInfo<v8::Valu
 	ValidateResponse(response);
 }
 
+void settings::OBS_settings_saveSettingsAsync(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	std::string category;
+	ASSERT_GET_VALUE(args[0], category);
+
+	uint32_t             subCategoriesCount, sizeStruct;
+	v8::Local<v8::Array> settings = v8::Local<v8::Array>::Cast(args[1]);
+
+	std::vector<char> buffer = deserializeCategory(&subCategoriesCount, &sizeStruct, settings);
+
+	args.GetReturnValue().Set(async::call(
+	    "Settings",
+	    "OBS_settings_saveSettings",
+	    {ipc::value(category), ipc::value(subCategoriesCount), ipc::value(sizeStruct), ipc::value(buffer)}));
+}
+
 void settings::OBS_settings_getListCategories(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
 	auto conn = GetConnection();
@@ -509,6 +478,7 @@ INITIALIZER(nodeobs_settings)
 	initializerFunctions.push([](v8::Local<v8::Object> exports) {
 		NODE_SET_METHOD(exports, "OBS_settings_getSettings", settings::OBS_settings_getSettings);
 		NODE_SET_METHOD(exports, "OBS_settings_saveSettings", settings::OBS_settings_saveSettings);
+		NODE_SET_METHOD(exports, "OBS_settings_saveSettingsAsync", settings::OBS_settings_saveSettingsAsync);
 		NODE_SET_METHOD(exports, "OBS_settings_getListCategories", settings::OBS_settings_getListCategories);
 	});
 }
\ No newline at end of file
@@ -18,6 +18,7 @@
 
 #include <nan.h>
 #include <node.h>
+#include "settings-buffer.hpp"
 
 namespace settings
 {
@@ -39,66 +40,30 @@ namespace settings
 		size_t            countValues  = 0;
 		std::vector<char> values;
 
-		std::vector<char> serialize()
+		size_t serializedSize() const
 		{
-			std::vector<char> buffer;
-			uint32_t          indexBuffer = 0;
-
-			size_t sizeStruct = name.length() + description.length() + type.length() + subType.length()
-			                    + sizeof(size_t) * 7 + sizeof(bool) * 3 + sizeof(double) * 3 + sizeOfCurrentValue
-			                    + sizeOfValues;
-			buffer.resize(sizeStruct);
-
-			*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = name.length();
-			indexBuffer += sizeof(size_t);
-			memcpy(buffer.data() + indexBuffer, name.data(), name.length());
-			indexBuffer += uint32_t(name.length());
-
-			*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = description.length();
-			indexBuffer += sizeof(size_t);
-			memcpy(buffer.data() + indexBuffer, description.data(), description.length());
-			indexBuffer += uint32_t(description.length());
-
-			*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = type.length();
-			indexBuffer += sizeof(size_t);
-			memcpy(buffer.data() + indexBuffer, type.data(), type.length());
-			indexBuffer += uint32_t(type.length());
-
-			*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = subType.length();
-			indexBuffer += sizeof(size_t);
-			memcpy(buffer.data() + indexBuffer, subType.data(), subType.length());
-			indexBuffer += uint32_t(subType.length());
-
-			*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = enabled;
-			indexBuffer += sizeof(bool);
-			*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = masked;
-			indexBuffer += sizeof(bool);
-			*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = visible;
-			indexBuffer += sizeof(bool);
-
-			*reinterpret_cast<double*>(buffer.data() + indexBuffer) = minVal;
-			indexBuffer += sizeof(double);
-			*reinterpret_cast<double*>(buffer.data() + indexBuffer) = maxVal;
-			indexBuffer += sizeof(double);
-			*reinterpret_cast<double*>(buffer.data() + indexBuffer) = stepVal;
-			indexBuffer += sizeof(double);
-
-			*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = sizeOfCurrentValue;
-			indexBuffer += sizeof(size_t);
-
-			memcpy(buffer.data() + indexBuffer, currentValue.data(), sizeOfCurrentValue);
-			indexBuffer += uint32_t(sizeOfCurrentValue);
-
-			*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = sizeOfValues;
-			indexBuffer += sizeof(size_t);
-
-			*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = countValues;
-			indexBuffer += sizeof(size_t);
-
-			memcpy(buffer.data() + indexBuffer, values.data(), sizeOfValues);
-			indexBuffer += uint32_t(sizeOfValues);
+			return settings_buffer::string_size(name.length()) + settings_buffer::string_size(description.length())
+			       + settings_buffer::string_size(type.length()) + settings_buffer::string_size(subType.length())
+			       + sizeof(bool) * 3 + sizeof(double) * 3 + settings_buffer::string_size(sizeOfCurrentValue)
+			       + sizeof(size_t) * 2 + sizeOfValues;
+		}
 
-			return buffer;
+		void serialize(settings_buffer::writer& w) const
+		{
+			w.write(name);
+			w.write(description);
+			w.write(type);
+			w.write(subType);
+			w.write(enabled);
+			w.write(masked);
+			w.write(visible);
+			w.write(minVal);
+			w.write(maxVal);
+			w.write(stepVal);
+			w.write(currentValue.data(), sizeOfCurrentValue);
+			w.write(sizeOfValues);
+			w.write(countValues);
+			w.append(values.data(), sizeOfValues);
 		}
 	};
 
@@ -108,33 +73,25 @@ namespace settings
 		uint32_t               paramsCount = 0;
 		std::vector<Parameter> params;
 
-		std::vector<char> serialize()
+		size_t serializedSize() const
 		{
-			std::vector<char> buffer;
-			uint32_t          indexBuffer = 0;
-
-			size_t sizeStruct = name.length() + sizeof(size_t) + sizeof(uint32_t);
-			buffer.resize(sizeStruct);
-
-			*reinterpret_cast<size_t*>(buffer.data()) = name.length();
-			indexBuffer += sizeof(size_t);
-			memcpy(buffer.data() + indexBuffer, name.data(), name.length());
-			indexBuffer += uint32_t(name.length());
-
-			*reinterpret_cast<uint32_t*>(buffer.data() + indexBuffer) = paramsCount;
-			indexBuffer += sizeof(uint32_t);
-
-			for (int i = 0; i < params.size(); i++) {
-				std::vector<char> serializedBuf = params.at(i).serialize();
-
-				buffer.insert(buffer.end(), serializedBuf.begin(), serializedBuf.end());
-			}
+			size_t size = settings_buffer::string_size(name.length()) + sizeof(size_t);
+			for (const Parameter& param : params)
+				size += param.serializedSize();
+			return size;
+		}
 
-			return buffer;
+		void serialize(settings_buffer::writer& w) const
+		{
+			w.write(name);
+			w.write(size_t(paramsCount));
+			for (const Parameter& param : params)
+				param.serialize(w);
 		}
 	};
 
 	static void OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void OBS_settings_saveSettings(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_settings_saveSettingsAsync(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void OBS_settings_getListCategories(const v8::FunctionCallbackInfo<v8::Value>& args);
 } // namespace settings
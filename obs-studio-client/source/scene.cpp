@@ -18,12 +18,16 @@
 
 #include "scene.hpp"
 #include <condition_variable>
+#include <cstring>
 #include <mutex>
 #include <string>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "input.hpp"
 #include "ipc-value.hpp"
+#include "scene-snapshot.hpp"
+#include "sceneitem-batch.hpp"
 #include "sceneitem.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
@@ -44,6 +48,7 @@ void osn::Scene::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
 
 	// Class Template
 	utilv8::SetTemplateField(fnctemplate, "create", Create);
+	utilv8::SetTemplateField(fnctemplate, "createAsync", CreateAsync);
 	utilv8::SetTemplateField(fnctemplate, "createPrivate", CreatePrivate);
 	utilv8::SetTemplateField(fnctemplate, "fromName", FromName);
 
@@ -60,6 +65,8 @@ void osn::Scene::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
 	utilv8::SetTemplateField(objtemplate, "getItemAtIdx", GetItemAtIndex);
 	utilv8::SetTemplateField(objtemplate, "getItems", GetItems);
 	utilv8::SetTemplateField(objtemplate, "getItemsInRange", GetItemsInRange);
+	utilv8::SetTemplateField(objtemplate, "getSnapshot", GetSnapshot);
+	utilv8::SetTemplateField(objtemplate, "updateItems", UpdateItems);
 	utilv8::SetTemplateField(objtemplate, "connect", Connect);
 	utilv8::SetTemplateField(objtemplate, "disconnect", Disconnect);
 
@@ -92,6 +99,20 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::Create(Nan::NAN_METHOD_ARGS_TYPE info)
 	info.GetReturnValue().Set(osn::Scene::Store(obj));
 }
 
+Nan::NAN_METHOD_RETURN_TYPE osn::Scene::CreateAsync(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	std::string name;
+
+	ASSERT_INFO_LENGTH(info, 1);
+	ASSERT_GET_VALUE(info[0], name);
+
+	info.GetReturnValue().Set(async::call(
+	    "Scene", "Create", {ipc::value(name)}, [](std::vector<ipc::value>& response, v8::Local<v8::Object>) {
+		    osn::Scene* obj = new osn::Scene(response[1].value_union.ui64);
+		    return v8::Local<v8::Value>(osn::Scene::Store(obj));
+	    }));
+}
+
 Nan::NAN_METHOD_RETURN_TYPE osn::Scene::CreatePrivate(Nan::NAN_METHOD_ARGS_TYPE info)
 {
 	std::string name;
@@ -364,6 +385,186 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::GetItems(Nan::NAN_METHOD_ARGS_TYPE info)
 	info.GetReturnValue().Set(arr);
 }
 
+Nan::NAN_METHOD_RETURN_TYPE osn::Scene::GetSnapshot(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	osn::Scene* scene = nullptr;
+	if (!utilv8::RetrieveDynamicCast<osn::ISource, osn::Scene>(info.This(), scene)) {
+		return;
+	}
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Scene", "GetSnapshot", std::vector<ipc::value>{ipc::value(scene->sourceId)});
+
+	if (!ValidateResponse(response))
+		return;
+
+	uint32_t                 count   = response[1].value_union.ui32;
+	std::vector<char> const& records = response[2].value_bin;
+	std::vector<char> const& strings = response[3].value_bin;
+	if (records.size() != count * sizeof(scene_snapshot::item_record)) {
+		Nan::ThrowError("Malformed scene snapshot.");
+		return;
+	}
+
+	// One copy into a buffer owned by JavaScript, every view shares it.
+	auto buffer = v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), records.size());
+	if (!records.empty())
+		memcpy(buffer->GetContents().Data(), records.data(), records.size());
+	size_t words = records.size() / sizeof(uint32_t);
+
+	auto   names  = Nan::New<v8::Array>(count);
+	auto   types  = Nan::New<v8::Array>(count);
+	size_t offset = 0;
+	for (uint32_t idx = 0; idx < count; idx++) {
+		std::string name, type;
+		if (!scene_snapshot::read_string(strings, offset, name) || !scene_snapshot::read_string(strings, offset, type))
+			break;
+		Nan::Set(names, idx, utilv8::ToValue(name));
+		Nan::Set(types, idx, utilv8::ToValue(type));
+	}
+
+	auto obj = Nan::New<v8::Object>();
+	utilv8::SetObjectField(obj, "count", count);
+	utilv8::SetObjectField(obj, "stride", scene_snapshot::record_words);
+	Nan::Set(obj, utilv8::ToValue("buffer"), buffer);
+	Nan::Set(obj, utilv8::ToValue("f32"), v8::Float32Array::New(buffer, 0, words));
+	Nan::Set(obj, utilv8::ToValue("u32"), v8::Uint32Array::New(buffer, 0, words));
+	Nan::Set(obj, utilv8::ToValue("i32"), v8::Int32Array::New(buffer, 0, words));
+	Nan::Set(obj, utilv8::ToValue("names"), names);
+	Nan::Set(obj, utilv8::ToValue("types"), types);
+	info.GetReturnValue().Set(obj);
+}
+
+// True if 'field' is set on 'object' to anything but undefined.
+static bool HasField(v8::Local<v8::Object> object, const char* field)
+{
+	return !Nan::Get(object, utilv8::ToValue(field)).ToLocalChecked()->IsUndefined();
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::Scene::UpdateItems(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	ASSERT_INFO_LENGTH(info, 1);
+	if (!info[0]->IsArray()) {
+		Nan::ThrowTypeError("Expected an array of item updates.");
+		return;
+	}
+	v8::Local<v8::Array> updates = info[0].As<v8::Array>();
+
+	osn::Scene* scene = nullptr;
+	if (!utilv8::RetrieveDynamicCast<osn::ISource, osn::Scene>(info.This(), scene)) {
+		return;
+	}
+
+	std::vector<sceneitem_batch::command> commands(updates->Length());
+	std::vector<uint64_t>                 itemIds(updates->Length());
+	for (uint32_t idx = 0; idx < updates->Length(); idx++) {
+		v8::Local<v8::Object> update;
+		v8::Local<v8::Object> itemObj;
+		osn::SceneItem*       item = nullptr;
+		ASSERT_GET_VALUE(Nan::Get(updates, idx).ToLocalChecked(), update);
+		ASSERT_GET_OBJECT_FIELD(update, "item", itemObj);
+		if (!osn::SceneItem::Retrieve(itemObj, item)) {
+			return;
+		}
+
+		sceneitem_batch::command& cmd = commands[idx];
+		std::memset(&cmd, 0, sizeof(sceneitem_batch::command));
+		cmd.item_uid = itemIds[idx] = item->itemId;
+
+		v8::Local<v8::Object> vector;
+		if (HasField(update, "position")) {
+			ASSERT_GET_OBJECT_FIELD(update, "position", vector);
+			ASSERT_GET_OBJECT_FIELD(vector, "x", cmd.pos[0]);
+			ASSERT_GET_OBJECT_FIELD(vector, "y", cmd.pos[1]);
+			cmd.mask |= sceneitem_batch::position;
+		}
+		if (HasField(update, "scale")) {
+			ASSERT_GET_OBJECT_FIELD(update, "scale", vector);
+			ASSERT_GET_OBJECT_FIELD(vector, "x", cmd.scale[0]);
+			ASSERT_GET_OBJECT_FIELD(vector, "y", cmd.scale[1]);
+			cmd.mask |= sceneitem_batch::scale;
+		}
+		if (HasField(update, "rotation")) {
+			ASSERT_GET_OBJECT_FIELD(update, "rotation", cmd.rot);
+			cmd.mask |= sceneitem_batch::rotation;
+		}
+		if (HasField(update, "alignment")) {
+			ASSERT_GET_OBJECT_FIELD(update, "alignment", cmd.alignment);
+			cmd.mask |= sceneitem_batch::alignment;
+		}
+		if (HasField(update, "bounds")) {
+			ASSERT_GET_OBJECT_FIELD(update, "bounds", vector);
+			ASSERT_GET_OBJECT_FIELD(vector, "x", cmd.bounds[0]);
+			ASSERT_GET_OBJECT_FIELD(vector, "y", cmd.bounds[1]);
+			cmd.mask |= sceneitem_batch::bounds;
+		}
+		if (HasField(update, "boundsType")) {
+			ASSERT_GET_OBJECT_FIELD(update, "boundsType", cmd.bounds_type);
+			cmd.mask |= sceneitem_batch::bounds_type;
+		}
+		if (HasField(update, "boundsAlignment")) {
+			ASSERT_GET_OBJECT_FIELD(update, "boundsAlignment", cmd.bounds_alignment);
+			cmd.mask |= sceneitem_batch::bounds_alignment;
+		}
+		if (HasField(update, "crop")) {
+			ASSERT_GET_OBJECT_FIELD(update, "crop", vector);
+			ASSERT_GET_OBJECT_FIELD(vector, "left", cmd.crop[0]);
+			ASSERT_GET_OBJECT_FIELD(vector, "top", cmd.crop[1]);
+			ASSERT_GET_OBJECT_FIELD(vector, "right", cmd.crop[2]);
+			ASSERT_GET_OBJECT_FIELD(vector, "bottom", cmd.crop[3]);
+			cmd.mask |= sceneitem_batch::crop;
+		}
+		if (HasField(update, "scaleFilter")) {
+			ASSERT_GET_OBJECT_FIELD(update, "scaleFilter", cmd.scale_filter);
+			cmd.mask |= sceneitem_batch::scale_filter;
+		}
+		bool flag;
+		if (HasField(update, "visible")) {
+			ASSERT_GET_OBJECT_FIELD(update, "visible", flag);
+			cmd.visible = flag;
+			cmd.mask |= sceneitem_batch::visible;
+		}
+		if (HasField(update, "selected")) {
+			ASSERT_GET_OBJECT_FIELD(update, "selected", flag);
+			cmd.selected = flag;
+			cmd.mask |= sceneitem_batch::selected;
+		}
+	}
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<char> batch(commands.size() * sizeof(sceneitem_batch::command));
+	if (!batch.empty())
+		memcpy(batch.data(), commands.data(), batch.size());
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "SceneItem", "UpdateBatch", std::vector<ipc::value>{ipc::value(scene->sourceId), ipc::value(batch)});
+
+	// Whatever got applied, cached transforms of these items are outdated.
+	for (uint64_t itemId : itemIds)
+		osn::SceneItem::Invalidate(itemId);
+
+	if (!ValidateResponse(response))
+		return;
+
+	std::vector<char> const& status = response[1].value_bin;
+	auto                     arr    = Nan::New<v8::Array>(uint32_t(commands.size()));
+	for (uint32_t idx = 0; idx < commands.size(); idx++) {
+		uint32_t code = uint32_t(ErrorCode::Error);
+		if (status.size() >= (idx + 1) * sizeof(uint32_t))
+			memcpy(&code, &status[idx * sizeof(uint32_t)], sizeof(uint32_t));
+		Nan::Set(arr, idx, utilv8::ToValue(code));
+	}
+
+	info.GetReturnValue().Set(arr);
+}
+
 Nan::NAN_METHOD_RETURN_TYPE osn::Scene::GetItemsInRange(Nan::NAN_METHOD_ARGS_TYPE info)
 {
 	osn::Scene* scene = nullptr;
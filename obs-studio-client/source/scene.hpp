@@ -38,6 +38,7 @@ namespace osn
 		static void Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target);
 
 		static Nan::NAN_METHOD_RETURN_TYPE Create(Nan::NAN_METHOD_ARGS_TYPE info);
+		static Nan::NAN_METHOD_RETURN_TYPE CreateAsync(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE CreatePrivate(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE FromName(Nan::NAN_METHOD_ARGS_TYPE info);
 
@@ -53,6 +54,8 @@ namespace osn
 		static Nan::NAN_METHOD_RETURN_TYPE GetItemAtIndex(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE GetItems(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE GetItemsInRange(Nan::NAN_METHOD_ARGS_TYPE info);
+		static Nan::NAN_METHOD_RETURN_TYPE GetSnapshot(Nan::NAN_METHOD_ARGS_TYPE info);
+		static Nan::NAN_METHOD_RETURN_TYPE UpdateItems(Nan::NAN_METHOD_ARGS_TYPE info);
 
 		static Nan::NAN_METHOD_RETURN_TYPE Connect(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE Disconnect(Nan::NAN_METHOD_ARGS_TYPE info);
@@ -16,12 +16,16 @@
 
 ******************************************************************************/
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "error.hpp"
+#include "event-bus.hpp"
 #include "input.hpp"
 #include "ipc-value.hpp"
 #include "scene.hpp"
@@ -34,6 +38,190 @@ osn::SceneItem::SceneItem(uint64_t id)
 	this->itemId = id;
 }
 
+// Transform and visibility of an item, as reported by SceneItem.GetTransformInfo.
+struct ItemState
+{
+	float    pos[2];
+	float    scale[2];
+	uint32_t scale_filter;
+	float    rot;
+	uint32_t alignment;
+	float    bounds[2];
+	uint32_t bounds_type;
+	uint32_t bounds_alignment;
+	uint32_t crop[4];
+	bool     visible;
+	uint64_t version;
+};
+
+// Client copy of item state. The server moves an item's version forward every
+//  time its state changes and announces the new version on the event channel,
+//  a cached state is served until a newer version has been announced.
+class ItemCache
+{
+	struct entry
+	{
+		ItemState state;
+		bool      filled = false;
+		uint64_t  latest = 0;
+	};
+
+	public:
+	static ItemCache& GetInstance()
+	{
+		static ItemCache _inst;
+		return _inst;
+	}
+
+	bool get(uint64_t id, ItemState& state)
+	{
+		subscribe();
+
+		std::unique_lock<std::mutex> ul(m_lock);
+		validate();
+		auto iter = m_items.find(id);
+		if (iter == m_items.end() || !iter->second.filled || iter->second.state.version < iter->second.latest)
+			return false;
+		state = iter->second.state;
+		return true;
+	}
+
+	void put(uint64_t id, const ItemState& state)
+	{
+		std::unique_lock<std::mutex> ul(m_lock);
+		validate();
+		entry& e = m_items[id];
+		if (e.filled && e.state.version > state.version)
+			return;
+		e.state  = state;
+		e.filled = true;
+	}
+
+	// Applies a setter reply. The server returns the version its change led to,
+	//  the cached state can only be patched if it is the one just before it.
+	template<typename F>
+	void patch(uint64_t id, uint64_t version, F fn)
+	{
+		std::unique_lock<std::mutex> ul(m_lock);
+		validate();
+		auto iter = m_items.find(id);
+		if (iter == m_items.end())
+			return;
+
+		entry& e = iter->second;
+		if (e.filled && e.state.version + 1 == version) {
+			fn(e.state);
+			e.state.version = version;
+		} else if (!e.filled || e.state.version != version) {
+			m_items.erase(iter);
+		}
+	}
+
+	void drop(uint64_t id)
+	{
+		std::unique_lock<std::mutex> ul(m_lock);
+		m_items.erase(id);
+	}
+
+	private:
+	ItemCache() : m_connection(nullptr), m_subscribed(false) {}
+
+	// Called from the event reader thread.
+	void announce(uint64_t id, uint64_t version)
+	{
+		std::unique_lock<std::mutex> ul(m_lock);
+		if (version == UINT64_MAX) {
+			m_items.erase(id);
+			return;
+		}
+		entry& e = m_items[id];
+		if (version > e.latest)
+			e.latest = version;
+	}
+
+	void subscribe()
+	{
+		if (m_subscribed.exchange(true))
+			return;
+
+		// Not under m_lock, the bus holds its own lock while calling announce.
+		EventBus::GetInstance().subscribe(event_frame::type::scene_item, [this](event_frame::reader& payload) {
+			uint32_t count = 0;
+			payload.read(count);
+			for (uint32_t idx = 0; idx < count; idx++) {
+				uint64_t id, version;
+				payload.read(id);
+				if (!payload.read(version))
+					break;
+				announce(id, version);
+			}
+		});
+	}
+
+	// Versions mean nothing to a different server.
+	void validate()
+	{
+		ipc::client* conn = Controller::GetInstance().GetConnection().get();
+		if (conn != m_connection) {
+			m_items.clear();
+			m_connection = conn;
+		}
+	}
+
+	std::mutex                          m_lock;
+	std::unordered_map<uint64_t, entry> m_items;
+	ipc::client*                        m_connection;
+	std::atomic<bool>                   m_subscribed;
+};
+
+// `response` is a validated SceneItem.GetTransformInfo reply.
+static void ReadState(const std::vector<ipc::value>& response, ItemState& state)
+{
+	state.pos[0]           = response[1].value_union.fp32;
+	state.pos[1]           = response[2].value_union.fp32;
+	state.scale[0]         = response[3].value_union.fp32;
+	state.scale[1]         = response[4].value_union.fp32;
+	state.scale_filter     = response[5].value_union.ui32;
+	state.rot              = response[6].value_union.fp32;
+	state.alignment        = response[7].value_union.ui32;
+	state.bounds[0]        = response[8].value_union.fp32;
+	state.bounds[1]        = response[9].value_union.fp32;
+	state.bounds_type      = response[10].value_union.ui32;
+	state.bounds_alignment = response[11].value_union.ui32;
+	state.crop[0]          = response[12].value_union.ui32;
+	state.crop[1]          = response[13].value_union.ui32;
+	state.crop[2]          = response[14].value_union.ui32;
+	state.crop[3]          = response[15].value_union.ui32;
+	state.visible          = !!response[16].value_union.ui32;
+	state.version          = response[17].value_union.ui64;
+}
+
+// Serves the item state from the cache, or fetches it in one call if stale.
+static bool GetState(osn::SceneItem* item, ItemState& state)
+{
+	if (ItemCache::GetInstance().get(item->itemId, state))
+		return true;
+
+	auto conn = GetConnection();
+	if (!conn)
+		return false;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "SceneItem", "GetTransformInfo", std::vector<ipc::value>{ipc::value(item->itemId)});
+
+	if (!ValidateResponse(response))
+		return false;
+
+	ReadState(response, state);
+	ItemCache::GetInstance().put(item->itemId, state);
+	return true;
+}
+
+void osn::SceneItem::Invalidate(uint64_t id)
+{
+	ItemCache::GetInstance().drop(id);
+}
+
 Nan::Persistent<v8::FunctionTemplate> osn::SceneItem::prototype = Nan::Persistent<v8::FunctionTemplate>();
 
 void osn::SceneItem::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
@@ -65,6 +253,8 @@ void osn::SceneItem::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
 	utilv8::SetTemplateField(objtemplate, "moveBottom", MoveBottom);
 	utilv8::SetTemplateField(objtemplate, "move", Move);
 	utilv8::SetTemplateField(objtemplate, "remove", Remove);
+	utilv8::SetTemplateField(objtemplate, "removeAsync", RemoveAsync);
+	utilv8::SetTemplateField(objtemplate, "getTransformInfoAsync", GetTransformInfoAsync);
 	utilv8::SetTemplateField(objtemplate, "deferUpdateBegin", DeferUpdateBegin);
 	utilv8::SetTemplateField(objtemplate, "deferUpdateEnd", DeferUpdateEnd);
 
@@ -134,28 +324,44 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::Remove(Nan::NAN_METHOD_ARGS_TYPE inf
 
 	if (!ValidateResponse(response))
 		return;
+	ItemCache::GetInstance().drop(item->itemId);
 	item->itemId = UINT64_MAX;
 }
 
-Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::IsVisible(Nan::NAN_METHOD_ARGS_TYPE info)
+Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::RemoveAsync(Nan::NAN_METHOD_ARGS_TYPE info)
 {
 	osn::SceneItem* item = nullptr;
 	if (!Retrieve(info.This(), item)) {
 		return;
 	}
 
-	auto conn = GetConnection();
-	if (!conn)
-		return;
+	info.GetReturnValue().Set(async::call(
+	    "SceneItem",
+	    "Remove",
+	    {ipc::value(item->itemId)},
+	    [](std::vector<ipc::value>&, v8::Local<v8::Object> self) {
+		    osn::SceneItem* item = nullptr;
+		    if (Retrieve(self, item)) {
+			    ItemCache::GetInstance().drop(item->itemId);
+			    item->itemId = UINT64_MAX;
+		    }
+		    return v8::Local<v8::Value>();
+	    },
+	    info.This()));
+}
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "IsVisible", std::vector<ipc::value>{ipc::value(item->itemId)});
+Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::IsVisible(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	osn::SceneItem* item = nullptr;
+	if (!Retrieve(info.This(), item)) {
+		return;
+	}
 
-	if (!ValidateResponse(response))
+	ItemState state;
+	if (!GetState(item, state))
 		return;
-	bool flag = !!response[1].value_union.ui32;
 
-	info.GetReturnValue().Set(flag);
+	info.GetReturnValue().Set(state.visible);
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetVisible(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -176,7 +382,12 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetVisible(Nan::NAN_METHOD_ARGS_TYPE
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 	    "SceneItem", "SetVisible", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
 
-	ValidateResponse(response);
+	if (!ValidateResponse(response))
+		return;
+
+	ItemCache::GetInstance().patch(item->itemId, response[2].value_union.ui64, [&response](ItemState& state) {
+		state.visible = !!response[1].value_union.ui32;
+	});
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::IsSelected(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -228,21 +439,13 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetPosition(Nan::NAN_METHOD_ARGS_TYP
 		return;
 	}
 
-	auto conn = GetConnection();
-	if (!conn)
+	ItemState state;
+	if (!GetState(item, state))
 		return;
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetPosition", std::vector<ipc::value>{ipc::value(item->itemId)});
-
-	if (!ValidateResponse(response))
-		return;
-	float x = response[1].value_union.fp32;
-	float y = response[2].value_union.fp32;
-
 	auto obj = Nan::New<v8::Object>();
-	utilv8::SetObjectField(obj, "x", x);
-	utilv8::SetObjectField(obj, "y", y);
+	utilv8::SetObjectField(obj, "x", state.pos[0]);
+	utilv8::SetObjectField(obj, "y", state.pos[1]);
 	info.GetReturnValue().Set(obj);
 }
 
@@ -269,7 +472,13 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetPosition(Nan::NAN_METHOD_ARGS_TYP
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 	    "SceneItem", "SetPosition", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(x), ipc::value(y)});
 
-	ValidateResponse(response);
+	if (!ValidateResponse(response))
+		return;
+
+	ItemCache::GetInstance().patch(item->itemId, response[3].value_union.ui64, [&response](ItemState& state) {
+		state.pos[0] = response[1].value_union.fp32;
+		state.pos[1] = response[2].value_union.fp32;
+	});
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetRotation(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -279,18 +488,11 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetRotation(Nan::NAN_METHOD_ARGS_TYP
 		return;
 	}
 
-	auto conn = GetConnection();
-	if (!conn)
+	ItemState state;
+	if (!GetState(item, state))
 		return;
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetRotation", std::vector<ipc::value>{ipc::value(item->itemId)});
-
-	if (!ValidateResponse(response))
-		return;
-	float rotation = response[1].value_union.fp32;
-
-	info.GetReturnValue().Set(rotation);
+	info.GetReturnValue().Set(state.rot);
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetRotation(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -312,7 +514,12 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetRotation(Nan::NAN_METHOD_ARGS_TYP
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 	    "SceneItem", "SetRotation", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(vector)});
 
-	ValidateResponse(response);
+	if (!ValidateResponse(response))
+		return;
+
+	ItemCache::GetInstance().patch(item->itemId, response[2].value_union.ui64, [&response](ItemState& state) {
+		state.rot = response[1].value_union.fp32;
+	});
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetScale(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -322,21 +529,13 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetScale(Nan::NAN_METHOD_ARGS_TYPE i
 		return;
 	}
 
-	auto conn = GetConnection();
-	if (!conn)
-		return;
-
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetScale", std::vector<ipc::value>{ipc::value(item->itemId)});
-
-	if (!ValidateResponse(response))
+	ItemState state;
+	if (!GetState(item, state))
 		return;
-	float x = response[1].value_union.fp32;
-	float y = response[2].value_union.fp32;
 
 	auto obj = Nan::New<v8::Object>();
-	utilv8::SetObjectField(obj, "x", x);
-	utilv8::SetObjectField(obj, "y", y);
+	utilv8::SetObjectField(obj, "x", state.scale[0]);
+	utilv8::SetObjectField(obj, "y", state.scale[1]);
 	info.GetReturnValue().Set(obj);
 }
 
@@ -363,7 +562,13 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetScale(Nan::NAN_METHOD_ARGS_TYPE i
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 	    "SceneItem", "SetScale", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(x), ipc::value(y)});
 
-	ValidateResponse(response);
+	if (!ValidateResponse(response))
+		return;
+
+	ItemCache::GetInstance().patch(item->itemId, response[3].value_union.ui64, [&response](ItemState& state) {
+		state.scale[0] = response[1].value_union.fp32;
+		state.scale[1] = response[2].value_union.fp32;
+	});
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetScaleFilter(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -373,16 +578,11 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetScaleFilter(Nan::NAN_METHOD_ARGS_
 		return;
 	}
 
-	auto conn = GetConnection();
-	if (!conn)
+	ItemState state;
+	if (!GetState(item, state))
 		return;
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetScaleFilter", std::vector<ipc::value>{ipc::value(item->itemId)});
-
-	if (!ValidateResponse(response))
-		return;
-	bool flag = !!response[1].value_union.ui32;
+	bool flag = !!state.scale_filter;
 
 	info.GetReturnValue().Set(flag);
 }
@@ -405,7 +605,12 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetScaleFilter(Nan::NAN_METHOD_ARGS_
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 	    "SceneItem", "SetScaleFilter", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
 
-	ValidateResponse(response);
+	if (!ValidateResponse(response))
+		return;
+
+	ItemCache::GetInstance().patch(item->itemId, response[2].value_union.ui64, [&response](ItemState& state) {
+		state.scale_filter = response[1].value_union.ui32;
+	});
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetAlignment(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -415,17 +620,11 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetAlignment(Nan::NAN_METHOD_ARGS_TY
 		return;
 	}
 
-	auto conn = GetConnection();
-	if (!conn)
+	ItemState state;
+	if (!GetState(item, state))
 		return;
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetAlignment", std::vector<ipc::value>{ipc::value(item->itemId)});
-
-	if (!ValidateResponse(response))
-		return;
-
-	bool flag = !!response[1].value_union.ui32;
+	bool flag = !!state.alignment;
 
 	info.GetReturnValue().Set(flag);
 }
@@ -448,7 +647,12 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetAlignment(Nan::NAN_METHOD_ARGS_TY
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 	    "SceneItem", "SetAlignment", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
 
-	ValidateResponse(response);
+	if (!ValidateResponse(response))
+		return;
+
+	ItemCache::GetInstance().patch(item->itemId, response[2].value_union.ui64, [&response](ItemState& state) {
+		state.alignment = response[1].value_union.ui32;
+	});
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetBounds(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -458,21 +662,13 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetBounds(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 	}
 
-	auto conn = GetConnection();
-	if (!conn)
-		return;
-
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetBounds", std::vector<ipc::value>{ipc::value(item->itemId)});
-
-	if (!ValidateResponse(response))
+	ItemState state;
+	if (!GetState(item, state))
 		return;
-	float x = response[1].value_union.fp32;
-	float y = response[2].value_union.fp32;
 
 	auto obj = Nan::New<v8::Object>();
-	utilv8::SetObjectField(obj, "x", x);
-	utilv8::SetObjectField(obj, "y", y);
+	utilv8::SetObjectField(obj, "x", state.bounds[0]);
+	utilv8::SetObjectField(obj, "y", state.bounds[1]);
 	info.GetReturnValue().Set(obj);
 }
 
@@ -499,7 +695,13 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetBounds(Nan::NAN_METHOD_ARGS_TYPE
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 	    "SceneItem", "SetBounds", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(x), ipc::value(y)});
 
-	ValidateResponse(response);
+	if (!ValidateResponse(response))
+		return;
+
+	ItemCache::GetInstance().patch(item->itemId, response[3].value_union.ui64, [&response](ItemState& state) {
+		state.bounds[0] = response[1].value_union.fp32;
+		state.bounds[1] = response[2].value_union.fp32;
+	});
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetBoundsAlignment(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -509,18 +711,11 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetBoundsAlignment(Nan::NAN_METHOD_A
 		return;
 	}
 
-	auto conn = GetConnection();
-	if (!conn)
-		return;
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "GetBoundsAlignment", std::vector<ipc::value>{ipc::value(item->itemId)});
-
-	if (!ValidateResponse(response))
+	ItemState state;
+	if (!GetState(item, state))
 		return;
-	uint32_t bounds_alignment = response[1].value_union.ui32;
 
-	info.GetReturnValue().Set(bounds_alignment);
+	info.GetReturnValue().Set(state.bounds_alignment);
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetBoundsAlignment(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -541,7 +736,12 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetBoundsAlignment(Nan::NAN_METHOD_A
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 	    "SceneItem", "SetBoundsAlignment", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
 
-	ValidateResponse(response);
+	if (!ValidateResponse(response))
+		return;
+
+	ItemCache::GetInstance().patch(item->itemId, response[2].value_union.ui64, [&response](ItemState& state) {
+		state.bounds_alignment = response[1].value_union.ui32;
+	});
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetBoundsType(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -551,18 +751,11 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetBoundsType(Nan::NAN_METHOD_ARGS_T
 		return;
 	}
 
-	auto conn = GetConnection();
-	if (!conn)
-		return;
-
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetBoundsType", std::vector<ipc::value>{ipc::value(item->itemId)});
-
-	if (!ValidateResponse(response))
+	ItemState state;
+	if (!GetState(item, state))
 		return;
-	uint32_t bounds_type = response[1].value_union.ui32;
 
-	info.GetReturnValue().Set(bounds_type);
+	info.GetReturnValue().Set(state.bounds_type);
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetBoundsType(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -583,7 +776,12 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetBoundsType(Nan::NAN_METHOD_ARGS_T
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 	    "SceneItem", "SetBoundsType", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
 
-	ValidateResponse(response);
+	if (!ValidateResponse(response))
+		return;
+
+	ItemCache::GetInstance().patch(item->itemId, response[2].value_union.ui64, [&response](ItemState& state) {
+		state.bounds_type = response[1].value_union.ui32;
+	});
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetCrop(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -593,26 +791,15 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetCrop(Nan::NAN_METHOD_ARGS_TYPE in
 		return;
 	}
 
-	auto conn = GetConnection();
-	if (!conn)
-		return;
-
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetCrop", std::vector<ipc::value>{ipc::value(item->itemId)});
-
-	if (!ValidateResponse(response))
+	ItemState state;
+	if (!GetState(item, state))
 		return;
 
-	uint32_t left   = response[1].value_union.i32;
-	uint32_t top    = response[2].value_union.i32;
-	uint32_t right  = response[3].value_union.i32;
-	uint32_t bottom = response[4].value_union.i32;
-
 	auto obj = Nan::New<v8::Object>();
-	utilv8::SetObjectField(obj, "left", left);
-	utilv8::SetObjectField(obj, "top", top);
-	utilv8::SetObjectField(obj, "right", right);
-	utilv8::SetObjectField(obj, "bottom", bottom);
+	utilv8::SetObjectField(obj, "left", state.crop[0]);
+	utilv8::SetObjectField(obj, "top", state.crop[1]);
+	utilv8::SetObjectField(obj, "right", state.crop[2]);
+	utilv8::SetObjectField(obj, "bottom", state.crop[3]);
 	info.GetReturnValue().Set(obj);
 }
 
@@ -646,58 +833,87 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetCrop(Nan::NAN_METHOD_ARGS_TYPE in
 	    std::vector<ipc::value>{
 	        ipc::value(item->itemId), ipc::value(left), ipc::value(top), ipc::value(right), ipc::value(bottom)});
 
-	ValidateResponse(response);
-}
-
-Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetTransformInfo(Nan::NAN_METHOD_ARGS_TYPE info)
-{
-	osn::SceneItem* item = nullptr;
-	if (!Retrieve(info.This(), item)) {
-		return;
-	}
-
-	auto conn = GetConnection();
-	if (!conn)
-		return;
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "GetTransformInfo", std::vector<ipc::value>{ipc::value(item->itemId)});
-
 	if (!ValidateResponse(response))
 		return;
 
+	ItemCache::GetInstance().patch(item->itemId, response[5].value_union.ui64, [&response](ItemState& state) {
+		state.crop[0] = response[1].value_union.ui32;
+		state.crop[1] = response[2].value_union.ui32;
+		state.crop[2] = response[3].value_union.ui32;
+		state.crop[3] = response[4].value_union.ui32;
+	});
+}
+
+// Shared by GetTransformInfo and GetTransformInfoAsync.
+static v8::Local<v8::Value> ToTransformInfo(const ItemState& state)
+{
 	/* Guess we forgot about alignment, not sure where this goes */
-	uint32_t alignment = response[7].value_union.ui32;
+	uint32_t alignment = state.alignment;
 
 	auto positionObj = Nan::New<v8::Object>();
-	utilv8::SetObjectField(positionObj, "x", response[1].value_union.fp32);
-	utilv8::SetObjectField(positionObj, "y", response[2].value_union.fp32);
+	utilv8::SetObjectField(positionObj, "x", state.pos[0]);
+	utilv8::SetObjectField(positionObj, "y", state.pos[1]);
 
 	auto scaleObj = Nan::New<v8::Object>();
-	utilv8::SetObjectField(scaleObj, "x", response[3].value_union.fp32);
-	utilv8::SetObjectField(scaleObj, "y", response[4].value_union.fp32);
+	utilv8::SetObjectField(scaleObj, "x", state.scale[0]);
+	utilv8::SetObjectField(scaleObj, "y", state.scale[1]);
 
 	auto boundsObj = Nan::New<v8::Object>();
-	utilv8::SetObjectField(boundsObj, "x", response[8].value_union.fp32);
-	utilv8::SetObjectField(boundsObj, "y", response[9].value_union.fp32);
+	utilv8::SetObjectField(boundsObj, "x", state.bounds[0]);
+	utilv8::SetObjectField(boundsObj, "y", state.bounds[1]);
 
 	auto cropObj = Nan::New<v8::Object>();
-	utilv8::SetObjectField(cropObj, "left", response[12].value_union.ui32);
-	utilv8::SetObjectField(cropObj, "top", response[13].value_union.ui32);
-	utilv8::SetObjectField(cropObj, "right", response[14].value_union.ui32);
-	utilv8::SetObjectField(cropObj, "bottom", response[15].value_union.ui32);
+	utilv8::SetObjectField(cropObj, "left", state.crop[0]);
+	utilv8::SetObjectField(cropObj, "top", state.crop[1]);
+	utilv8::SetObjectField(cropObj, "right", state.crop[2]);
+	utilv8::SetObjectField(cropObj, "bottom", state.crop[3]);
 
 	auto obj = Nan::New<v8::Object>();
 	utilv8::SetObjectField(obj, "pos", positionObj);
 	utilv8::SetObjectField(obj, "scale", scaleObj);
 	utilv8::SetObjectField(obj, "bounds", boundsObj);
 	utilv8::SetObjectField(obj, "crop", cropObj);
-	utilv8::SetObjectField(obj, "scaleFilter", response[5].value_union.ui32);
-	utilv8::SetObjectField(obj, "rotation", response[6].value_union.fp32);
-	utilv8::SetObjectField(obj, "boundsType", response[10].value_union.ui32);
-	utilv8::SetObjectField(obj, "boundsAlignment", response[11].value_union.ui32);
+	utilv8::SetObjectField(obj, "scaleFilter", state.scale_filter);
+	utilv8::SetObjectField(obj, "rotation", state.rot);
+	utilv8::SetObjectField(obj, "boundsType", state.bounds_type);
+	utilv8::SetObjectField(obj, "boundsAlignment", state.bounds_alignment);
 
-	info.GetReturnValue().Set(obj);
+	return obj;
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetTransformInfo(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	osn::SceneItem* item = nullptr;
+	if (!Retrieve(info.This(), item)) {
+		return;
+	}
+
+	ItemState state;
+	if (!GetState(item, state))
+		return;
+
+	info.GetReturnValue().Set(ToTransformInfo(state));
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetTransformInfoAsync(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	osn::SceneItem* item = nullptr;
+	if (!Retrieve(info.This(), item)) {
+		return;
+	}
+
+	uint64_t itemId = item->itemId;
+	info.GetReturnValue().Set(async::call(
+	    "SceneItem",
+	    "GetTransformInfo",
+	    {ipc::value(itemId)},
+	    [itemId](std::vector<ipc::value>& response, v8::Local<v8::Object>) {
+		    ItemState state;
+		    ReadState(response, state);
+		    ItemCache::GetInstance().put(itemId, state);
+		    return ToTransformInfo(state);
+	    },
+	    info.This()));
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetTransformInfo(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -35,6 +35,9 @@ namespace osn
 		uint64_t itemId;
 		SceneItem(uint64_t id);
 
+		// Forgets the cached transform of an item changed behind its back.
+		static void Invalidate(uint64_t id);
+
 		// JavaScript
 		public:
 		static Nan::Persistent<v8::FunctionTemplate> prototype;
@@ -44,6 +47,7 @@ namespace osn
 		static Nan::NAN_METHOD_RETURN_TYPE GetSource(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE GetScene(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE Remove(Nan::NAN_METHOD_ARGS_TYPE info);
+		static Nan::NAN_METHOD_RETURN_TYPE RemoveAsync(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE IsVisible(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE SetVisible(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE IsSelected(Nan::NAN_METHOD_ARGS_TYPE info);
@@ -67,6 +71,7 @@ namespace osn
 		static Nan::NAN_METHOD_RETURN_TYPE GetCrop(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE SetCrop(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE GetTransformInfo(Nan::NAN_METHOD_ARGS_TYPE info);
+		static Nan::NAN_METHOD_RETURN_TYPE GetTransformInfoAsync(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE SetTransformInfo(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE GetId(Nan::NAN_METHOD_ARGS_TYPE info);
 		static Nan::NAN_METHOD_RETURN_TYPE MoveUp(Nan::NAN_METHOD_ARGS_TYPE info);
@@ -17,9 +17,265 @@
 ******************************************************************************/
 
 #include "utility-v8.hpp"
+#include <cmath>
+#include <vector>
+#include "obs-data-binary.hpp"
 
 std::string ValueToTypeName(v8::Local<v8::Value> v)
 {
 	v8::Local<v8::String> type = v->TypeOf(v8::Isolate::GetCurrent());
 	return std::string(*v8::String::Utf8Value(type));
 }
+
+// Keeps what JSON.stringify followed by obs_data_create_from_json would:
+//  undefined, null, functions and non-finite numbers are left out, integral
+//  numbers become integers and arrays only keep their objects. Only own
+//  enumerable keys are written, and a cycle throws a TypeError.
+typedef std::vector<v8::Local<v8::Object>> encode_stack;
+
+// Deeper settings than this throw instead of overflowing the native stack.
+static const size_t max_encode_depth = 1000;
+
+static bool encode_object(v8::Local<v8::Object> object, obs_data_binary::writer& w, encode_stack& parents);
+
+static bool is_number(v8::Local<v8::Value> value)
+{
+	return value->IsNumber() && std::isfinite(value.As<v8::Number>()->Value());
+}
+
+// Values obs_data can hold: booleans, finite numbers, strings, objects and
+//  arrays of objects.
+static bool is_encodable(v8::Local<v8::Value> value)
+{
+	return value->IsBoolean() || is_number(value) || value->IsString() || (value->IsObject() && !value->IsFunction());
+}
+
+// Writes the type tag of 'value' followed by the value itself.
+static bool encode_value(v8::Local<v8::Value> value, obs_data_binary::writer& w, encode_stack& parents)
+{
+	if (value->IsBoolean()) {
+		w.write(obs_data_binary::type::boolean);
+		w.write(uint8_t(value->IsTrue()));
+	} else if (is_number(value)) {
+		double number = value.As<v8::Number>()->Value();
+		if ((std::trunc(number) == number) && (std::fabs(number) <= 9007199254740992.0)) {
+			w.write(obs_data_binary::type::integer);
+			w.write(int64_t(number));
+		} else {
+			w.write(obs_data_binary::type::number);
+			w.write(number);
+		}
+	} else if (value->IsString()) {
+		Nan::Utf8String str(value);
+		w.write(obs_data_binary::type::string);
+		w.write(*str, size_t(str.length()));
+	} else if (value->IsArray()) {
+		v8::Local<v8::Array> array = value.As<v8::Array>();
+		w.write(obs_data_binary::type::array);
+		size_t   elements_at = w.reserve_count();
+		uint32_t elements    = 0;
+		for (uint32_t n = 0; n < array->Length(); n++) {
+			v8::Local<v8::Value> element;
+			if (!Nan::Get(array, n).ToLocal(&element))
+				return false;
+			if (!element->IsObject() || element->IsArray() || element->IsFunction())
+				continue;
+			if (!encode_object(element.As<v8::Object>(), w, parents))
+				return false;
+			elements++;
+		}
+		w.patch_count(elements_at, elements);
+	} else {
+		w.write(obs_data_binary::type::object);
+		if (!encode_object(value.As<v8::Object>(), w, parents))
+			return false;
+	}
+	return true;
+}
+
+static bool encode_object(v8::Local<v8::Object> object, obs_data_binary::writer& w, encode_stack& parents)
+{
+	// Only the objects being encoded count, the same object may still appear
+	//  twice side by side.
+	for (auto& parent : parents) {
+		if (parent->StrictEquals(object)) {
+			Nan::ThrowTypeError("Converting circular structure to JSON");
+			return false;
+		}
+	}
+	if (parents.size() >= max_encode_depth) {
+		Nan::ThrowRangeError("Maximum settings depth exceeded");
+		return false;
+	}
+
+	v8::Local<v8::Array> keys;
+	if (!object
+	         ->GetPropertyNames(
+	             Nan::GetCurrentContext(),
+	             v8::KeyCollectionMode::kOwnOnly,
+	             static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS),
+	             v8::IndexFilter::kIncludeIndices)
+	         .ToLocal(&keys))
+		return false;
+
+	parents.push_back(object);
+
+	size_t   count_at = w.reserve_count();
+	uint32_t count    = 0;
+	for (uint32_t idx = 0; idx < keys->Length(); idx++) {
+		v8::Local<v8::Value> key, value;
+		if (!Nan::Get(keys, idx).ToLocal(&key) || !Nan::Get(object, key).ToLocal(&value))
+			return false;
+		if (!is_encodable(value))
+			continue;
+
+		Nan::Utf8String name(key);
+		w.write(*name, size_t(name.length()));
+		if (!encode_value(value, w, parents))
+			return false;
+		count++;
+	}
+	parents.pop_back();
+
+	w.patch_count(count_at, count);
+	return true;
+}
+
+static bool decode_object(obs_data_binary::reader& r, v8::Local<v8::Object>& out)
+{
+	uint32_t count = 0;
+	if (!r.read(count))
+		return false;
+
+	v8::Local<v8::Object> object = Nan::New<v8::Object>();
+	for (uint32_t n = 0; n < count; n++) {
+		const char* chars  = nullptr;
+		uint32_t    length = 0;
+		uint8_t     t      = 0;
+		r.read(chars, length);
+		if (!r.read(t))
+			return false;
+		v8::Local<v8::String> key = Nan::New<v8::String>(chars, int(length)).ToLocalChecked();
+
+		v8::Local<v8::Value> value;
+		switch (obs_data_binary::type(t)) {
+		case obs_data_binary::type::boolean: {
+			uint8_t v = 0;
+			if (!r.read(v))
+				return false;
+			value = Nan::New<v8::Boolean>(!!v);
+			break;
+		}
+		case obs_data_binary::type::integer: {
+			int64_t v = 0;
+			if (!r.read(v))
+				return false;
+			value = Nan::New<v8::Number>(double(v));
+			break;
+		}
+		case obs_data_binary::type::number: {
+			double v = 0;
+			if (!r.read(v))
+				return false;
+			value = Nan::New<v8::Number>(v);
+			break;
+		}
+		case obs_data_binary::type::string:
+			if (!r.read(chars, length))
+				return false;
+			value = Nan::New<v8::String>(chars, int(length)).ToLocalChecked();
+			break;
+		case obs_data_binary::type::object: {
+			v8::Local<v8::Object> child;
+			if (!decode_object(r, child))
+				return false;
+			value = child;
+			break;
+		}
+		case obs_data_binary::type::array: {
+			uint32_t elements = 0;
+			if (!r.read(elements))
+				return false;
+			v8::Local<v8::Array> array = Nan::New<v8::Array>(elements);
+			for (uint32_t idx = 0; idx < elements; idx++) {
+				v8::Local<v8::Object> child;
+				if (!decode_object(r, child))
+					return false;
+				Nan::Set(array, idx, child);
+			}
+			value = array;
+			break;
+		}
+		default:
+			return false;
+		}
+		Nan::Set(object, key, value);
+	}
+
+	out = object;
+	return true;
+}
+
+bool utilv8::EncodeSettings(v8::Local<v8::Object> object, std::vector<char>& buf)
+{
+	// Encoding only fails when reading the object threw, e.g. from a getter,
+	//  or on a cycle. That exception is what JSON.stringify would have thrown.
+	Nan::TryCatch           tc;
+	obs_data_binary::writer w(buf);
+	encode_stack            parents;
+	if (encode_object(object, w, parents))
+		return true;
+
+	if (tc.HasCaught())
+		tc.ReThrow();
+	else
+		Nan::ThrowError("Failed to encode settings.");
+	return false;
+}
+
+static bool encode_patch(v8::Local<v8::Array> ops, obs_data_binary::writer& w)
+{
+	encode_stack parents;
+	w.write(uint32_t(ops->Length()));
+	for (uint32_t idx = 0; idx < ops->Length(); idx++) {
+		v8::Local<v8::Value> op, path, value;
+		if (!Nan::Get(ops, idx).ToLocal(&op) || !op->IsObject())
+			return false;
+		if (!Nan::Get(op.As<v8::Object>(), Nan::New("path").ToLocalChecked()).ToLocal(&path) || !path->IsString())
+			return false;
+		if (!Nan::Get(op.As<v8::Object>(), Nan::New("value").ToLocalChecked()).ToLocal(&value)
+		    || !is_encodable(value))
+			return false;
+
+		Nan::Utf8String name(path);
+		w.write(*name, size_t(name.length()));
+		if (!encode_value(value, w, parents))
+			return false;
+	}
+	return true;
+}
+
+bool utilv8::EncodeSettingsPatch(v8::Local<v8::Array> ops, std::vector<char>& buf)
+{
+	Nan::TryCatch           tc;
+	obs_data_binary::writer w(buf);
+	if (encode_patch(ops, w))
+		return true;
+
+	if (tc.HasCaught())
+		tc.ReThrow();
+	else
+		Nan::ThrowTypeError("Patch operations must be {path: string, value} objects.");
+	return false;
+}
+
+v8::Local<v8::Value> utilv8::DecodeSettings(std::vector<char> const& buf)
+{
+	obs_data_binary::reader r(buf);
+	v8::Local<v8::Object>   object;
+	if (!decode_object(r, object)) {
+		Nan::ThrowError("Failed to decode settings.");
+		return v8::Local<v8::Value>();
+	}
+	return object;
+}
@@ -843,4 +843,12 @@ namespace utilv8
 			uv_async_send(&m_async_runner);
 		}
 	};
+
+	// Settings objects in the binary encoding of obs-data-binary.hpp, what
+	//  the server turns into obs_data without going through JSON. A patch is
+	//  a list of {path, value} operations, 'path' being dot separated keys.
+	//  All three throw on failure, returning false or an empty handle.
+	bool                 EncodeSettings(v8::Local<v8::Object> object, std::vector<char>& buf);
+	bool                 EncodeSettingsPatch(v8::Local<v8::Array> ops, std::vector<char>& buf);
+	v8::Local<v8::Value> DecodeSettings(std::vector<char> const& buf);
 } // namespace utilv8
@@ -17,15 +17,18 @@
 ******************************************************************************/
 
 #include "volmeter.hpp"
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 #include <vector>
 #include "controller.hpp"
 #include "error.hpp"
+#include "event-bus.hpp"
 #include "isource.hpp"
 #include "shared.hpp"
 #include "utility-v8.hpp"
 #include "utility.hpp"
+#include "volmeter-frame.hpp"
 
 osn::VolMeter::VolMeter(uint64_t p_uid)
 {
@@ -75,92 +78,88 @@ void osn::VolMeter::callback_handler(void* data, std::shared_ptr<osn::VolMeterDa
 	Nan::Call(m_callback_function, 3, args);
 }
 
-void osn::VolMeter::start_worker()
+void osn::VolMeter::subscribe(VolMeter* meter)
 {
-	if (!m_worker_stop)
+	bool first;
+	{
+		std::unique_lock<std::mutex> ul(s_meters_lock);
+		s_meters[meter->m_uid] = meter;
+		first                  = (s_meters.size() == 1);
+	}
+
+	// The bus dispatches under its own lock and then takes s_meters_lock, so
+	//  it must never be called with s_meters_lock held.
+	if (first) {
+		EventBus::GetInstance().subscribe(event_frame::type::volmeter_frames, [](event_frame::reader& payload) {
+			std::vector<char>            frames = payload.remaining();
+			std::unique_lock<std::mutex> ul(s_meters_lock);
+			dispatch_frames(frames);
+		});
+	}
+	update_interval();
+
+	// Give the new meter its current levels right away instead of waiting for
+	//  the source to produce audio.
+	auto conn = GetConnection();
+	if (!conn)
 		return;
 
-	// Launch worker thread.
-	m_worker_stop = false;
-	m_worker      = std::thread(std::bind(&osn::VolMeter::worker, this));
+	std::vector<char> uids(sizeof(uint64_t));
+	std::memcpy(uids.data(), &meter->m_uid, sizeof(uint64_t));
+	std::vector<ipc::value> response = conn->call_synchronous_helper("VolMeter", "QueryMany", {ipc::value(uids)});
+	if ((response.size() >= 2) && (response[0].type != ipc::type::Null)
+	    && ((ErrorCode)response[0].value_union.ui64 == ErrorCode::Ok)) {
+		std::unique_lock<std::mutex> ul(s_meters_lock);
+		dispatch_frames(response[1].value_bin);
+	}
 }
 
-void osn::VolMeter::stop_worker()
+void osn::VolMeter::unsubscribe(VolMeter* meter)
 {
-	if (m_worker_stop != false)
-		return;
+	bool last;
+	{
+		std::unique_lock<std::mutex> ul(s_meters_lock);
+		if (!s_meters.erase(meter->m_uid))
+			return;
+		last = s_meters.empty();
+	}
 
-	// Stop worker thread.
-	m_worker_stop = true;
-	if (m_worker.joinable()) {
-		m_worker.join();
+	if (last) {
+		EventBus::GetInstance().unsubscribe(event_frame::type::volmeter_frames);
 	}
+	update_interval();
 }
 
-void osn::VolMeter::worker()
+void osn::VolMeter::update_interval()
 {
-	size_t totalSleepMS = 0;
+	uint32_t interval = 0;
+	{
+		std::unique_lock<std::mutex> ul(s_meters_lock);
+		for (auto& kv : s_meters) {
+			if (!interval || kv.second->m_sleep_interval < interval)
+				interval = kv.second->m_sleep_interval;
+		}
+	}
+	EventBus::GetInstance().set_meter_interval(interval);
+}
 
-	while (!m_worker_stop) {
-		auto tp_start = std::chrono::high_resolution_clock::now();
+void osn::VolMeter::dispatch_frames(std::vector<char> const& frames)
+{
+	size_t   offset = 0;
+	uint64_t uid;
 
-		// Validate Connection
-		auto conn = Controller::GetInstance().GetConnection();
-		if (!conn) {
-			goto do_sleep;
+	while (true) {
+		std::shared_ptr<osn::VolMeterData> data = std::make_shared<osn::VolMeterData>();
+		if (!volmeter::read_frame(frames, offset, uid, data->magnitude, data->peak, data->input_peak)) {
+			break;
 		}
 
-		// Call
-		try {
-			std::unique_lock<std::mutex> ul(m_worker_lock);
-
-			if (!m_async_callback)
-				goto do_sleep;
-
-			std::vector<ipc::value> response = conn->call_synchronous_helper(
-			    "VolMeter",
-			    "Query",
-			    {
-			        ipc::value(m_uid),
-			    });
-			if (!response.size()) {
-				goto do_sleep;
-			}
-			if ((response.size() == 1) && (response[0].type == ipc::type::Null)) {
-				goto do_sleep;
-			}
-
-			ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-			if (error == ErrorCode::Ok) {
-				std::shared_ptr<osn::VolMeterData> data     = std::make_shared<osn::VolMeterData>();
-				size_t                             channels = response[1].value_union.i32;
-				data->magnitude.resize(channels);
-				data->peak.resize(channels);
-				data->input_peak.resize(channels);
-				data->param = this;
-				for (size_t ch = 0; ch < channels; ch++) {
-					data->magnitude[ch]  = response[1 + ch * 3 + 0].value_union.fp32;
-					data->peak[ch]       = response[1 + ch * 3 + 1].value_union.fp32;
-					data->input_peak[ch] = response[1 + ch * 3 + 2].value_union.fp32;
-				}
-				m_async_callback->queue(std::move(data));
-			} else if(error == ErrorCode::InvalidReference) {
-				goto do_sleep;
-			}
-			else
-			{
-				std::cerr << "Failed VolMeter" << std::endl;
-				break;
-			}
-		} catch (std::exception e) {
-			goto do_sleep;
+		auto meter = s_meters.find(uid);
+		if ((meter == s_meters.end()) || !meter->second->m_async_callback) {
+			continue;
 		}
-
-	do_sleep:
-		auto tp_end  = std::chrono::high_resolution_clock::now();
-		auto dur     = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
-		totalSleepMS = m_sleep_interval - dur.count();
-		std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
+		data->param = meter->second;
+		meter->second->m_async_callback->queue(std::move(data));
 	}
 }
 
@@ -173,6 +172,9 @@ void osn::VolMeter::set_keepalive(v8::Local<v8::Object> obj)
 
 Nan::Persistent<v8::FunctionTemplate> osn::VolMeter::prototype = Nan::Persistent<v8::FunctionTemplate>();
 
+std::mutex                         osn::VolMeter::s_meters_lock;
+std::map<uint64_t, osn::VolMeter*> osn::VolMeter::s_meters;
+
 void osn::VolMeter::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
 {
 	auto fnctemplate = Nan::New<v8::FunctionTemplate>();
@@ -293,6 +295,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::SetUpdateInterval(Nan::NAN_METHOD_ARG
 	}
 
 	self->m_sleep_interval = interval;
+	update_interval();
 
 	// Return DeziBel Value
 	info.GetReturnValue().Set(rval[1].value_union.ui32);
@@ -393,7 +396,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::AddCallback(Nan::NAN_METHOD_ARGS_TYPE
 	self->m_callback_function.Reset(callback);
 	self->start_async_runner();
 	self->set_keepalive(info.This());
-	self->start_worker();
+	subscribe(self);
 
 	info.GetReturnValue().Set(true);
 }
@@ -409,7 +412,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::RemoveCallback(Nan::NAN_METHOD_ARGS_T
 		}
 	}
 
-	self->stop_worker();
+	unsubscribe(self);
 	self->stop_async_runner();
 	self->m_callback_function.Reset();
 
@@ -17,9 +17,10 @@
 ******************************************************************************/
 
 #pragma once
+#include <map>
+#include <mutex>
 #include <nan.h>
 #include <node.h>
-#include <thread>
 #include "utility-v8.hpp"
 
 namespace osn
@@ -45,13 +46,16 @@ namespace osn
 		uint64_t m_uid;
 		uint32_t m_sleep_interval = 33;
 
-		std::thread m_worker;
-		bool        m_worker_stop = true;
-		std::mutex  m_worker_lock;
+		std::mutex m_worker_lock;
 
 		osn::VolMeterCallback* m_async_callback = nullptr;
 		Nan::Callback          m_callback_function;
 
+		// All meters with a callback share the volmeter_frames events of the
+		// EventBus, which are fanned out by uid.
+		static std::mutex                    s_meters_lock;
+		static std::map<uint64_t, VolMeter*> s_meters;
+
 		public:
 		VolMeter(uint64_t uid);
 		~VolMeter();
@@ -62,9 +66,10 @@ namespace osn
 		void stop_async_runner();
 		void callback_handler(void* data, std::shared_ptr<osn::VolMeterData> item);
 
-		void start_worker();
-		void stop_worker();
-		void worker();
+		static void subscribe(VolMeter* meter);
+		static void unsubscribe(VolMeter* meter);
+		static void update_interval();
+		static void dispatch_frames(std::vector<char> const& frames);
 
 		void set_keepalive(v8::Local<v8::Object>);
 
@@ -0,0 +1,144 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Measures find() on utility::unique_object_manager against the std::map
+//  plus recursive_mutex lookup it replaced.
+//
+// obs-bench-handle-table [objects] [lookups] [threads]
+//
+// Defaults to 10000 live objects, 10000000 random lookups per thread and
+//  1 and 4 reader threads.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "utility.hpp"
+
+struct Object
+{
+	uint64_t value;
+};
+
+// Lookup path of unique_object_manager before the handle table.
+class map_object_manager
+{
+	std::map<uint64_t, Object*> object_map;
+	std::recursive_mutex        internal_mutex;
+	uint64_t                    next_id = 0;
+
+	public:
+	uint64_t allocate(Object* obj)
+	{
+		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+		uint64_t                              uid = next_id++;
+		object_map[uid] = obj;
+		return uid;
+	}
+
+	Object* find(uint64_t id)
+	{
+		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+		auto iter = object_map.find(id);
+		if (iter != object_map.end()) {
+			return iter->second;
+		}
+		return nullptr;
+	}
+};
+
+template<typename Manager>
+static double measure(Manager& manager, const std::vector<uint64_t>& ids, size_t lookups, size_t threads)
+{
+	std::vector<std::thread> workers;
+	std::vector<uint64_t>    sums(threads, 0);
+
+	auto start = std::chrono::steady_clock::now();
+	for (size_t idx = 0; idx < threads; idx++) {
+		workers.emplace_back([&manager, &ids, &sums, lookups, idx]() {
+			// xorshift64, so that the generator does not dominate the timing.
+			uint64_t state = 0x9E3779B97F4A7C15ull * (idx + 1);
+			uint64_t sum   = 0;
+			for (size_t n = 0; n < lookups; n++) {
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+				Object* obj = manager.find(ids[state % ids.size()]);
+				if (obj)
+					sum += obj->value;
+			}
+			sums[idx] = sum;
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+	auto elapsed = std::chrono::steady_clock::now() - start;
+
+	// Keeps the lookups from being optimized away.
+	uint64_t total = 0;
+	for (uint64_t sum : sums)
+		total += sum;
+	if (total == 0)
+		std::fprintf(stderr, "no object was found\n");
+
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / double(lookups);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t objects = argc > 1 ? size_t(std::strtoull(argv[1], nullptr, 10)) : 10000;
+	size_t lookups = argc > 2 ? size_t(std::strtoull(argv[2], nullptr, 10)) : 10000000;
+	size_t threads = argc > 3 ? size_t(std::strtoull(argv[3], nullptr, 10)) : 0;
+	if (objects == 0 || lookups == 0) {
+		std::fprintf(stderr, "usage: obs-bench-handle-table [objects] [lookups] [threads]\n");
+		return 1;
+	}
+
+	std::vector<Object> storage(objects);
+	for (size_t idx = 0; idx < objects; idx++)
+		storage[idx].value = idx + 1;
+
+	utility::unique_object_manager<Object> table;
+	map_object_manager                     map;
+	std::vector<uint64_t>                  table_ids;
+	std::vector<uint64_t>                  map_ids;
+	for (auto& obj : storage) {
+		table_ids.push_back(table.allocate(&obj));
+		map_ids.push_back(map.allocate(&obj));
+	}
+
+	std::vector<size_t> thread_counts;
+	if (threads > 0)
+		thread_counts.push_back(threads);
+	else
+		thread_counts = {1, 4};
+
+	std::printf("%zu live objects, %zu lookups per thread\n", objects, lookups);
+	for (size_t count : thread_counts) {
+		double table_ns = measure(table, table_ids, lookups, count);
+		double map_ns   = measure(map, map_ids, lookups, count);
+		std::printf("%zu thread(s): handle table %.1f ns/op, map + mutex %.1f ns/op\n", count, table_ns, map_ns);
+	}
+
+	return 0;
+}
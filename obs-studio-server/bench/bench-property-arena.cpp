@@ -0,0 +1,729 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Measures a full Source.GetProperties round trip of the property arena
+//  against the one std::vector<char> per property encoding it replaced.
+//
+// obs-bench-property-arena [properties] [iterations]
+//
+// Both paths serialize the same property set, copy the reply once like the
+//  IPC layer does and decode it into client side properties. Defaults to 500
+//  properties, a mix of booleans, integers, floats, texts and string lists,
+//  for 2000 iterations.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+#include "obs-property.hpp"
+
+// Client side property, filled by both decoders.
+struct Decoded
+{
+	uint8_t     type    = 0;
+	bool        enabled = false;
+	bool        visible = false;
+	std::string name;
+	std::string description;
+	std::string long_description;
+	int64_t     int_value[4]   = {0};
+	double      float_value[4] = {0};
+	std::string text;
+
+	struct Item
+	{
+		std::string name;
+		bool        disabled;
+		std::string value;
+	};
+	std::vector<Item> items;
+};
+
+// Encoding of obs::Property before the arena: every property is its own
+//  buffer sized by size(), which each level of serialize() and read()
+//  recomputes. Lengths are size_t. Only the types this benchmark uses are
+//  kept, in the shape they had.
+namespace legacy
+{
+	struct Property
+	{
+		std::string name;
+		std::string description;
+		std::string long_description;
+		bool        enabled;
+		bool        visible;
+
+		virtual ~Property(){};
+
+		static std::shared_ptr<Property> deserialize(std::vector<char> const& buf);
+
+		virtual obs::Property::Type type()
+		{
+			return obs::Property::Type::Invalid;
+		}
+
+		virtual size_t size()
+		{
+			size_t total = 0;
+			total += sizeof(obs::Property::Type);
+			total += sizeof(size_t);
+			total += name.size();
+			total += sizeof(size_t);
+			total += description.size();
+			total += sizeof(size_t);
+			total += long_description.size();
+			total += sizeof(uint8_t) * 2; // enabled, visible
+			return total;
+		}
+
+		virtual bool serialize(std::vector<char>& buf)
+		{
+			if (buf.size() < size()) {
+				return false;
+			}
+
+			size_t offset = 0;
+			buf[offset]   = uint8_t(type());
+			offset++;
+
+			reinterpret_cast<size_t&>(buf[offset]) = name.size();
+			offset += sizeof(size_t);
+			std::memcpy(&buf[offset], name.data(), name.size());
+			offset += name.size();
+
+			reinterpret_cast<size_t&>(buf[offset]) = description.size();
+			offset += sizeof(size_t);
+			std::memcpy(&buf[offset], description.data(), description.size());
+			offset += description.size();
+
+			reinterpret_cast<size_t&>(buf[offset]) = long_description.size();
+			offset += sizeof(size_t);
+			std::memcpy(&buf[offset], long_description.data(), long_description.size());
+			offset += long_description.size();
+
+			buf[offset] = enabled;
+			offset++;
+			buf[offset] = visible;
+			offset++;
+
+			return true;
+		}
+
+		virtual bool read(std::vector<char> const& buf)
+		{
+			if (buf.size() < size()) {
+				return false;
+			}
+
+			size_t offset = 1;
+			size_t length = 0;
+
+			length = reinterpret_cast<const size_t&>(buf[offset]);
+			offset += sizeof(size_t);
+			name = std::string(&buf[offset], length);
+			offset += length;
+
+			length = reinterpret_cast<const size_t&>(buf[offset]);
+			offset += sizeof(size_t);
+			description = std::string(&buf[offset], length);
+			offset += length;
+
+			length = reinterpret_cast<const size_t&>(buf[offset]);
+			offset += sizeof(size_t);
+			long_description = std::string(&buf[offset], length);
+			offset += length;
+
+			enabled = !!buf[offset];
+			offset += sizeof(uint8_t);
+			visible = !!buf[offset];
+			offset += sizeof(uint8_t);
+
+			return true;
+		}
+	};
+
+	struct BooleanProperty : Property
+	{
+		bool value;
+
+		virtual obs::Property::Type type() override
+		{
+			return obs::Property::Type::Boolean;
+		}
+
+		virtual size_t size() override
+		{
+			return Property::size() + sizeof(bool);
+		}
+
+		virtual bool serialize(std::vector<char>& buf) override
+		{
+			if (buf.size() < size() || !Property::serialize(buf)) {
+				return false;
+			}
+			*reinterpret_cast<bool*>(&buf[Property::size()]) = value;
+			return true;
+		}
+
+		virtual bool read(std::vector<char> const& buf) override
+		{
+			if (buf.size() < size() || !Property::read(buf)) {
+				return false;
+			}
+			value = *reinterpret_cast<const bool*>(&buf[Property::size()]);
+			return true;
+		}
+	};
+
+	template<typename T, obs::Property::Type Kind>
+	struct NumberProperty : Property
+	{
+		uint8_t field_type;
+		T       minimum;
+		T       maximum;
+		T       step;
+		T       value;
+
+		virtual obs::Property::Type type() override
+		{
+			return Kind;
+		}
+
+		size_t number_size()
+		{
+			return Property::size() + sizeof(uint8_t);
+		}
+
+		virtual size_t size() override
+		{
+			return number_size() + sizeof(T) * 4;
+		}
+
+		virtual bool serialize(std::vector<char>& buf) override
+		{
+			if (buf.size() < size() || buf.size() < number_size() || !Property::serialize(buf)) {
+				return false;
+			}
+			buf[Property::size()] = field_type;
+
+			size_t offset                       = number_size();
+			*reinterpret_cast<T*>(&buf[offset]) = minimum;
+			offset += sizeof(T);
+			*reinterpret_cast<T*>(&buf[offset]) = maximum;
+			offset += sizeof(T);
+			*reinterpret_cast<T*>(&buf[offset]) = step;
+			offset += sizeof(T);
+			*reinterpret_cast<T*>(&buf[offset]) = value;
+			return true;
+		}
+
+		virtual bool read(std::vector<char> const& buf) override
+		{
+			if (buf.size() < size() || buf.size() < number_size() || !Property::read(buf)) {
+				return false;
+			}
+			field_type = buf[Property::size()];
+
+			size_t offset = number_size();
+			minimum       = *reinterpret_cast<const T*>(&buf[offset]);
+			offset += sizeof(T);
+			maximum = *reinterpret_cast<const T*>(&buf[offset]);
+			offset += sizeof(T);
+			step = *reinterpret_cast<const T*>(&buf[offset]);
+			offset += sizeof(T);
+			value = *reinterpret_cast<const T*>(&buf[offset]);
+			return true;
+		}
+	};
+
+	typedef NumberProperty<int64_t, obs::Property::Type::Integer> IntegerProperty;
+	typedef NumberProperty<double, obs::Property::Type::Float>    FloatProperty;
+
+	struct TextProperty : Property
+	{
+		uint8_t     field_type;
+		std::string value;
+
+		virtual obs::Property::Type type() override
+		{
+			return obs::Property::Type::Text;
+		}
+
+		virtual size_t size() override
+		{
+			return Property::size() + sizeof(uint8_t) + sizeof(size_t) + value.size();
+		}
+
+		virtual bool serialize(std::vector<char>& buf) override
+		{
+			if (buf.size() < size() || !Property::serialize(buf)) {
+				return false;
+			}
+
+			size_t offset = Property::size();
+			buf[offset]   = field_type;
+			offset += sizeof(uint8_t);
+
+			reinterpret_cast<size_t&>(buf[offset]) = value.size();
+			offset += sizeof(size_t);
+			if (value.size() > 0) {
+				std::memcpy(&buf[offset], value.data(), value.size());
+			}
+			return true;
+		}
+
+		virtual bool read(std::vector<char> const& buf) override
+		{
+			if (buf.size() < size() || !Property::read(buf)) {
+				return false;
+			}
+
+			size_t offset = Property::size();
+			field_type    = buf[offset];
+			offset += sizeof(uint8_t);
+
+			size_t length = reinterpret_cast<const size_t&>(buf[offset]);
+			offset += sizeof(size_t);
+			if (length > 0) {
+				value = std::string(&buf[offset], length);
+			}
+			return true;
+		}
+	};
+
+	// String format only.
+	struct ListProperty : Property
+	{
+		struct Item
+		{
+			std::string name;
+			bool        enabled;
+			std::string value_string;
+		};
+
+		uint8_t         field_type;
+		std::list<Item> items;
+		std::string     current_value_str;
+
+		virtual obs::Property::Type type() override
+		{
+			return obs::Property::Type::List;
+		}
+
+		virtual size_t size() override
+		{
+			size_t total = Property::size();
+			total += sizeof(uint8_t);
+			total += sizeof(uint8_t);
+			total += sizeof(size_t);
+			for (auto& entry : items) {
+				total += sizeof(size_t);
+				total += entry.name.size();
+				total += sizeof(uint8_t);
+				total += sizeof(size_t);
+				total += entry.value_string.size();
+			}
+			total += sizeof(size_t) + current_value_str.size();
+			return total;
+		}
+
+		virtual bool serialize(std::vector<char>& buf) override
+		{
+			if (buf.size() < size() || !Property::serialize(buf)) {
+				return false;
+			}
+
+			size_t offset = Property::size();
+			buf[offset]   = field_type;
+			offset += sizeof(uint8_t);
+			buf[offset] = uint8_t(obs::ListProperty::Format::String);
+			offset += sizeof(uint8_t);
+
+			reinterpret_cast<size_t&>(buf[offset]) = items.size();
+			offset += sizeof(size_t);
+			for (auto& entry : items) {
+				reinterpret_cast<size_t&>(buf[offset]) = entry.name.size();
+				offset += sizeof(size_t);
+				std::memcpy(&buf[offset], entry.name.data(), entry.name.size());
+				offset += entry.name.size();
+				buf[offset] = entry.enabled;
+				offset += sizeof(uint8_t);
+				reinterpret_cast<size_t&>(buf[offset]) = entry.value_string.size();
+				offset += sizeof(size_t);
+				std::memcpy(&buf[offset], entry.value_string.data(), entry.value_string.size());
+				offset += entry.value_string.size();
+			}
+
+			reinterpret_cast<size_t&>(buf[offset]) = current_value_str.size();
+			offset += sizeof(size_t);
+			std::memcpy(&buf[offset], current_value_str.data(), current_value_str.size());
+			return true;
+		}
+
+		virtual bool read(std::vector<char> const& buf) override
+		{
+			// size() depends on the items, which are not read yet.
+			if (!Property::read(buf)) {
+				return false;
+			}
+
+			size_t offset = Property::size();
+			field_type    = buf[offset];
+			offset += 2 * sizeof(uint8_t);
+
+			size_t count = reinterpret_cast<const size_t&>(buf[offset]);
+			offset += sizeof(size_t);
+			for (size_t idx = 0; idx < count; idx++) {
+				Item   entry;
+				size_t length = reinterpret_cast<const size_t&>(buf[offset]);
+				offset += sizeof(size_t);
+				entry.name = std::string(&buf[offset], length);
+				offset += length;
+				entry.enabled = !!buf[offset];
+				offset += sizeof(uint8_t);
+				length = reinterpret_cast<const size_t&>(buf[offset]);
+				offset += sizeof(size_t);
+				entry.value_string = std::string(&buf[offset], length);
+				offset += length;
+				items.push_back(entry);
+			}
+
+			size_t length = reinterpret_cast<const size_t&>(buf[offset]);
+			offset += sizeof(size_t);
+			current_value_str = std::string(&buf[offset], length);
+			return true;
+		}
+	};
+
+	std::shared_ptr<Property> Property::deserialize(std::vector<char> const& buf)
+	{
+		std::shared_ptr<Property> prop;
+		switch (obs::Property::Type(buf[0])) {
+		case obs::Property::Type::Boolean:
+			prop = std::make_shared<BooleanProperty>();
+			break;
+		case obs::Property::Type::Integer:
+			prop = std::make_shared<IntegerProperty>();
+			break;
+		case obs::Property::Type::Float:
+			prop = std::make_shared<FloatProperty>();
+			break;
+		case obs::Property::Type::Text:
+			prop = std::make_shared<TextProperty>();
+			break;
+		case obs::Property::Type::List:
+			prop = std::make_shared<ListProperty>();
+			break;
+		default:
+			return nullptr;
+		}
+		if (!prop->read(buf)) {
+			return nullptr;
+		}
+		return prop;
+	}
+} // namespace legacy
+
+static void fill_common(size_t idx, std::string& name, std::string& description, std::string& long_description)
+{
+	name             = "property_" + std::to_string(idx);
+	description      = "Description of property " + std::to_string(idx);
+	long_description = "A longer description of what property " + std::to_string(idx) + " changes";
+}
+
+static void build(
+    size_t                                          count,
+    std::vector<std::shared_ptr<obs::Property>>&    current,
+    std::vector<std::shared_ptr<legacy::Property>>& previous)
+{
+	for (size_t idx = 0; idx < count; idx++) {
+		std::shared_ptr<obs::Property>    prop;
+		std::shared_ptr<legacy::Property> old;
+
+		switch (idx % 5) {
+		case 0: {
+			auto p = std::make_shared<obs::BooleanProperty>();
+			auto o = std::make_shared<legacy::BooleanProperty>();
+			p->value = o->value = (idx & 1) != 0;
+			prop = p, old = o;
+			break;
+		}
+		case 1: {
+			auto p        = std::make_shared<obs::IntegerProperty>();
+			auto o        = std::make_shared<legacy::IntegerProperty>();
+			p->field_type = obs::NumberProperty::NumberType::Slider;
+			o->field_type = uint8_t(p->field_type);
+			p->minimum = o->minimum = 0;
+			p->maximum = o->maximum = 100;
+			p->step = o->step = 1;
+			p->value = o->value = int64_t(idx);
+			prop = p, old = o;
+			break;
+		}
+		case 2: {
+			auto p        = std::make_shared<obs::FloatProperty>();
+			auto o        = std::make_shared<legacy::FloatProperty>();
+			p->field_type = obs::NumberProperty::NumberType::Scroller;
+			o->field_type = uint8_t(p->field_type);
+			p->minimum = o->minimum = 0.0;
+			p->maximum = o->maximum = 1.0;
+			p->step = o->step = 0.01;
+			p->value = o->value = 0.5;
+			prop = p, old = o;
+			break;
+		}
+		case 3: {
+			auto p        = std::make_shared<obs::TextProperty>();
+			auto o        = std::make_shared<legacy::TextProperty>();
+			p->field_type = obs::TextProperty::TextType::Default;
+			o->field_type = uint8_t(p->field_type);
+			p->value = o->value = "Text value of property " + std::to_string(idx);
+			prop = p, old = o;
+			break;
+		}
+		case 4: {
+			auto p        = std::make_shared<obs::ListProperty>();
+			auto o        = std::make_shared<legacy::ListProperty>();
+			p->field_type = obs::ListProperty::ListType::List;
+			p->format     = obs::ListProperty::Format::String;
+			o->field_type = uint8_t(p->field_type);
+			for (size_t item = 0; item < 8; item++) {
+				obs::ListProperty::Item    entry;
+				legacy::ListProperty::Item old_entry;
+				entry.name = old_entry.name = "Device " + std::to_string(item);
+				entry.enabled = old_entry.enabled = true;
+				entry.value_int                   = 0;
+				entry.value_float                 = 0;
+				entry.value_string = old_entry.value_string = "device_id_" + std::to_string(item);
+				p->items.push_back(entry);
+				o->items.push_back(old_entry);
+			}
+			p->current_value_int   = 0;
+			p->current_value_float = 0;
+			p->current_value_str = o->current_value_str = "device_id_0";
+			prop = p, old = o;
+			break;
+		}
+		}
+
+		fill_common(idx, prop->name, prop->description, prop->long_description);
+		fill_common(idx, old->name, old->description, old->long_description);
+		prop->enabled = old->enabled = true;
+		prop->visible = old->visible = true;
+		current.push_back(prop);
+		previous.push_back(old);
+	}
+}
+
+// Server: one buffer per property. IPC: one binary value per buffer.
+//  Client: obs::Property first, then copied into the client property.
+static size_t round_trip_legacy(std::vector<std::shared_ptr<legacy::Property>>& props)
+{
+	std::vector<std::vector<char>> rval;
+	for (auto& prop : props) {
+		std::vector<char> buf(prop->size());
+		if (prop->serialize(buf)) {
+			rval.push_back(buf);
+		}
+	}
+
+	std::vector<std::vector<char>> reply(rval);
+
+	std::vector<std::shared_ptr<Decoded>> out;
+	for (auto& blob : reply) {
+		auto raw = legacy::Property::deserialize(blob);
+		if (!raw)
+			continue;
+
+		auto pr              = std::make_shared<Decoded>();
+		pr->type             = uint8_t(raw->type());
+		pr->name             = raw->name;
+		pr->description      = raw->description;
+		pr->long_description = raw->long_description;
+		pr->enabled          = raw->enabled;
+		pr->visible          = raw->visible;
+		switch (raw->type()) {
+		case obs::Property::Type::Boolean:
+			pr->int_value[3] = std::static_pointer_cast<legacy::BooleanProperty>(raw)->value;
+			break;
+		case obs::Property::Type::Integer: {
+			auto cast         = std::static_pointer_cast<legacy::IntegerProperty>(raw);
+			pr->int_value[0]  = cast->minimum;
+			pr->int_value[1]  = cast->maximum;
+			pr->int_value[2]  = cast->step;
+			pr->int_value[3]  = cast->value;
+			break;
+		}
+		case obs::Property::Type::Float: {
+			auto cast          = std::static_pointer_cast<legacy::FloatProperty>(raw);
+			pr->float_value[0] = cast->minimum;
+			pr->float_value[1] = cast->maximum;
+			pr->float_value[2] = cast->step;
+			pr->float_value[3] = cast->value;
+			break;
+		}
+		case obs::Property::Type::Text:
+			pr->text = std::static_pointer_cast<legacy::TextProperty>(raw)->value;
+			break;
+		case obs::Property::Type::List: {
+			auto cast = std::static_pointer_cast<legacy::ListProperty>(raw);
+			for (auto& item : cast->items)
+				pr->items.push_back({item.name, !item.enabled, item.value_string});
+			pr->text = cast->current_value_str;
+			break;
+		}
+		default:
+			break;
+		}
+		out.push_back(pr);
+	}
+	return out.size();
+}
+
+// Server: one arena. IPC: one binary value. Client: read in place.
+static size_t round_trip_arena(std::vector<std::shared_ptr<obs::Property>>& props)
+{
+	std::vector<char>   arena;
+	obs::PropertyWriter w(arena);
+	for (auto& prop : props) {
+		prop->serialize(w);
+	}
+
+	std::vector<char> reply(arena);
+
+	std::vector<std::shared_ptr<Decoded>> out;
+	obs::PropertyReader                   reader(reply);
+	uint32_t                              count = 0;
+	reader.read(count);
+	for (uint32_t n = 0; n < count; n++) {
+		obs::PropertyReader record;
+		if (!reader.read(record))
+			break;
+
+		uint8_t         type = 0, enabled = 0, visible = 0, field_type = 0;
+		obs::string_ref name, description, long_description, value;
+		record.read(type);
+		record.read(name);
+		record.read(description);
+		record.read(long_description);
+		record.read(enabled);
+		if (!record.read(visible))
+			continue;
+
+		auto pr     = std::make_shared<Decoded>();
+		pr->type    = type;
+		pr->enabled = !!enabled;
+		pr->visible = !!visible;
+		name.assign_to(pr->name);
+		description.assign_to(pr->description);
+		long_description.assign_to(pr->long_description);
+		switch (obs::Property::Type(type)) {
+		case obs::Property::Type::Boolean: {
+			uint8_t v = 0;
+			record.read(v);
+			pr->int_value[3] = v;
+			break;
+		}
+		case obs::Property::Type::Integer:
+			record.read(field_type);
+			for (size_t idx = 0; idx < 4; idx++)
+				record.read(pr->int_value[idx]);
+			break;
+		case obs::Property::Type::Float:
+			record.read(field_type);
+			for (size_t idx = 0; idx < 4; idx++)
+				record.read(pr->float_value[idx]);
+			break;
+		case obs::Property::Type::Text:
+			record.read(field_type);
+			record.read(value);
+			value.assign_to(pr->text);
+			break;
+		case obs::Property::Type::List: {
+			uint8_t  format = 0, item_enabled = 0;
+			uint32_t items  = 0;
+			record.read(field_type);
+			record.read(format);
+			record.read(items);
+			for (uint32_t idx = 0; idx < items; idx++) {
+				Decoded::Item   item;
+				obs::string_ref item_name;
+				record.read(item_name);
+				record.read(item_enabled);
+				record.read(value);
+				item_name.assign_to(item.name);
+				item.disabled = !item_enabled;
+				value.assign_to(item.value);
+				pr->items.push_back(std::move(item));
+			}
+			record.read(value);
+			value.assign_to(pr->text);
+			break;
+		}
+		default:
+			break;
+		}
+		out.push_back(pr);
+	}
+	return out.size();
+}
+
+template<typename Fn>
+static double measure(Fn fn, size_t iterations, size_t properties)
+{
+	size_t decoded = 0;
+	auto   start   = std::chrono::steady_clock::now();
+	for (size_t n = 0; n < iterations; n++) {
+		decoded += fn();
+	}
+	auto elapsed = std::chrono::steady_clock::now() - start;
+
+	if (decoded != iterations * properties)
+		std::fprintf(stderr, "decoded %zu of %zu properties\n", decoded, iterations * properties);
+
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / double(iterations);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t properties = argc > 1 ? size_t(std::strtoull(argv[1], nullptr, 10)) : 500;
+	size_t iterations = argc > 2 ? size_t(std::strtoull(argv[2], nullptr, 10)) : 2000;
+	if (properties == 0 || iterations == 0) {
+		std::fprintf(stderr, "usage: obs-bench-property-arena [properties] [iterations]\n");
+		return 1;
+	}
+
+	std::vector<std::shared_ptr<obs::Property>>    current;
+	std::vector<std::shared_ptr<legacy::Property>> previous;
+	build(properties, current, previous);
+
+	double legacy_ns = measure([&previous]() { return round_trip_legacy(previous); }, iterations, properties);
+	double arena_ns  = measure([&current]() { return round_trip_arena(current); }, iterations, properties);
+
+	std::printf("%zu properties, %zu iterations\n", properties, iterations);
+	std::printf(
+	    "per property buffers %.1f us/fetch (%.0f ns/property)\n", legacy_ns / 1e3, legacy_ns / double(properties));
+	std::printf("arena                %.1f us/fetch (%.0f ns/property)\n", arena_ns / 1e3, arena_ns / double(properties));
+
+	return 0;
+}
@@ -0,0 +1,163 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Measures the volmeter frame snapshot (sequence lock) against the mutex
+//  that guarded the frame before, with one writer and many readers.
+//
+// obs-bench-volmeter-snapshot [readers] [milliseconds]
+//
+// The writer plays the libobs audio thread and stores frames back to back.
+//  Readers play IPC threads polling the frame. Reported are the writer's
+//  mean and worst store time, which is what the audio thread pays, and the
+//  number of frames the readers got. Defaults to 8 readers for 2000 ms.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "volmeter-snapshot.hpp"
+
+// MAX_AUDIO_CHANNELS of libobs
+static const size_t Channels = 8;
+
+typedef volmeter::audio_data<Channels> AudioData;
+
+// Frame guarded the way osn::VolMeter did before the sequence lock.
+class mutex_snapshot
+{
+	mutable std::mutex mtx;
+	AudioData          data;
+
+	public:
+	void store(const AudioData& value)
+	{
+		std::unique_lock<std::mutex> ulock(mtx);
+		data = value;
+	}
+
+	void load(AudioData& value) const
+	{
+		std::unique_lock<std::mutex> ulock(mtx);
+		value = data;
+	}
+};
+
+struct Result
+{
+	double   store_mean_ns;
+	double   store_max_ns;
+	uint64_t stores;
+	uint64_t loads;
+	bool     torn;
+};
+
+template<typename Snapshot>
+static Result measure(size_t readers, std::chrono::milliseconds duration)
+{
+	Snapshot                 snapshot;
+	std::atomic<bool>        running(true);
+	std::atomic<uint64_t>    loads(0);
+	std::atomic<bool>        torn(false);
+	std::vector<std::thread> workers;
+
+	for (size_t idx = 0; idx < readers; idx++) {
+		workers.emplace_back([&]() {
+			AudioData frame;
+			uint64_t  count = 0;
+			while (running.load(std::memory_order_relaxed)) {
+				snapshot.load(frame);
+				count++;
+
+				// Every field of a frame is written with the same value, so
+				//  a mix of two frames shows up as differing fields.
+				for (size_t ch = 0; ch < Channels; ch++) {
+					if (frame.magnitude[ch] != float(frame.ch) || frame.peak[ch] != float(frame.ch)
+					    || frame.input_peak[ch] != float(frame.ch))
+						torn.store(true, std::memory_order_relaxed);
+				}
+			}
+			loads.fetch_add(count);
+		});
+	}
+
+	AudioData frame;
+	uint64_t  stores   = 0;
+	int64_t   total_ns = 0;
+	int64_t   max_ns   = 0;
+	auto      end      = std::chrono::steady_clock::now() + duration;
+	while (std::chrono::steady_clock::now() < end) {
+		// Wraps well below 2^24, so every value is exact as a float.
+		frame.ch = int32_t(stores & 0xFFFF);
+		for (size_t ch = 0; ch < Channels; ch++) {
+			frame.magnitude[ch]  = float(frame.ch);
+			frame.peak[ch]       = float(frame.ch);
+			frame.input_peak[ch] = float(frame.ch);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		snapshot.store(frame);
+		int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+		                 .count();
+
+		total_ns += ns;
+		max_ns = std::max(max_ns, ns);
+		stores++;
+	}
+
+	running = false;
+	for (auto& worker : workers)
+		worker.join();
+
+	return {double(total_ns) / double(stores), double(max_ns), stores, loads.load(), torn.load()};
+}
+
+static void print(const char* name, const Result& result)
+{
+	std::printf(
+	    "%-10s store %.1f ns mean, %.0f ns worst, %llu stores, %llu loads%s\n",
+	    name,
+	    result.store_mean_ns,
+	    result.store_max_ns,
+	    (unsigned long long)result.stores,
+	    (unsigned long long)result.loads,
+	    result.torn ? ", TORN FRAMES" : "");
+}
+
+int main(int argc, char* argv[])
+{
+	size_t readers  = argc > 1 ? size_t(std::strtoull(argv[1], nullptr, 10)) : 8;
+	long   duration = argc > 2 ? std::strtol(argv[2], nullptr, 10) : 2000;
+	if (readers == 0 || duration <= 0) {
+		std::fprintf(stderr, "usage: obs-bench-volmeter-snapshot [readers] [milliseconds]\n");
+		return 1;
+	}
+
+	std::printf("%zu readers, %ld ms per run\n", readers, duration);
+
+	Result seqlock = measure<volmeter::snapshot<Channels>>(readers, std::chrono::milliseconds(duration));
+	print("seqlock", seqlock);
+	Result mutex = measure<mutex_snapshot>(readers, std::chrono::milliseconds(duration));
+	print("mutex", mutex);
+
+	return seqlock.torn || mutex.torn ? 1 : 0;
+}
@@ -0,0 +1,322 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Converts structured logs written with OSN_LOG_FORMAT=binary to text or
+//  JSON lines.
+//
+// obs-log-reader [--json] [--level error|warning|info|debug]
+//                [--from <time>] [--to <time>] <file>...
+//
+// Times are seconds since the Unix epoch or local "YYYY-MM-DD HH:MM:SS".
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include "util-binarylog.h"
+
+// Log levels of libobs (util/base.h)
+enum
+{
+	LevelError   = 100,
+	LevelWarning = 200,
+	LevelInfo    = 300,
+	LevelDebug   = 400
+};
+
+struct Filter
+{
+	int      level = LevelDebug;
+	uint64_t from  = 0;
+	uint64_t to    = UINT64_MAX;
+	bool     json  = false;
+};
+
+struct Record
+{
+	uint64_t    time;
+	int32_t     level;
+	uint32_t    thread;
+	const char* tag;
+	size_t      tagLength;
+	const char* text;
+	size_t      length;
+};
+
+static uint16_t get_u16(const char* in)
+{
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+	return uint16_t(bytes[0] | (bytes[1] << 8));
+}
+
+static uint32_t get_u32(const char* in)
+{
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+	uint32_t             value = 0;
+	for (size_t idx = 0; idx < 4; idx++)
+		value |= uint32_t(bytes[idx]) << (idx * 8);
+	return value;
+}
+
+static uint64_t get_u64(const char* in)
+{
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+	uint64_t             value = 0;
+	for (size_t idx = 0; idx < 8; idx++)
+		value |= uint64_t(bytes[idx]) << (idx * 8);
+	return value;
+}
+
+static const char* level_name(int level)
+{
+	if (level <= LevelError)
+		return "Error";
+	if (level <= LevelWarning)
+		return "Warning";
+	if (level <= LevelInfo)
+		return "Info";
+	return "Debug";
+}
+
+static bool parse_level(const char* name, int& level)
+{
+	if (strcmp(name, "error") == 0)
+		level = LevelError;
+	else if (strcmp(name, "warning") == 0)
+		level = LevelWarning;
+	else if (strcmp(name, "info") == 0)
+		level = LevelInfo;
+	else if (strcmp(name, "debug") == 0)
+		level = LevelDebug;
+	else
+		return false;
+	return true;
+}
+
+// Returns nanoseconds since the Unix epoch.
+static bool parse_time(const char* text, uint64_t& time)
+{
+	struct tm parts = {};
+	if (sscanf(
+	        text,
+	        "%d-%d-%d %d:%d:%d",
+	        &parts.tm_year,
+	        &parts.tm_mon,
+	        &parts.tm_mday,
+	        &parts.tm_hour,
+	        &parts.tm_min,
+	        &parts.tm_sec)
+	    == 6) {
+		parts.tm_year -= 1900;
+		parts.tm_mon -= 1;
+		parts.tm_isdst = -1;
+		time_t seconds = mktime(&parts);
+		if (seconds == time_t(-1))
+			return false;
+		time = uint64_t(seconds) * 1000000000ull;
+		return true;
+	}
+
+	char*              end;
+	unsigned long long seconds = strtoull(text, &end, 10);
+	if (end == text || *end != '\0')
+		return false;
+	time = uint64_t(seconds) * 1000000000ull;
+	return true;
+}
+
+static void write_json_string(const char* text, size_t length)
+{
+	putchar('"');
+	for (size_t idx = 0; idx < length; idx++) {
+		unsigned char c = static_cast<unsigned char>(text[idx]);
+		switch (c) {
+		case '"':
+			fputs("\\\"", stdout);
+			break;
+		case '\\':
+			fputs("\\\\", stdout);
+			break;
+		case '\n':
+			fputs("\\n", stdout);
+			break;
+		case '\r':
+			fputs("\\r", stdout);
+			break;
+		case '\t':
+			fputs("\\t", stdout);
+			break;
+		default:
+			if (c < 0x20)
+				printf("\\u%04x", c);
+			else
+				putchar(c);
+		}
+	}
+	putchar('"');
+}
+
+static void write_record(const Record& record, const Filter& filter)
+{
+	if (filter.json) {
+		printf(
+		    "{\"time\":%llu,\"level\":\"%s\",\"thread\":%u,\"tag\":",
+		    static_cast<unsigned long long>(record.time),
+		    level_name(record.level),
+		    record.thread);
+		write_json_string(record.tag, record.tagLength);
+		fputs(",\"message\":", stdout);
+		write_json_string(record.text, record.length);
+		fputs("}\n", stdout);
+		return;
+	}
+
+	time_t    seconds = time_t(record.time / 1000000000ull);
+	struct tm parts   = {};
+#ifdef _WIN32
+	localtime_s(&parts, &seconds);
+#else
+	localtime_r(&seconds, &parts);
+#endif
+	char stamp[32];
+	strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &parts);
+
+	printf(
+	    "%s.%03d [%s][%u] %.*s\n",
+	    stamp,
+	    int(record.time / 1000000ull % 1000),
+	    level_name(record.level),
+	    record.thread,
+	    int(record.length),
+	    record.text);
+}
+
+static bool read_file(const char* path, std::vector<char>& data)
+{
+	FILE* file = fopen(path, "rb");
+	if (!file)
+		return false;
+
+	char   chunk[65536];
+	size_t read;
+	while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+		data.insert(data.end(), chunk, chunk + read);
+
+	bool failed = ferror(file) != 0;
+	fclose(file);
+	return !failed;
+}
+
+static bool convert(const char* path, const Filter& filter)
+{
+	std::vector<char> data;
+	if (!read_file(path, data)) {
+		fprintf(stderr, "%s: could not be read.\n", path);
+		return false;
+	}
+
+	if (data.size() < util::binarylog::HeaderSize
+	    || memcmp(data.data(), util::binarylog::Magic, sizeof(util::binarylog::Magic)) != 0) {
+		fprintf(stderr, "%s: not a structured log.\n", path);
+		return false;
+	}
+	if (get_u32(data.data() + 8) != util::binarylog::Version) {
+		fprintf(stderr, "%s: unsupported version %u.\n", path, get_u32(data.data() + 8));
+		return false;
+	}
+
+	size_t offset = util::binarylog::HeaderSize;
+	while (offset + sizeof(uint32_t) <= data.size()) {
+		const char* in   = data.data() + offset;
+		size_t      size = get_u32(in);
+		if (size == 0)
+			break;
+
+		if (size < util::binarylog::RecordHeaderSize || size > data.size() - offset) {
+			fprintf(stderr, "%s: truncated record at offset %zu.\n", path, offset);
+			return false;
+		}
+
+		Record record;
+		record.time      = get_u64(in + 4);
+		record.level     = int32_t(get_u32(in + 12));
+		record.thread    = get_u32(in + 16);
+		record.tagLength = get_u16(in + 20);
+		if (record.tagLength > size - util::binarylog::RecordHeaderSize) {
+			fprintf(stderr, "%s: invalid record at offset %zu.\n", path, offset);
+			return false;
+		}
+		record.tag    = in + util::binarylog::RecordHeaderSize;
+		record.text   = record.tag + record.tagLength;
+		record.length = size - util::binarylog::RecordHeaderSize - record.tagLength;
+		offset += size;
+
+		if (record.level > filter.level || record.time < filter.from || record.time > filter.to)
+			continue;
+		write_record(record, filter);
+	}
+	return true;
+}
+
+static int usage()
+{
+	fputs(
+	    "usage: obs-log-reader [--json] [--level error|warning|info|debug] [--from <time>] [--to <time>] <file>...\n"
+	    "  <time> is seconds since the Unix epoch or local \"YYYY-MM-DD HH:MM:SS\".\n",
+	    stderr);
+	return 2;
+}
+
+int main(int argc, char* argv[])
+{
+	Filter                   filter;
+	std::vector<const char*> files;
+
+	for (int idx = 1; idx < argc; idx++) {
+		const char* arg = argv[idx];
+		if (strcmp(arg, "--json") == 0) {
+			filter.json = true;
+		} else if (strcmp(arg, "--level") == 0) {
+			if (++idx == argc || !parse_level(argv[idx], filter.level))
+				return usage();
+		} else if (strcmp(arg, "--from") == 0) {
+			if (++idx == argc || !parse_time(argv[idx], filter.from))
+				return usage();
+		} else if (strcmp(arg, "--to") == 0) {
+			if (++idx == argc || !parse_time(argv[idx], filter.to))
+				return usage();
+		} else if (arg[0] == '-') {
+			return usage();
+		} else {
+			files.push_back(arg);
+		}
+	}
+
+	if (files.empty())
+		return usage();
+
+	int result = 0;
+	for (const char* path : files) {
+		if (!convert(path, filter))
+			result = 1;
+	}
+	return result;
+}
@@ -19,84 +19,191 @@
 #include "callback-manager.h"
 #include <windows.h>
 #include "error.hpp"
+#include "event-frame.hpp"
+#include "osn-events.hpp"
 #include "shared.hpp"
 
-std::mutex                             mtx;
-std::map<std::string, SourceSizeInfo*> sources;
+#include "osn-source.hpp"
 
-void CallbackManager::Register(ipc::server& srv)
+std::mutex                                        mtx;
+std::unordered_map<obs_source_t*, SourceSizeInfo> sources;
+std::vector<obs_source_t*>                        dirty_sources;
+std::atomic<bool>                                 tick_registered(false);
+
+// Sources the tick checks, with the number of ticks left to check them.
+//  A source is only watched for a while after being created or after a
+//  signal hints that its size may have changed, and for as long as it plays
+//  async video, whose frames can change size at any time. Sync video such as
+//  window, game or monitor capture may also change size without a signal, so
+//  every source is still checked once per full scan.
+std::unordered_map<obs_source_t*, uint32_t> watched;
+uint32_t                                    base_width   = 0;
+uint32_t                                    base_height  = 0;
+uint32_t                                    full_scan_in = 0;
+
+// About five seconds at 60 fps, long enough for a device to reopen.
+static const uint32_t WatchTicks = 300;
+
+// About twice a second at 60 fps.
+static const uint32_t FullScanTicks = 30;
+
+// Signals after which a source may have a new size or output flags.
+static const char* watch_signals[] =
+    {"update", "activate", "deactivate", "show", "hide", "filter_add", "filter_remove", "reorder_filters"};
+
+void CallbackManager::WriteEvents(std::vector<char>& buf)
 {
-	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("CallbackManager");
+	std::unique_lock<std::mutex> ulock(mtx);
+	if (dirty_sources.empty())
+		return;
 
-	cls->register_function(std::make_shared<ipc::function>("QuerySourceSize", std::vector<ipc::type>{}, QuerySourceSize));
+	event_frame::writer frame(buf, event_frame::type::source_size);
+	frame.write(uint32_t(dirty_sources.size()));
+	for (obs_source_t* source : dirty_sources) {
+		SourceSizeInfo& si = sources[source];
+		si.dirty           = false;
+
+		frame.write(si.uid);
+		frame.write(std::string(obs_source_get_name(si.source)));
+		frame.write(si.width);
+		frame.write(si.height);
+		frame.write(si.flags);
+	}
+	dirty_sources.clear();
+}
 
-	srv.register_collection(cls);
+// libobs calls tick callbacks with its callback mutex held, so mtx must not be
+//  held while adding or removing the callback.
+void CallbackManager::initialize()
+{
+	if (!tick_registered.exchange(true))
+		obs_add_tick_callback(CallbackManager::tick, nullptr);
 }
 
-void CallbackManager::QuerySourceSize(
-    void*                          data,
-    const int64_t                  id,
-    const std::vector<ipc::value>& args,
-    std::vector<ipc::value>&       rval)
+void CallbackManager::finalize()
 {
-	std::unique_lock<std::mutex> ulock(mtx);
+	if (tick_registered.exchange(false))
+		obs_remove_tick_callback(CallbackManager::tick, nullptr);
+}
 
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	if (sources.empty()) {
-		return;
+// Moves the source into the dirty set if its size or output flags changed.
+//  Called with mtx held.
+static bool check_size(SourceSizeInfo& si)
+{
+	uint32_t newWidth  = obs_source_get_width(si.source);
+	uint32_t newHeight = obs_source_get_height(si.source);
+	uint32_t newFlags  = obs_source_get_output_flags(si.source);
+	if (si.width == newWidth && si.height == newHeight && si.flags == newFlags)
+		return false;
+
+	si.width  = newWidth;
+	si.height = newHeight;
+	si.flags  = newFlags;
+	if (!si.dirty) {
+		si.dirty = true;
+		dirty_sources.push_back(si.source);
 	}
+	return true;
+}
 
-	uint32_t size = 0;
+void CallbackManager::tick(void* param, float seconds)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
 
-	for (auto item : sources) {
-		SourceSizeInfo* si = item.second;
-		// See if width or height changed here
-		uint32_t newWidth  = obs_source_get_width(si->source);
-		uint32_t newHeight = obs_source_get_height(si->source);
-		uint32_t newFlags  = obs_source_get_output_flags(si->source);
+	// Scenes take the size of the canvas, any source may follow a video reset
+	obs_video_info ovi = {};
+	if (obs_get_video_info(&ovi) && (ovi.base_width != base_width || ovi.base_height != base_height)) {
+		base_width  = ovi.base_width;
+		base_height = ovi.base_height;
+		for (auto& item : sources)
+			watched[item.first] = WatchTicks;
+	}
 
-		if (si->width != newWidth || si->height != newHeight || si->flags != newFlags) {
-			si->width = newWidth;
-			si->height = newHeight;
-			si->flags  = newFlags;
+	bool changed = false;
+	for (auto iter = watched.begin(); iter != watched.end();) {
+		SourceSizeInfo& si = sources[iter->first];
+		changed |= check_size(si);
 
-			rval.push_back(ipc::value(obs_source_get_name(si->source)));
-			rval.push_back(ipc::value(si->width));
-			rval.push_back(ipc::value(si->height));
-			rval.push_back(ipc::value(si->flags));
+		if (!si.asyncActive && --iter->second == 0)
+			iter = watched.erase(iter);
+		else
+			++iter;
+	}
 
-			size++;
+	if (full_scan_in == 0) {
+		full_scan_in = FullScanTicks;
+		for (auto& item : sources) {
+			if (watched.find(item.first) == watched.end())
+				changed |= check_size(item.second);
 		}
 	}
+	full_scan_in--;
 
-	rval.insert(rval.begin() + 1, ipc::value(size));
-
-	AUTO_DEBUG;
+	ulock.unlock();
+	if (changed)
+		osn::Events::Notify();
 }
 
-void CallbackManager::addSource(obs_source_t* source)
+void CallbackManager::source_changed(void* param, calldata_t* cd)
 {
+	obs_source_t* source = nullptr;
+	if (!calldata_get_ptr(cd, "source", &source))
+		return;
+
 	std::unique_lock<std::mutex> ulock(mtx);
+	auto                         iter = sources.find(source);
+	if (iter == sources.end())
+		return;
 
+	// Only async video keeps a source watched for as long as it is active
+	uint32_t flags = obs_source_get_output_flags(source);
+	if (obs_source_active(source))
+		iter->second.asyncActive = (flags & OBS_SOURCE_ASYNC_VIDEO) == OBS_SOURCE_ASYNC_VIDEO;
+	else
+		iter->second.asyncActive = false;
+	watched[source] = WatchTicks;
+}
+
+// Signals are connected and disconnected without holding mtx: libobs holds
+//  the signal's own lock while calling source_changed, which takes mtx.
+void CallbackManager::addSource(obs_source_t* source)
+{
 	if (!source || obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER)
 		return;
 
-	SourceSizeInfo* si               = new SourceSizeInfo;
-	si->source                       = source;
-	si->width                        = obs_source_get_width(source);
-	si->height                       = obs_source_get_height(source);
+	// Everything starts out zeroed, so the first tick announces the source.
+	SourceSizeInfo si;
+	si.source = source;
+	si.uid    = osn::Source::Manager::GetInstance().find(source);
 
-	sources.emplace(std::make_pair(std::string(obs_source_get_name(source)), si));
+	{
+		std::unique_lock<std::mutex> ulock(mtx);
+		sources.insert_or_assign(source, si);
+		watched[source] = WatchTicks;
+	}
+
+	signal_handler_t* sh = obs_source_get_signal_handler(source);
+	for (const char* signal : watch_signals)
+		signal_handler_connect(sh, signal, CallbackManager::source_changed, nullptr);
 }
+
 void CallbackManager::removeSource(obs_source_t* source)
 {
+	if (!source || obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER)
+		return;
+
+	signal_handler_t* sh = obs_source_get_signal_handler(source);
+	for (const char* signal : watch_signals)
+		signal_handler_disconnect(sh, signal, CallbackManager::source_changed, nullptr);
+
 	std::unique_lock<std::mutex> ulock(mtx);
-	
-	if (!source)
+
+	auto iter = sources.find(source);
+	if (iter == sources.end())
 		return;
 
-	const char* name = obs_source_get_name(source);
-	
-	if (name)
-		sources.erase(name);
-}
\ No newline at end of file
+	if (iter->second.dirty)
+		dirty_sources.erase(std::find(dirty_sources.begin(), dirty_sources.end(), source));
+	watched.erase(source);
+	sources.erase(iter);
+}
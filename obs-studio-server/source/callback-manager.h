@@ -19,6 +19,8 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
 #include <ipc-server.hpp>
 #include <map>
@@ -27,6 +29,7 @@
 #include <queue>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <util/config-file.h>
 #include <util/dstr.h>
 #include <util/platform.h>
@@ -37,9 +40,12 @@
 struct SourceSizeInfo
 {
 	obs_source_t* source;
-	uint32_t      width = 0;
-	uint32_t      height = 0;
-	uint32_t      flags = 0;
+	uint64_t      uid         = UINT64_MAX;
+	uint32_t      width       = 0;
+	uint32_t      height      = 0;
+	uint32_t      flags       = 0;
+	bool          dirty       = false;
+	bool          asyncActive = false; // Watched for as long as this is set.
 };
 
 class CallbackManager
@@ -48,9 +54,19 @@ class CallbackManager
 	CallbackManager() {};
 	~CallbackManager() {};
 
-	static void Register(ipc::server&);
-	static void QuerySourceSize(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
-	
+	static void WriteEvents(std::vector<char>& buf);
+
+	static void initialize();
+	static void finalize();
+
 	static void addSource(obs_source_t* source);
 	static void removeSource(obs_source_t* source);
+
+	private:
+	// Runs on the graphics thread once per frame and moves watched sources
+	//  whose size or output flags changed into the dirty set. About
+	//  twice a second it also checks the sources that are not watched.
+	static void tick(void* param, float seconds);
+	// Starts watching the source of a signal that may change its size.
+	static void source_changed(void* param, calldata_t* cd);
 };
@@ -31,6 +31,7 @@
 #include "nodeobs_content.h"
 #include "nodeobs_service.h"
 #include "nodeobs_settings.h"
+#include "osn-events.hpp"
 #include "osn-fader.hpp"
 #include "osn-filter.hpp"
 #include "osn-global.hpp"
@@ -46,6 +47,7 @@
 #include "callback-manager.h"
 
 #include "util-crashmanager.h"
+#include "util-callstats.h"
 
 #if defined(_WIN32)
 #include "Shlobj.h"
@@ -125,6 +127,17 @@ namespace System
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 		return;
 	}
+
+	static void
+	    GetCallStats(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
+	{
+		std::vector<char> buf;
+		util::CallStats::Write(buf);
+
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+		rval.push_back(ipc::value(buf));
+		return;
+	}
 } // namespace System
 
 int main(int argc, char* argv[])
@@ -160,8 +173,10 @@ int main(int argc, char* argv[])
 	/// System
 	{
 		std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("System");
+		cls->register_function(std::make_shared<util::TimedFunction>(
+		    cls, "Shutdown", std::vector<ipc::type>{}, System::Shutdown, &doShutdown));
 		cls->register_function(
-		    std::make_shared<ipc::function>("Shutdown", std::vector<ipc::type>{}, System::Shutdown, &doShutdown));
+		    std::make_shared<util::TimedFunction>(cls, "GetCallStats", std::vector<ipc::type>{}, System::GetCallStats));
 		myServer.register_collection(cls);
 	};
 
@@ -178,7 +193,7 @@ int main(int argc, char* argv[])
 	osn::Properties::Register(myServer);
 	osn::Video::Register(myServer);
 	osn::Module::Register(myServer);
-	CallbackManager::Register(myServer);
+	osn::Events::Register(myServer);
 	OBS_API::Register(myServer);
 	OBS_content::Register(myServer);
 	OBS_service::Register(myServer);
@@ -17,9 +17,13 @@
 ******************************************************************************/
 
 #include "nodeobs_api.h"
+#include "nodeobs_settings.h"
 #include "osn-source.hpp"
 #include "osn-volmeter.hpp"
 #include "osn-fader.hpp"
+#include "util-binarylog.h"
+#include "util-callstats.h"
+#include "util-logsink.h"
 #include "util/lexer.h"
 
 #ifdef _WIN32
@@ -76,23 +80,31 @@ void OBS_API::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("API");
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
 	    "OBS_API_initAPI",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String},
 	    OBS_API_initAPI));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_API_destroyOBS_API", std::vector<ipc::type>{}, OBS_API_destroyOBS_API));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_API_getPerformanceStatistics", std::vector<ipc::type>{}, OBS_API_getPerformanceStatistics));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetWorkingDirectory", std::vector<ipc::type>{ipc::type::String}, SetWorkingDirectory));
 	cls->register_function(
-	    std::make_shared<ipc::function>("OBS_API_destroyOBS_API", std::vector<ipc::type>{}, OBS_API_destroyOBS_API));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_API_getPerformanceStatistics", std::vector<ipc::type>{}, OBS_API_getPerformanceStatistics));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetWorkingDirectory", std::vector<ipc::type>{ipc::type::String}, SetWorkingDirectory));
+	    std::make_shared<util::TimedFunction>(cls, "StopCrashHandler", std::vector<ipc::type>{}, StopCrashHandler));
 	cls->register_function(
-	    std::make_shared<ipc::function>("StopCrashHandler", std::vector<ipc::type>{}, StopCrashHandler));
-	cls->register_function(std::make_shared<ipc::function>("OBS_API_QueryHotkeys", std::vector<ipc::type>{}, QueryHotkeys));
-	cls->register_function(std::make_shared<ipc::function>(
+	    std::make_shared<util::TimedFunction>(cls, "OBS_API_QueryHotkeys", std::vector<ipc::type>{}, QueryHotkeys));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
 	    "OBS_API_ProcessHotkeyStatus",
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32},
 	    ProcessHotkeyStatus));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
+	    "OBS_API_getLogMessages",
+	    std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt64, ipc::type::UInt32},
+	    GetLogMessages));
 
 	srv.register_collection(cls);
 }
@@ -256,137 +268,219 @@ static void DeleteOldestFile(const char* location, unsigned maxLogs)
 #include <unistd.h>
 #endif
 
-inline std::string nodeobs_log_formatted_message(const char* format, va_list& args)
+static const char* log_level_name(int log_level)
 {
-	size_t            length  = _vscprintf(format, args);
-	std::vector<char> buf     = std::vector<char>(length + 1, '\0');
-	size_t            written = vsprintf_s(buf.data(), buf.size(), format, args);
-	return std::string(buf.begin(), buf.begin() + length);
-}
-
-std::chrono::high_resolution_clock             hrc;
-std::chrono::high_resolution_clock::time_point tp = std::chrono::high_resolution_clock::now();
-static void                                    node_obs_log(int log_level, const char* msg, va_list args, void* param)
-{
-	std::lock_guard<std::mutex> lock(logMutex);
-
-	if (param == nullptr)
-		return;
-
-	// Calculate log time.
-	auto timeSinceStart = (std::chrono::high_resolution_clock::now() - tp);
-	auto days           = std::chrono::duration_cast<std::chrono::duration<int, std::ratio<86400>>>(timeSinceStart);
-	timeSinceStart -= days;
-	auto hours = std::chrono::duration_cast<std::chrono::hours>(timeSinceStart);
-	timeSinceStart -= hours;
-	auto minutes = std::chrono::duration_cast<std::chrono::minutes>(timeSinceStart);
-	timeSinceStart -= minutes;
-	auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeSinceStart);
-	timeSinceStart -= seconds;
-	auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(timeSinceStart);
-	timeSinceStart -= milliseconds;
-	auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(timeSinceStart);
-	timeSinceStart -= microseconds;
-	auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(timeSinceStart);
-
-	// Generate timestamp and log_level part.
-	/// Convert level int to human readable name
-	std::string levelname = "";
 	switch (log_level) {
 	case LOG_INFO:
-		levelname = "Info";
-		break;
+		return "Info";
 	case LOG_WARNING:
-		levelname = "Warning";
-		break;
+		return "Warning";
 	case LOG_ERROR:
-		levelname = "Error";
-		break;
+		return "Error";
 	case LOG_DEBUG:
-		levelname = "Debug";
-		break;
+		return "Debug";
 	default:
 		if (log_level <= 50) {
-			levelname = "Critical";
+			return "Critical";
 		} else if (log_level > 50 && log_level < LOG_ERROR) {
-			levelname = "Error";
+			return "Error";
 		} else if (log_level > LOG_ERROR && log_level < LOG_WARNING) {
-			levelname = "Alert";
+			return "Alert";
 		} else if (log_level > LOG_WARNING && log_level < LOG_INFO) {
-			levelname = "Hint";
-		} else if (log_level > LOG_INFO) {
-			levelname = "Notice";
+			return "Hint";
+		} else {
+			return "Notice";
 		}
-		break;
 	}
+}
+
+std::chrono::high_resolution_clock::time_point tp = std::chrono::high_resolution_clock::now();
+std::chrono::system_clock::time_point          tpWall    = std::chrono::system_clock::now();
+std::fstream*                                  logStream = nullptr;
+util::BinaryLog                                binaryLog;
+
+static void write_log_line(std::string& out, std::string& err, int log_level, const std::string& line)
+{
+	out.append(line);
+	if (log_level <= LOG_WARNING)
+		err.append(line);
 
-	std::vector<char> timebuf(128, '\0');
-	std::string       timeformat = "[%.3d:%.2d:%.2d:%.2d.%.3d.%.3d.%.3d][%*s]"; // "%*s";
-	int               length     = sprintf_s(
-        timebuf.data(),
-        timebuf.size(),
-        timeformat.c_str(),
-        days.count(),
-        hours.count(),
-        minutes.count(),
-        seconds.count(),
-        milliseconds.count(),
-        microseconds.count(),
-        nanoseconds.count(),
-        levelname.length(),
-        levelname.c_str());
+	// Debugger
+#ifdef _WIN32
+	if (IsDebuggerPresent()) {
+		int wNum = MultiByteToWideChar(CP_UTF8, 0, line.c_str(), -1, NULL, 0);
+		if (wNum > 1) {
+			std::wstring wide_buf;
+			wide_buf.resize(wNum - 1);
+			MultiByteToWideChar(CP_UTF8, 0, line.c_str(), -1, &wide_buf[0], wNum);
+
+			OutputDebugStringW(wide_buf.c_str());
+		}
+	}
+#endif
+}
+
+static int format_time_and_level(
+    char*                                          buf,
+    size_t                                         size,
+    std::chrono::high_resolution_clock::time_point time,
+    int                                            log_level)
+{
+	// Calculate log time.
+	uint64_t ns = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(time - tp).count());
+
+	return snprintf(
+	    buf,
+	    size,
+	    "[%.3d:%.2d:%.2d:%.2d.%.3d.%.3d.%.3d][%s] ",
+	    int(ns / 86400000000000ull),
+	    int(ns / 3600000000000ull % 24),
+	    int(ns / 60000000000ull % 60),
+	    int(ns / 1000000000ull % 60),
+	    int(ns / 1000000ull % 1000),
+	    int(ns / 1000ull % 1000),
+	    int(ns % 1000),
+	    log_level_name(log_level));
+}
+
+// Nanoseconds since the Unix epoch, anchored to the wall clock at startup.
+static uint64_t log_time_ns(std::chrono::high_resolution_clock::time_point time)
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(tpWall.time_since_epoch()).count())
+	       + uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(time - tp).count());
+}
+
+// Module tag of messages such as "[obs-browser]: ..." or
+//  "[x264 encoder: 'streaming_h264'] ...".
+static size_t log_module_tag(const std::string& text, const char*& tag)
+{
+	tag = text.c_str();
+	if (text.empty() || text[0] != '[')
+		return 0;
+
+	size_t end = text.find_first_of("]:\n", 1);
+	if (end == std::string::npos || end - 1 > util::binarylog::MaximumTagLength)
+		return 0;
+
+	tag = text.c_str() + 1;
+	return end - 1;
+}
+
+static bool write_log_record(const util::LogMessage& message)
+{
+	const char* tag;
+	size_t      tagLength = log_module_tag(message.text, tag);
+	return binaryLog.write(
+	    log_time_ns(message.time),
+	    message.level,
+	    message.thread,
+	    tag,
+	    tagLength,
+	    message.text.data(),
+	    message.text.size());
+}
+
+// Formats a warning of the log itself into the console output and the report.
+static void write_log_notice(std::string& out, std::string& err, const std::string& text)
+{
+	char time_and_level[128];
+	int  length = format_time_and_level(
+	    time_and_level, sizeof(time_and_level), std::chrono::high_resolution_clock::now(), LOG_WARNING);
 	if (length < 0)
 		return;
 
-	std::string time_and_level = std::string(timebuf.data(), length);
-
-	// Format incoming text
-	std::string text = nodeobs_log_formatted_message(msg, args);
+	std::string line(time_and_level, length);
+	line.append(text);
+	line.push_back('\n');
+	logReport.push(line, LOG_WARNING);
+	write_log_line(out, err, LOG_WARNING, line);
+}
 
-	std::fstream* logStream = reinterpret_cast<std::fstream*>(param);
+// Runs on the log writer thread: formats a batch of messages and writes it
+//  with a single flush.
+static void write_log_batch(const util::LogMessage* messages, size_t count, uint64_t dropped)
+{
+	std::string out, err, line;
+	char        time_and_level[128];
+
+	std::unique_lock<std::mutex> lock(logMutex);
+	for (size_t n = 0; n < count; n++) {
+		const util::LogMessage& message = messages[n];
+
+		// A record that cannot be written ends the structured log, keeping
+		//  what it has. The console and the report still get every message.
+		if (binaryLog.isOpen() && !write_log_record(message)) {
+			binaryLog.close();
+			write_log_notice(out, err, "The binary log could not grow and was closed, later messages are not in it.");
+		}
 
-	// Split by \n (new-line)
-	size_t last_valid_idx = 0;
-	for (size_t idx = 0; idx <= text.length(); idx++) {
-		if ((idx == text.length()) || (text[idx] == '\n')) {
-			std::string newmsg = time_and_level + " " + std::string(&text[last_valid_idx], idx - last_valid_idx) + '\n';
-			last_valid_idx     = idx + 1;
+		int length = format_time_and_level(time_and_level, sizeof(time_and_level), message.time, message.level);
+		if (length < 0)
+			continue;
 
-			// File Log
-			*logStream << newmsg << std::flush;
+		// Split by \n (new-line)
+		const std::string& text           = message.text;
+		size_t             last_valid_idx = 0;
+		for (size_t idx = 0; idx <= text.length(); idx++) {
+			if ((idx == text.length()) || (text[idx] == '\n')) {
+				line.assign(time_and_level, length);
+				line.append(text, last_valid_idx, idx - last_valid_idx);
+				line.push_back('\n');
+				last_valid_idx = idx + 1;
 
-            // Internal Log
-			logReport.push(newmsg, log_level);
+				// Internal Log
+				logReport.push(line, message.level);
 
-			// Std Out / Std Err
-			/// Why fwrite and not std::cout and std::cerr?
-			/// Well, it seems that std::cout and std::cerr break if you click in the console window and paste.
-			/// Which is really bad, as nothing gets logged into the console anymore.
-			if (log_level <= LOG_WARNING) {
-				fwrite(newmsg.data(), sizeof(char), newmsg.length(), stderr);
+				write_log_line(out, err, message.level, line);
 			}
-			fwrite(newmsg.data(), sizeof(char), newmsg.length(), stdout);
+		}
+	}
 
-			// Debugger
-#ifdef _WIN32
-			if (IsDebuggerPresent()) {
-				int wNum = MultiByteToWideChar(CP_UTF8, 0, newmsg.c_str(), -1, NULL, 0);
-				if (wNum > 1) {
-					std::wstring wide_buf;
-					std::mutex   wide_mutex;
-
-					std::lock_guard<std::mutex> lock(wide_mutex);
-					wide_buf.reserve(wNum + 1);
-					wide_buf.resize(wNum - 1);
-					MultiByteToWideChar(CP_UTF8, 0, newmsg.c_str(), -1, &wide_buf[0], wNum);
-
-					OutputDebugStringW(wide_buf.c_str());
-				}
-			}
-#endif
+	if (dropped) {
+		util::LogMessage notice;
+		notice.time   = std::chrono::high_resolution_clock::now();
+		notice.level  = LOG_WARNING;
+		notice.thread = 0;
+		notice.text   = std::to_string(dropped) + " log messages were dropped, the log writer fell behind.";
+
+		if (binaryLog.isOpen())
+			write_log_record(notice);
+
+		int length = format_time_and_level(time_and_level, sizeof(time_and_level), notice.time, notice.level);
+		if (length >= 0) {
+			line.assign(time_and_level, length);
+			line.append(notice.text);
+			line.push_back('\n');
+			logReport.push(line, LOG_WARNING);
+			write_log_line(out, err, LOG_WARNING, line);
 		}
 	}
-	*logStream << std::flush;
+	lock.unlock();
+
+	// File Log, unless it is written as binary records
+	if (logStream && !binaryLog.isOpen()) {
+		logStream->write(out.data(), out.size());
+		logStream->flush();
+	}
+
+	// Std Out / Std Err
+	/// Why fwrite and not std::cout and std::cerr?
+	/// Well, it seems that std::cout and std::cerr break if you click in the console window and paste.
+	/// Which is really bad, as nothing gets logged into the console anymore.
+	if (!err.empty())
+		fwrite(err.data(), sizeof(char), err.length(), stderr);
+	fwrite(out.data(), sizeof(char), out.length(), stdout);
+}
+
+util::LogSink logSink(write_log_batch);
+
+// Called by libobs on whichever thread logs, so it only queues the message.
+static void node_obs_log(int log_level, const char* msg, va_list args, void* param)
+{
+	if (param == nullptr)
+		return;
+
+	logSink.push(log_level, msg, args);
 
 #if defined(_WIN32) && defined(OBS_DEBUGBREAK_ON_ERROR)
 	if (log_level <= LOG_ERROR && IsDebuggerPresent())
@@ -491,7 +585,12 @@ void OBS_API::OBS_API_initAPI(
 	obs_startup(locale.c_str(), userData.data(), NULL);
 
 	/* Logging */
-	std::string filename = GenerateTimeDateFilename("txt");
+	// OSN_LOG_FORMAT=binary writes structured records instead of text, read
+	//  them with obs-log-reader.
+	const char* logFormat = getenv("OSN_LOG_FORMAT");
+	bool        binary    = logFormat && strcmp(logFormat, "binary") == 0;
+
+	std::string filename = GenerateTimeDateFilename(binary ? "osnlog" : "txt");
 	std::string log_path = appdata;
 	log_path.append("/node-obs/logs/");
 
@@ -505,19 +604,27 @@ void OBS_API::OBS_API_initAPI(
 	DeleteOldestFile(log_path.c_str(), 3);
 	log_path.append(filename);
 
+	std::fstream* logfile = nullptr;
+	if (binary) {
+		if (!binaryLog.open(log_path))
+			std::cerr << "Failed to open log file" << std::endl;
+	} else {
 #if defined(_WIN32) && defined(UNICODE)
-	std::fstream* logfile =
-	    new std::fstream(converter.from_bytes(log_path.c_str()).c_str(), std::ios_base::out | std::ios_base::trunc);
+		logfile = new std::fstream(
+		    converter.from_bytes(log_path.c_str()).c_str(), std::ios_base::out | std::ios_base::trunc);
 #else
-	fstream* logfile = new fstream(log_path, ios_base::out | ios_base::trunc);
+		logfile = new fstream(log_path, ios_base::out | ios_base::trunc);
 #endif
 
-	if (!logfile->is_open()) {
-		logfile = nullptr;
-		std::cerr << "Failed to open log file" << std::endl;
+		if (!logfile->is_open()) {
+			logfile = nullptr;
+			std::cerr << "Failed to open log file" << std::endl;
+		}
 	}
 
-	base_set_log_handler(node_obs_log, logfile);
+	logStream = logfile;
+	logSink.start();
+	base_set_log_handler(node_obs_log, binaryLog.isOpen() ? static_cast<void*>(&binaryLog) : logfile);
 
 	/* INJECT osn::Source::Manager */
 	// Alright, you're probably wondering: Why is osn code here?
@@ -566,6 +673,7 @@ void OBS_API::OBS_API_initAPI(
 	OBS_service::associateAudioAndVideoEncodersToTheCurrentRecordingOutput(false);
 
 	setAudioDeviceMonitoring();
+	OBS_settings::startDeviceNotifications();
 
 	// Enable the hotkey callback rerouting that will be used when manually handling hotkeys on the frontend
 	obs_hotkey_enable_callback_rerouting(true);
@@ -591,6 +699,7 @@ void OBS_API::OBS_API_destroyOBS_API(
 	//  osn::Source::Manager.
 	osn::Source::finalize_global_signals();
 	/* END INJECT osn::Source::Manager */
+	OBS_settings::stopDeviceNotifications();
 	destroyOBS_API();
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -744,6 +853,58 @@ void OBS_API::ProcessHotkeyStatus(
 	AUTO_DEBUG;
 }
 
+void OBS_API::GetLogMessages(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	uint32_t type     = args[0].value_union.ui32;
+	uint64_t after    = args[1].value_union.ui64;
+	uint32_t maxCount = args[2].value_union.ui32;
+
+	std::unique_lock<std::mutex> lock(logMutex);
+
+	const util::LogRing* ring;
+	switch (type) {
+	case LogReport::General:
+		ring = &logReport.general;
+		break;
+	case LogReport::Errors:
+		ring = &logReport.errors;
+		break;
+	case LogReport::Warnings:
+		ring = &logReport.warnings;
+		break;
+	default:
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Invalid log type."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	size_t first = ring->find(after);
+	size_t count = ring->size() - first;
+	if (count > maxCount)
+		count = maxCount;
+
+	// The client continues from the last sequence number it received, and
+	//  can tell from the evicted one whether it missed any entries.
+	uint64_t last = count ? ring->at(first + count - 1).sequence : after;
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(last));
+	rval.push_back(ipc::value((uint32_t)(ring->evicted() > after)));
+	for (size_t idx = first; idx < first + count; idx++) {
+		const util::LogRing::Entry& entry = ring->at(idx);
+		rval.push_back(ipc::value(entry.sequence));
+		rval.push_back(ipc::value((int32_t)entry.level));
+		rval.push_back(ipc::value(std::string(ring->text(entry), entry.length)));
+	}
+
+	AUTO_DEBUG;
+}
+
 void OBS_API::SetProcessPriority(const char* priority)
 {
 	if (!priority)
@@ -1060,6 +1221,15 @@ void OBS_API::destroyOBS_API(void)
 	if (totalLeaks) {
 		// throw "OBS has memory leaks";
 	}
+
+	// Anything logged from here on is written right away; once the binary
+	//  log is closed, only to the console. Late messages from other threads
+	//  write under logMutex, so the log is closed under it too.
+	logSink.stop();
+	{
+		std::unique_lock<std::mutex> lock(logMutex);
+		binaryLog.close();
+	}
 }
 
 struct ci_char_traits : public std::char_traits<char>
@@ -1204,6 +1374,8 @@ bool OBS_API::openAllModules(int& video_err)
 		os_closedir(plugin_dir);
 	}
 
+	osn::Source::InvalidateTypeInfo();
+	OBS_settings::invalidateCache();
 	return true;
 }
 
@@ -1287,22 +1459,27 @@ double OBS_API::getCurrentFrameRate(void)
 	return obs_get_active_fps();
 }
 
-const std::vector<std::string>& OBS_API::getOBSLogErrors()
+const util::LogRing& OBS_API::getOBSLogErrors()
 {
 	return logReport.errors;
 }
 
-const std::vector<std::string>& OBS_API::getOBSLogWarnings()
+const util::LogRing& OBS_API::getOBSLogWarnings()
 {
 	return logReport.warnings;
 }
 
-std::queue<std::string>& OBS_API::getOBSLogGeneral()
+const util::LogRing& OBS_API::getOBSLogGeneral()
 {
 	return logReport.general;
 }
 
-std::string OBS_API::getCurrentVersion()
+void OBS_API::flushLog()
+{
+	logSink.flush();
+}
+
+const std::string& OBS_API::getCurrentVersion()
 {
 	return currentVersion;
 }
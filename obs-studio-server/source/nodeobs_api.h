@@ -29,6 +29,7 @@
 #include <queue>
 #include "nodeobs_configManager.hpp"
 #include "nodeobs_service.h"
+#include "util-logring.h"
 
 extern std::string g_moduleDirectory;
 
@@ -50,27 +51,40 @@ class OBS_API
     public:
     struct LogReport
 	{
-		static const int MaximumGeneralMessages = 150;
+		static const size_t MaximumGeneralMessages = 150;
+		static const size_t MaximumMessages        = 1024;
 
-		void push(std::string message, int logLevel)
+		// Log selected by OBS_API_getLogMessages
+		enum Type
 		{
-			general.push(message);
-			if (general.size() >= MaximumGeneralMessages) {
-				general.pop();
-			}
+			General,
+			Errors,
+			Warnings
+		};
+
+		LogReport()
+		    : general(MaximumGeneralMessages, 64 * 1024), errors(MaximumMessages, 256 * 1024),
+		      warnings(MaximumMessages, 256 * 1024), sequence(0)
+		{}
+
+		void push(const std::string& message, int logLevel)
+		{
+			sequence++;
+			general.push(sequence, logLevel, message.data(), message.size());
 
 			if (logLevel == LOG_ERROR) {
-				errors.push_back(message);
+				errors.push(sequence, logLevel, message.data(), message.size());
 			}
 
 			if (logLevel == LOG_WARNING) {
-				warnings.push_back(message);
+				warnings.push(sequence, logLevel, message.data(), message.size());
 			}
 		}
 
-		std::vector<std::string> errors;
-		std::vector<std::string> warnings;
-		std::queue<std::string>  general;
+		util::LogRing general;
+		util::LogRing errors;
+		util::LogRing warnings;
+		uint64_t      sequence;
 	};
 
 	public:
@@ -111,6 +125,11 @@ class OBS_API
 	    const int64_t                  id,
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
+	static void GetLogMessages(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
 
 	protected:
 	static void initAPI(void);
@@ -122,11 +141,14 @@ class OBS_API
 	static double getCurrentBandwidth(void);
 	static double getCurrentFrameRate(void);
 
-    static const std::vector<std::string>& getOBSLogErrors();
-	static const std::vector<std::string>& getOBSLogWarnings();
-	static std::queue<std::string>&        getOBSLogGeneral();
+	static const util::LogRing& getOBSLogErrors();
+	static const util::LogRing& getOBSLogWarnings();
+	static const util::LogRing& getOBSLogGeneral();
+	// Writes the messages still queued for the log writer, so that a crash
+	//  report sees the last ones.
+	static void flushLog();
 
-	static std::string getCurrentVersion();
+	static const std::string& getCurrentVersion();
 
 	static std::vector<std::string> exploreDirectory(std::string directory, std::string typeToReturn);
 
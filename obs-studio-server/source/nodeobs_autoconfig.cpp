@@ -18,7 +18,11 @@
 
 #include "nodeobs_autoconfig.h"
 #include "error.hpp"
+#include "nodeobs_settings.h"
+#include "event-frame.hpp"
+#include "osn-events.hpp"
 #include "shared.hpp"
+#include "util-callstats.h"
 
 enum class Type
 {
@@ -87,6 +91,15 @@ class AutoConfigInfo
 std::mutex                 eventsMutex;
 std::queue<AutoConfigInfo> events;
 
+static void PushEvent(const AutoConfigInfo& info)
+{
+	{
+		std::unique_lock<std::mutex> ulock(eventsMutex);
+		events.push(info);
+	}
+	osn::Events::Notify();
+}
+
 Service     serviceSelected   = Service::Other;
 Quality     recordingQuality  = Quality::Stream;
 Encoder     recordingEncoder  = Encoder::Stream;
@@ -209,27 +222,29 @@ void autoConfig::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("AutoConfig");
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
 	    "InitializeAutoConfig",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String},
 	    autoConfig::InitializeAutoConfig));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartBandwidthTest", std::vector<ipc::type>{}, autoConfig::StartBandwidthTest));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartStreamEncoderTest", std::vector<ipc::type>{}, autoConfig::StartStreamEncoderTest));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartRecordingEncoderTest", std::vector<ipc::type>{}, autoConfig::StartRecordingEncoderTest));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartCheckSettings", std::vector<ipc::type>{}, autoConfig::StartCheckSettings));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartSetDefaultSettings", std::vector<ipc::type>{}, autoConfig::StartSetDefaultSettings));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartSaveStreamSettings", std::vector<ipc::type>{}, autoConfig::StartSaveStreamSettings));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "StartBandwidthTest", std::vector<ipc::type>{}, autoConfig::StartBandwidthTest));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "StartStreamEncoderTest", std::vector<ipc::type>{}, autoConfig::StartStreamEncoderTest));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "StartRecordingEncoderTest", std::vector<ipc::type>{}, autoConfig::StartRecordingEncoderTest));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "StartCheckSettings", std::vector<ipc::type>{}, autoConfig::StartCheckSettings));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "StartSetDefaultSettings", std::vector<ipc::type>{}, autoConfig::StartSetDefaultSettings));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "StartSaveStreamSettings", std::vector<ipc::type>{}, autoConfig::StartSaveStreamSettings));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "StartSaveSettings", std::vector<ipc::type>{}, autoConfig::StartSaveSettings));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "TerminateAutoConfig", std::vector<ipc::type>{}, autoConfig::TerminateAutoConfig));
 	cls->register_function(
-	    std::make_shared<ipc::function>("StartSaveSettings", std::vector<ipc::type>{}, autoConfig::StartSaveSettings));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "TerminateAutoConfig", std::vector<ipc::type>{}, autoConfig::TerminateAutoConfig));
-	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{}, autoConfig::Query));
+	    std::make_shared<util::TimedFunction>(cls, "Query", std::vector<ipc::type>{}, autoConfig::Query));
 
 	srv.register_collection(cls);
 }
@@ -390,6 +405,21 @@ void autoConfig::Query(void* data, const int64_t id, const std::vector<ipc::valu
 	AUTO_DEBUG;
 }
 
+void autoConfig::WriteEvents(std::vector<char>& buf)
+{
+	std::unique_lock<std::mutex> ulock(eventsMutex);
+	while (!events.empty()) {
+		AutoConfigInfo& info = events.front();
+
+		event_frame::writer frame(buf, event_frame::type::autoconfig);
+		frame.write(info.event);
+		frame.write(info.description);
+		frame.write(info.percentage);
+
+		events.pop();
+	}
+}
+
 void autoConfig::StopThread(void)
 {
 	std::unique_lock<std::mutex> ul(m);
@@ -570,16 +600,12 @@ int EvaluateBandwidth(
 }
 
 void sendErrorMessage(std::string message) {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("error", message.c_str(), 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("error", message.c_str(), 0));
 }
 
 void autoConfig::TestBandwidthThread(void)
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "bandwidth_test", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "bandwidth_test", 0));
 
 	bool connected = false;
 	bool stopped   = false;
@@ -778,9 +804,7 @@ void autoConfig::TestBandwidthThread(void)
 
 		if (EvaluateBandwidth(info, connected, stopped, success, service_settings, service, output, vencoder_settings)
 		    < 0) {
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("error", "invalid_stream_settings", 0));
-			eventsMutex.unlock();
+			PushEvent(AutoConfigInfo("error", "invalid_stream_settings", 0));
 			return;
 		}
 
@@ -788,24 +812,18 @@ void autoConfig::TestBandwidthThread(void)
 		bestServerName = info.name;
 		bestBitrate    = info.bitrate;
 
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("progress", "bandwidth_test", 100));
-		eventsMutex.unlock();
+		PushEvent(AutoConfigInfo("progress", "bandwidth_test", 100));
 
 	} else {
 		for (size_t i = 0; i < servers.size(); i++) {
 			EvaluateBandwidth(
 			    servers[i], connected, stopped, success, service_settings, service, output, vencoder_settings);
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("progress", "bandwidth_test", (double)(i + 1) * 100 / servers.size()));
-			eventsMutex.unlock();
+			PushEvent(AutoConfigInfo("progress", "bandwidth_test", (double)(i + 1) * 100 / servers.size()));
 		}
 	}
 
 	if (!success) {
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("error", "invalid_stream_settings", 0));
-		eventsMutex.unlock();
+		PushEvent(AutoConfigInfo("error", "invalid_stream_settings", 0));
 		return;
 	}
 
@@ -824,9 +842,7 @@ void autoConfig::TestBandwidthThread(void)
 	serverName   = bestServerName;
 	idealBitrate = bestBitrate;
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "bandwidth_test", 100));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("stopping_step", "bandwidth_test", 100));
 }
 
 /* this is used to estimate the lower bitrate limit for a given
@@ -1197,9 +1213,7 @@ bool autoConfig::TestSoftwareEncoding()
 
 void autoConfig::TestStreamEncoderThread()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "streamingEncoder_test", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "streamingEncoder_test", 0));
 
 	baseResolutionCX = config_get_int(ConfigManager::getInstance().getBasic(), "Video", "BaseCX");
 	baseResolutionCY = config_get_int(ConfigManager::getInstance().getBasic(), "Video", "BaseCY");
@@ -1228,16 +1242,12 @@ void autoConfig::TestStreamEncoderThread()
 		streamingEncoder = Encoder::x264;
 	}
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "streamingEncoder_test", 100));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("stopping_step", "streamingEncoder_test", 100));
 }
 
 void autoConfig::TestRecordingEncoderThread()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "recordingEncoder_test", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "recordingEncoder_test", 0));
 
 	TestHardwareEncoding();
 
@@ -1272,9 +1282,7 @@ void autoConfig::TestRecordingEncoderThread()
 		}
 	}
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "recordingEncoder_test", 100));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("stopping_step", "recordingEncoder_test", 100));
 }
 
 inline const char* GetEncoderId(Encoder enc)
@@ -1325,9 +1333,7 @@ bool autoConfig::CheckSettings(void)
 	OBSService service = obs_service_create("rtmp_common", "serviceTest", settings, NULL);
 
 	if (!service) {
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("error", "invalid_service", 100));
-		eventsMutex.unlock();
+		PushEvent(AutoConfigInfo("error", "invalid_service", 100));
 		return false;
 	}
 
@@ -1406,9 +1412,7 @@ bool autoConfig::CheckSettings(void)
 
 void autoConfig::SetDefaultSettings(void)
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "setting_default_settings", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "setting_default_settings", 0));
 
 	idealResolutionCX = 1280;
 	idealResolutionCY = 720;
@@ -1418,9 +1422,7 @@ void autoConfig::SetDefaultSettings(void)
 	streamingEncoder = Encoder::x264;
 	recordingEncoder = Encoder::Stream;
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "setting_default_settings", 100));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("stopping_step", "setting_default_settings", 100));
 }
 
 void autoConfig::SaveStreamSettings()
@@ -1428,9 +1430,7 @@ void autoConfig::SaveStreamSettings()
 	/* ---------------------------------- */
 	/* save service                       */
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "saving_service", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "saving_service", 0));
 
 	const char* service_id = "rtmp_common";
 
@@ -1462,17 +1462,14 @@ void autoConfig::SaveStreamSettings()
 	config_remove_value(ConfigManager::getInstance().getBasic(), "SimpleOutput", "UseAdvanced");
 
 	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+	OBS_settings::invalidateCache();
 	
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "saving_service", 100));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("stopping_step", "saving_service", 100));
 }
 
 void autoConfig::SaveSettings()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "saving_settings", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "saving_settings", 0));
 	
 	if (recordingEncoder != Encoder::Stream)
 		config_set_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecEncoder",
@@ -1494,9 +1491,8 @@ void autoConfig::SaveSettings()
 	}
 
 	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+	OBS_settings::invalidateCache();
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "saving_settings", 100));
-	events.push(AutoConfigInfo("done", "", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("stopping_step", "saving_settings", 100));
+	PushEvent(AutoConfigInfo("done", "", 0));
 }
@@ -77,6 +77,7 @@ namespace autoConfig
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
 	void Query(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+	void WriteEvents(std::vector<char>& buf);
 
 	void StopThread();
 	void FindIdealHardwareResolution();
@@ -21,7 +21,11 @@
 #include <filesystem>
 #include <windows.h>
 #include "error.hpp"
+#include "nodeobs_settings.h"
+#include "event-frame.hpp"
+#include "osn-events.hpp"
 #include "shared.hpp"
+#include "util-callstats.h"
 
 obs_output_t* streamingOutput    = nullptr;
 obs_output_t* recordingOutput    = nullptr;
@@ -52,6 +56,16 @@ bool        isRecording          = false;
 std::mutex             signalMutex;
 std::queue<SignalInfo> outputSignal;
 
+static void PushOutputSignal(SignalInfo signal)
+{
+	signal.setTimestamp(os_gettime_ns());
+	{
+		std::unique_lock<std::mutex> ulock(signalMutex);
+		outputSignal.push(signal);
+	}
+	osn::Events::Notify();
+}
+
 OBS_service::OBS_service() {}
 OBS_service::~OBS_service() {}
 
@@ -59,29 +73,28 @@ void OBS_service::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Service");
 
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_resetAudioContext", std::vector<ipc::type>{}, OBS_service_resetAudioContext));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_resetVideoContext", std::vector<ipc::type>{}, OBS_service_resetVideoContext));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_startStreaming", std::vector<ipc::type>{}, OBS_service_startStreaming));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_startRecording", std::vector<ipc::type>{}, OBS_service_startRecording));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_startReplayBuffer", std::vector<ipc::type>{}, OBS_service_startReplayBuffer));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_stopStreaming", std::vector<ipc::type>{ipc::type::Int32}, OBS_service_stopStreaming));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_stopRecording", std::vector<ipc::type>{}, OBS_service_stopRecording));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_stopReplayBuffer", std::vector<ipc::type>{ipc::type::Int32}, OBS_service_stopReplayBuffer));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_connectOutputSignals", std::vector<ipc::type>{}, OBS_service_connectOutputSignals));
-	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{}, Query));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_processReplayBufferHotkey", std::vector<ipc::type>{}, OBS_service_processReplayBufferHotkey));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_getLastReplay", std::vector<ipc::type>{}, OBS_service_getLastReplay));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_service_resetAudioContext", std::vector<ipc::type>{}, OBS_service_resetAudioContext));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_service_resetVideoContext", std::vector<ipc::type>{}, OBS_service_resetVideoContext));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_service_startStreaming", std::vector<ipc::type>{}, OBS_service_startStreaming));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_service_startRecording", std::vector<ipc::type>{}, OBS_service_startRecording));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_service_startReplayBuffer", std::vector<ipc::type>{}, OBS_service_startReplayBuffer));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_service_stopStreaming", std::vector<ipc::type>{ipc::type::Int32}, OBS_service_stopStreaming));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_service_stopRecording", std::vector<ipc::type>{}, OBS_service_stopRecording));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_service_stopReplayBuffer", std::vector<ipc::type>{ipc::type::Int32}, OBS_service_stopReplayBuffer));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_service_connectOutputSignals", std::vector<ipc::type>{}, OBS_service_connectOutputSignals));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_service_processReplayBufferHotkey", std::vector<ipc::type>{}, OBS_service_processReplayBufferHotkey));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_service_getLastReplay", std::vector<ipc::type>{}, OBS_service_getLastReplay));
 
 	srv.register_collection(cls);
 }
@@ -225,8 +238,10 @@ bool OBS_service::resetAudioContext(bool reload)
 {
 	struct obs_audio_info ai;
 
-	if (reload)
+	if (reload) {
 		ConfigManager::getInstance().reloadConfig();
+		OBS_settings::invalidateCache();
+	}
 
 	ai.samples_per_sec          = config_get_uint(ConfigManager::getInstance().getBasic(), "Audio", "SampleRate");
 	const char* channelSetupStr = config_get_string(ConfigManager::getInstance().getBasic(), "Audio", "ChannelSetup");
@@ -480,6 +495,7 @@ int OBS_service::resetVideoContext(bool reload)
 	ovi.scale_type = GetScaleType(ConfigManager::getInstance().getBasic());
 
 	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+	OBS_settings::invalidateCache();
 
 	try {
 		return obs_reset_video(&ovi);
@@ -942,8 +958,7 @@ bool OBS_service::startRecording(void)
 			std::cout << "Last recording error: " << error << std::endl;
 		}
 		signal.setCode(OBS_OUTPUT_ERROR);
-		std::unique_lock<std::mutex> ulock(signalMutex);
-		outputSignal.push(signal);
+		PushOutputSignal(signal);
 	}
 	return isRecording;
 }
@@ -1211,6 +1226,7 @@ void OBS_service::setService(obs_service_t* newService)
 {
 	obs_service_release(service);
 	service = newService;
+	OBS_settings::invalidateCache();
 }
 
 void OBS_service::saveService(void)
@@ -1336,6 +1352,7 @@ void OBS_service::updateVideoStreamingEncoder()
 		videoBitrate = 2500;
 		config_set_uint(ConfigManager::getInstance().getBasic(), "SimpleOutput", "VBitrate", videoBitrate);
 		config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+		OBS_settings::invalidateCache();
 	}
 
 	obs_data_set_string(h264Settings, "rate_control", "CBR");
@@ -1609,6 +1626,7 @@ static bool update_ffmpeg_output(config_t* config)
 void OBS_service::UpdateFFmpegOutput(void)
 {
 	update_ffmpeg_output(ConfigManager::getInstance().getBasic());
+	OBS_settings::invalidateCache();
 
 	if (recordingOutput != NULL) {
 		obs_output_release(recordingOutput);
@@ -2085,29 +2103,21 @@ void OBS_service::OBS_service_connectOutputSignals(
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 }
 
-void OBS_service::Query(
-    void*                          data,
-    const int64_t                  id,
-    const std::vector<ipc::value>& args,
-    std::vector<ipc::value>&       rval)
+void OBS_service::WriteEvents(std::vector<char>& buf)
 {
 	std::unique_lock<std::mutex> ulock(signalMutex);
-	if (outputSignal.empty()) {
-		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-		AUTO_DEBUG;
-		return;
-	}
+	while (!outputSignal.empty()) {
+		SignalInfo& signal = outputSignal.front();
 
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-
-	rval.push_back(ipc::value(outputSignal.front().getOutputType()));
-	rval.push_back(ipc::value(outputSignal.front().getSignal()));
-	rval.push_back(ipc::value(outputSignal.front().getCode()));
-	rval.push_back(ipc::value(outputSignal.front().getErrorMessage()));
-
-	outputSignal.pop();
+		event_frame::writer frame(buf, event_frame::type::output_signal);
+		frame.write(signal.getOutputType());
+		frame.write(signal.getSignal());
+		frame.write(int32_t(signal.getCode()));
+		frame.write(signal.getErrorMessage());
+		frame.write(signal.getTimestamp());
 
-	AUTO_DEBUG;
+		outputSignal.pop();
+	}
 }
 
 void OBS_service::JSCallbackOutputSignal(void* data, calldata_t* params)
@@ -2134,8 +2144,7 @@ void OBS_service::JSCallbackOutputSignal(void* data, calldata_t* params)
 		}
 	}
 
-	std::unique_lock<std::mutex> ulock(signalMutex);
-	outputSignal.push(signal);
+	PushOutputSignal(signal);
 }
 
 void OBS_service::connectOutputSignals(void)
@@ -66,6 +66,7 @@ class SignalInfo
 	std::string m_signal;
 	int         m_code;
 	std::string m_errorMessage;
+	uint64_t    m_timestamp = 0;
 
 	public:
 	SignalInfo(){};
@@ -101,6 +102,16 @@ class SignalInfo
 	{
 		m_errorMessage = errorMessage;
 	};
+
+	// os_gettime_ns() at the time the signal was queued.
+	uint64_t getTimestamp(void)
+	{
+		return m_timestamp;
+	};
+	void setTimestamp(uint64_t timestamp)
+	{
+		m_timestamp = timestamp;
+	};
 };
 
 class OBS_service
@@ -166,7 +177,7 @@ class OBS_service
 	    const int64_t                  id,
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
-	static void Query(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+	static void WriteEvents(std::vector<char>& buf);
 
 	private:
 	static bool startStreaming(void);
@@ -20,9 +20,15 @@
 #include "error.hpp"
 #include "nodeobs_api.h"
 #include "shared.hpp"
+#include "util-callstats.h"
 
+#include <map>
+#include <mutex>
 #include <windows.h>
 
+#include <mmdeviceapi.h>
+#include <util/windows/ComPtr.hpp>
+
 std::vector<const char*> tabStreamTypes;
 const char*              currentServiceName;
 std::vector<SubCategory> currentAudioSettings;
@@ -39,6 +45,111 @@ static std::string ResString(uint64_t cx, uint64_t cy)
 	return res.str();
 }
 
+struct CachedCategory
+{
+	uint32_t          activeOutputs;
+	std::string       displays;
+	CategoryTypes     type;
+	size_t            count;
+	std::vector<char> buffer;
+};
+
+static std::mutex                            cacheMutex;
+static std::map<std::string, CachedCategory> categoryCache;
+static uint64_t                              cacheGeneration = 0;
+
+// Categories are disabled while outputs run, so their state is part of what
+//  a cached category was built from.
+static uint32_t getActiveOutputs(void)
+{
+	return (OBS_service::isStreamingOutputActive() ? 1 : 0) | (OBS_service::isRecordingOutputActive() ? 2 : 0)
+	       | (OBS_service::isReplayBufferOutputActive() ? 4 : 0);
+}
+
+// The Video base resolutions list every display, which can be added, removed
+//  or resized without any notification reaching the server.
+static std::string getDisplays(const std::string& nameCategory)
+{
+	if (nameCategory.compare("Video") != 0)
+		return std::string();
+
+	std::string displays;
+	for (const Screen& screen : OBS_API::availableResolutions())
+		displays += ResString(screen.width, screen.height) + ";";
+	return displays;
+}
+
+class DeviceNotificationClient : public IMMNotificationClient
+{
+	LONG refs = 1;
+
+	public:
+	ULONG STDMETHODCALLTYPE AddRef() override
+	{
+		return InterlockedIncrement(&refs);
+	}
+
+	ULONG STDMETHODCALLTYPE Release() override
+	{
+		ULONG count = InterlockedDecrement(&refs);
+		if (count == 0)
+			delete this;
+		return count;
+	}
+
+	HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppv) override
+	{
+		if (riid == __uuidof(IUnknown) || riid == __uuidof(IMMNotificationClient)) {
+			*ppv = static_cast<IMMNotificationClient*>(this);
+			AddRef();
+			return S_OK;
+		}
+		*ppv = nullptr;
+		return E_NOINTERFACE;
+	}
+
+	HRESULT STDMETHODCALLTYPE OnDeviceStateChanged(LPCWSTR, DWORD) override
+	{
+		OBS_settings::invalidateCache();
+		return S_OK;
+	}
+
+	HRESULT STDMETHODCALLTYPE OnDeviceAdded(LPCWSTR) override
+	{
+		OBS_settings::invalidateCache();
+		return S_OK;
+	}
+
+	HRESULT STDMETHODCALLTYPE OnDeviceRemoved(LPCWSTR) override
+	{
+		OBS_settings::invalidateCache();
+		return S_OK;
+	}
+
+	HRESULT STDMETHODCALLTYPE OnDefaultDeviceChanged(EDataFlow, ERole, LPCWSTR) override
+	{
+		OBS_settings::invalidateCache();
+		return S_OK;
+	}
+
+	HRESULT STDMETHODCALLTYPE OnPropertyValueChanged(LPCWSTR, const PROPERTYKEY) override
+	{
+		return S_OK;
+	}
+};
+
+static ComPtr<IMMDeviceEnumerator> deviceEnumerator;
+static DeviceNotificationClient*   deviceClient = nullptr;
+
+static void pushCategory(const CachedCategory& category, std::vector<ipc::value>& rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(category.count));
+	rval.push_back(ipc::value(category.buffer.size()));
+	rval.push_back(ipc::value(category.buffer));
+	rval.push_back(ipc::value(category.type));
+}
+
 OBS_settings::OBS_settings() {}
 OBS_settings::~OBS_settings() {}
 
@@ -46,14 +157,15 @@ void OBS_settings::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Settings");
 
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_settings_getSettings", std::vector<ipc::type>{ipc::type::String}, OBS_settings_getSettings));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_settings_getSettings", std::vector<ipc::type>{ipc::type::String}, OBS_settings_getSettings));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
 	    "OBS_settings_saveSettings",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::Binary},
 	    OBS_settings_saveSettings));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_settings_getListCategories", std::vector<ipc::type>{}, OBS_settings_getListCategories));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "OBS_settings_getListCategories", std::vector<ipc::type>{}, OBS_settings_getListCategories));
 
 	srv.register_collection(cls);
 }
@@ -81,24 +193,92 @@ void OBS_settings::OBS_settings_getSettings(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	std::string              nameCategory = args[0].value_str;
-	CategoryTypes            type         = NODEOBS_CATEGORY_LIST;
-	std::vector<SubCategory> settings     = getSettings(nameCategory, type);
-	std::vector<char>        binaryValue;
-
-	for (int i = 0; i < settings.size(); i++) {
-		std::vector<char> serializedBuf = settings.at(i).serialize();
-		binaryValue.insert(binaryValue.end(), serializedBuf.begin(), serializedBuf.end());
+	std::string nameCategory  = args[0].value_str;
+	uint32_t    activeOutputs = getActiveOutputs();
+	std::string displays      = getDisplays(nameCategory);
+
+	std::unique_lock<std::mutex> ulock(cacheMutex);
+	auto                         cached = categoryCache.find(nameCategory);
+	if (cached != categoryCache.end() && cached->second.activeOutputs == activeOutputs
+	    && cached->second.displays == displays) {
+		pushCategory(cached->second, rval);
+		AUTO_DEBUG;
+		return;
 	}
 
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	rval.push_back(ipc::value(settings.size()));
-	rval.push_back(ipc::value(binaryValue.size()));
-	rval.push_back(ipc::value(binaryValue));
-	rval.push_back(ipc::value(type));
+	// Built unlocked, building a category can itself invalidate the cache.
+	uint64_t generation = cacheGeneration;
+	ulock.unlock();
+
+	CachedCategory           category = {activeOutputs, displays, NODEOBS_CATEGORY_LIST};
+	std::vector<SubCategory> settings = getSettings(nameCategory, category.type);
+
+	size_t size = 0;
+	for (const SubCategory& sc : settings)
+		size += sc.serializedSize();
+	category.buffer.reserve(size);
+
+	settings_buffer::writer w(category.buffer);
+	for (const SubCategory& sc : settings)
+		sc.serialize(w);
+	category.count = settings.size();
+
+	pushCategory(category, rval);
+
+	// Device lists can only be trusted while hot-plug is reported.
+	bool cacheable = deviceClient || nameCategory.compare("Advanced") != 0;
+
+	ulock.lock();
+	if (cacheable && generation == cacheGeneration)
+		categoryCache[nameCategory] = std::move(category);
 	AUTO_DEBUG;
 }
 
+void OBS_settings::invalidateCache(void)
+{
+	std::unique_lock<std::mutex> ulock(cacheMutex);
+	categoryCache.clear();
+	cacheGeneration++;
+}
+
+void OBS_settings::startDeviceNotifications(void)
+{
+	if (deviceClient)
+		return;
+
+	HRESULT result = CoCreateInstance(
+	    __uuidof(MMDeviceEnumerator),
+	    nullptr,
+	    CLSCTX_INPROC_SERVER,
+	    __uuidof(IMMDeviceEnumerator),
+	    (void**)&deviceEnumerator);
+	if (FAILED(result)) {
+		blog(LOG_WARNING, "Audio device changes are not reported, the Advanced settings will not be cached.");
+		return;
+	}
+
+	deviceClient = new DeviceNotificationClient();
+	result       = deviceEnumerator->RegisterEndpointNotificationCallback(deviceClient);
+	if (FAILED(result)) {
+		blog(LOG_WARNING, "Audio device changes are not reported, the Advanced settings will not be cached.");
+		deviceClient->Release();
+		deviceClient = nullptr;
+		deviceEnumerator.Clear();
+	}
+}
+
+void OBS_settings::stopDeviceNotifications(void)
+{
+	if (!deviceClient)
+		return;
+
+	deviceEnumerator->UnregisterEndpointNotificationCallback(deviceClient);
+	deviceClient->Release();
+	deviceClient = nullptr;
+	deviceEnumerator.Clear();
+	invalidateCache();
+}
+
 void UpdateAudioSettings(bool saveSettings, bool saveOnlyIfLimitApplied = false)
 {
 	// Do nothing if there is no info
@@ -139,107 +319,40 @@ void UpdateAudioSettings(bool saveSettings, bool saveOnlyIfLimitApplied = false)
 	}
 }
 
-std::vector<SubCategory> serializeCategory(uint32_t subCategoriesCount, uint32_t sizeStruct, std::vector<char> buffer)
+// Parses the sub categories straight out of the received buffer, returns
+//  false if it is truncated.
+static bool
+    parseCategory(uint32_t subCategoriesCount, const char* data, size_t size, std::vector<SubCategory>& category)
 {
-	std::vector<SubCategory> category;
-
-	size_t indexData = 0;
-	for (uint32_t i = 0; i < subCategoriesCount; i++) {
-		SubCategory sc;
-
-		size_t* sizeMessage = reinterpret_cast<size_t*>(buffer.data() + indexData);
-		indexData += sizeof(size_t);
-
-		std::string name(buffer.data() + indexData, *sizeMessage);
-		indexData += *sizeMessage;
-
-		uint32_t* paramsCount = reinterpret_cast<uint32_t*>(buffer.data() + indexData);
-		indexData += sizeof(uint32_t);
-
-		Parameter param;
-		for (uint32_t j = 0; j < *paramsCount; j++) {
-			size_t* sizeName = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string name(buffer.data() + indexData, *sizeName);
-			indexData += *sizeName;
-
-			size_t* sizeDescription = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string description(buffer.data() + indexData, *sizeDescription);
-			indexData += *sizeDescription;
-
-			size_t* sizeType = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string type(buffer.data() + indexData, *sizeType);
-			indexData += *sizeType;
-
-			size_t* sizeSubType = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string subType(buffer.data() + indexData, *sizeSubType);
-			indexData += *sizeSubType;
-
-			bool* enabled = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			bool* masked = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			bool* visible = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			double* minVal = reinterpret_cast<double*>(buffer.data() + indexData);
-			indexData += sizeof(double);
-
-			double* maxVal = reinterpret_cast<double*>(buffer.data() + indexData);
-			indexData += sizeof(double);
-
-			double* stepVal = reinterpret_cast<double*>(buffer.data() + indexData);
-			indexData += sizeof(double);
-
-			size_t* sizeOfCurrentValue = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::vector<char> currentValue;
-			currentValue.resize(*sizeOfCurrentValue);
-			memcpy(currentValue.data(), buffer.data() + indexData, *sizeOfCurrentValue);
-			indexData += *sizeOfCurrentValue;
-
-			size_t* sizeOfValues = reinterpret_cast<size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			size_t* countValues = reinterpret_cast<size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::vector<char> values;
-			values.resize(*sizeOfValues);
-			memcpy(values.data(), buffer.data() + indexData, *sizeOfValues);
-			indexData += *sizeOfValues;
-
-			param.name         = name;
-			param.description  = description;
-			param.type         = type;
-			param.subType      = subType;
-			param.enabled      = *enabled;
-			param.masked       = *masked;
-			param.visible      = *visible;
-			param.minVal       = *minVal;
-			param.maxVal       = *maxVal;
-			param.stepVal      = *stepVal;
-			param.currentValue = currentValue;
-			param.values       = values;
-			param.countValues  = *countValues;
-
-			sc.params.push_back(param);
+	settings_buffer::reader r(data, size);
+
+	category.resize(subCategoriesCount);
+	for (SubCategory& sc : category) {
+		r.read(sc.name);
+		if (!r.read(sc.paramsCount))
+			return false;
+
+		sc.params.resize(sc.paramsCount);
+		for (Parameter& param : sc.params) {
+			r.read(param.name);
+			r.read(param.description);
+			r.read(param.type);
+			r.read(param.subType);
+			r.read(param.enabled);
+			r.read(param.masked);
+			r.read(param.visible);
+			r.read(param.minVal);
+			r.read(param.maxVal);
+			r.read(param.stepVal);
+			r.read(param.sizeOfCurrentValue);
+			r.read(param.currentValue, param.sizeOfCurrentValue);
+			r.read(param.sizeOfValues);
+			r.read(param.countValues);
+			if (!r.read(param.values, param.sizeOfValues))
+				return false;
 		}
-		sc.name        = name;
-		sc.paramsCount = *paramsCount;
-		category.push_back(sc);
 	}
-	return category;
+	return true;
 }
 
 void OBS_settings::OBS_settings_saveSettings(
@@ -252,13 +365,18 @@ void OBS_settings::OBS_settings_saveSettings(
 	uint32_t    subCategoriesCount = args[1].value_union.ui32;
 	uint32_t    sizeStruct         = args[2].value_union.ui32;
 
-	std::vector<char> buffer;
-	buffer.resize(sizeStruct);
-	memcpy(buffer.data(), args[3].value_bin.data(), sizeStruct);
+	const std::vector<char>& buffer = args[3].value_bin;
+	size_t                   size   = sizeStruct < buffer.size() ? sizeStruct : buffer.size();
 
-	std::vector<SubCategory> settings = serializeCategory(subCategoriesCount, sizeStruct, buffer);
+	std::vector<SubCategory> settings;
+	if (!parseCategory(subCategoriesCount, buffer.data(), size, settings)) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Settings buffer is truncated."));
+		AUTO_DEBUG;
+		return;
+	}
 
-	saveSettings(nameCategory, settings);
+	saveSettings(nameCategory, std::move(settings));
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -3782,6 +3900,8 @@ void OBS_settings::saveSettings(std::string nameCategory, std::vector<SubCategor
 
 		OBS_API::setAudioDeviceMonitoring();
 	}
+
+	invalidateCache();
 }
 
 void OBS_settings::saveGenericSettings(std::vector<SubCategory> genericSettings, std::string section, config_t* config)
@@ -3873,4 +3993,5 @@ void OBS_settings::saveGenericSettings(std::vector<SubCategory> genericSettings,
 		}
 	}
 	config_save_safe(config, "tmp", nullptr);
+	invalidateCache();
 }
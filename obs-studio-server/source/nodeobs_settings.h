@@ -24,6 +24,7 @@
 #include <util/lexer.h>
 #include <util/platform.h>
 #include "nodeobs_service.h"
+#include "settings-buffer.hpp"
 
 #include "nodeobs_audio_encoders.h"
 
@@ -51,65 +52,30 @@ struct Parameter
 	size_t            countValues  = 0;
 	std::vector<char> values;
 
-	std::vector<char> serialize()
+	size_t serializedSize() const
 	{
-		std::vector<char> buffer;
-		size_t            indexBuffer = 0;
-
-		size_t sizeStruct = name.length() + description.length() + type.length() + subType.length() + sizeof(size_t) * 7
-		                    + sizeof(bool) * 3 + sizeof(double) * 3 + sizeOfCurrentValue + sizeOfValues;
-		buffer.resize(sizeStruct);
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = name.length();
-		indexBuffer += sizeof(size_t);
-		memcpy(buffer.data() + indexBuffer, name.data(), name.length());
-		indexBuffer += name.length();
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = description.length();
-		indexBuffer += sizeof(size_t);
-		memcpy(buffer.data() + indexBuffer, description.data(), description.length());
-		indexBuffer += description.length();
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = type.length();
-		indexBuffer += sizeof(size_t);
-		memcpy(buffer.data() + indexBuffer, type.data(), type.length());
-		indexBuffer += type.length();
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = subType.length();
-		indexBuffer += sizeof(size_t);
-		memcpy(buffer.data() + indexBuffer, subType.data(), subType.length());
-		indexBuffer += subType.length();
-
-		*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = enabled;
-		indexBuffer += sizeof(bool);
-		*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = masked;
-		indexBuffer += sizeof(bool);
-		*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = visible;
-		indexBuffer += sizeof(bool);
-
-		*reinterpret_cast<double*>(buffer.data() + indexBuffer) = minVal;
-		indexBuffer += sizeof(double);
-		*reinterpret_cast<double*>(buffer.data() + indexBuffer) = maxVal;
-		indexBuffer += sizeof(double);
-		*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = stepVal;
-		indexBuffer += sizeof(double);
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = sizeOfCurrentValue;
-		indexBuffer += sizeof(size_t);
-
-		memcpy(buffer.data() + indexBuffer, currentValue.data(), sizeOfCurrentValue);
-		indexBuffer += sizeOfCurrentValue;
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = sizeOfValues;
-		indexBuffer += sizeof(size_t);
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = countValues;
-		indexBuffer += sizeof(size_t);
-
-		memcpy(buffer.data() + indexBuffer, values.data(), sizeOfValues);
-		indexBuffer += sizeOfValues;
-
-		return buffer;
+		return settings_buffer::string_size(name.length()) + settings_buffer::string_size(description.length())
+		       + settings_buffer::string_size(type.length()) + settings_buffer::string_size(subType.length())
+		       + sizeof(bool) * 3 + sizeof(double) * 3 + settings_buffer::string_size(sizeOfCurrentValue)
+		       + sizeof(size_t) * 2 + sizeOfValues;
+	}
+
+	void serialize(settings_buffer::writer& w) const
+	{
+		w.write(name);
+		w.write(description);
+		w.write(type);
+		w.write(subType);
+		w.write(enabled);
+		w.write(masked);
+		w.write(visible);
+		w.write(minVal);
+		w.write(maxVal);
+		w.write(stepVal);
+		w.write(currentValue.data(), sizeOfCurrentValue);
+		w.write(sizeOfValues);
+		w.write(countValues);
+		w.append(values.data(), sizeOfValues);
 	}
 };
 
@@ -119,29 +85,20 @@ struct SubCategory
 	size_t                 paramsCount = 0;
 	std::vector<Parameter> params;
 
-	std::vector<char> serialize()
+	size_t serializedSize() const
 	{
-		std::vector<char> buffer;
-		size_t            indexBuffer = 0;
-
-		size_t sizeStruct = name.length() + sizeof(size_t) + sizeof(size_t);
-		buffer.resize(sizeStruct);
-
-		*reinterpret_cast<size_t*>(buffer.data()) = name.length();
-		indexBuffer += sizeof(size_t);
-		memcpy(buffer.data() + indexBuffer, name.data(), name.length());
-		indexBuffer += name.length();
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = paramsCount;
-		indexBuffer += sizeof(size_t);
-
-		for (int i = 0; i < params.size(); i++) {
-			std::vector<char> serializedBuf = params.at(i).serialize();
-
-			buffer.insert(buffer.end(), serializedBuf.begin(), serializedBuf.end());
-		}
+		size_t size = settings_buffer::string_size(name.length()) + sizeof(size_t);
+		for (const Parameter& param : params)
+			size += param.serializedSize();
+		return size;
+	}
 
-		return buffer;
+	void serialize(settings_buffer::writer& w) const
+	{
+		w.write(name);
+		w.write(paramsCount);
+		for (const Parameter& param : params)
+			param.serialize(w);
 	}
 };
 
@@ -171,6 +128,12 @@ class OBS_settings
 
 	static void saveGenericSettings(std::vector<SubCategory> genericSettings, std::string section, config_t* config);
 
+	// Category results are cached until something they are built from
+	//  changes: saved settings, loaded modules or audio devices.
+	static void invalidateCache(void);
+	static void startDeviceNotifications(void);
+	static void stopDeviceNotifications(void);
+
 	private:
 	static std::vector<std::string> getListCategories(void);
 
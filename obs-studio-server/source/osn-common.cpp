@@ -17,3 +17,198 @@
 ******************************************************************************/
 
 #include "osn-common.hpp"
+#include <string>
+#include "obs-data-binary.hpp"
+
+static void encode_name(obs_data_binary::writer& w, obs_data_item_t* item, obs_data_binary::type t)
+{
+	const char* name = obs_data_item_get_name(item);
+	w.write(name, strlen(name));
+	w.write(t);
+}
+
+static void encode_object(obs_data_t* data, obs_data_binary::writer& w)
+{
+	size_t   count_at = w.reserve_count();
+	uint32_t count    = 0;
+
+	for (obs_data_item_t* item = obs_data_first(data); item != nullptr; obs_data_item_next(&item)) {
+		switch (obs_data_item_gettype(item)) {
+		case OBS_DATA_BOOLEAN:
+			encode_name(w, item, obs_data_binary::type::boolean);
+			w.write(uint8_t(obs_data_item_get_bool(item)));
+			break;
+		case OBS_DATA_NUMBER:
+			if (obs_data_item_numtype(item) == OBS_DATA_NUM_DOUBLE) {
+				encode_name(w, item, obs_data_binary::type::number);
+				w.write(double(obs_data_item_get_double(item)));
+			} else {
+				encode_name(w, item, obs_data_binary::type::integer);
+				w.write(int64_t(obs_data_item_get_int(item)));
+			}
+			break;
+		case OBS_DATA_STRING: {
+			const char* value = obs_data_item_get_string(item);
+			encode_name(w, item, obs_data_binary::type::string);
+			w.write(value, value ? strlen(value) : 0);
+			break;
+		}
+		case OBS_DATA_OBJECT: {
+			obs_data_t* value = obs_data_item_get_obj(item);
+			if (value == nullptr)
+				continue;
+			encode_name(w, item, obs_data_binary::type::object);
+			encode_object(value, w);
+			obs_data_release(value);
+			break;
+		}
+		case OBS_DATA_ARRAY: {
+			obs_data_array_t* value = obs_data_item_get_array(item);
+			if (value == nullptr)
+				continue;
+			size_t length = obs_data_array_count(value);
+			encode_name(w, item, obs_data_binary::type::array);
+			w.write(uint32_t(length));
+			for (size_t idx = 0; idx < length; idx++) {
+				obs_data_t* element = obs_data_array_item(value, idx);
+				encode_object(element, w);
+				obs_data_release(element);
+			}
+			obs_data_array_release(value);
+			break;
+		}
+		default:
+			continue;
+		}
+		count++;
+	}
+
+	w.patch_count(count_at, count);
+}
+
+static bool decode_object(obs_data_binary::reader& r, obs_data_t* data, std::string& name, std::string& value);
+
+// Sets the value of type 't' as 'name' in 'data'. 'name' and 'value' are
+//  scratch space reused for every item, obs_data needs terminated strings.
+static bool decode_value(
+    obs_data_binary::reader& r,
+    uint8_t                  t,
+    obs_data_t*              data,
+    std::string&             name,
+    std::string&             value)
+{
+	const char* chars  = nullptr;
+	uint32_t    length = 0;
+
+	switch (obs_data_binary::type(t)) {
+	case obs_data_binary::type::boolean: {
+		uint8_t v = 0;
+		if (!r.read(v))
+			return false;
+		obs_data_set_bool(data, name.c_str(), !!v);
+		break;
+	}
+	case obs_data_binary::type::integer: {
+		int64_t v = 0;
+		if (!r.read(v))
+			return false;
+		obs_data_set_int(data, name.c_str(), v);
+		break;
+	}
+	case obs_data_binary::type::number: {
+		double v = 0;
+		if (!r.read(v))
+			return false;
+		obs_data_set_double(data, name.c_str(), v);
+		break;
+	}
+	case obs_data_binary::type::string:
+		if (!r.read(chars, length))
+			return false;
+		value.assign(chars, length);
+		obs_data_set_string(data, name.c_str(), value.c_str());
+		break;
+	case obs_data_binary::type::object: {
+		// Attached first, decoding reuses 'name'.
+		obs_data_t* obj = obs_data_create();
+		obs_data_set_obj(data, name.c_str(), obj);
+		bool ok = decode_object(r, obj, name, value);
+		obs_data_release(obj);
+		if (!ok)
+			return false;
+		break;
+	}
+	case obs_data_binary::type::array: {
+		uint32_t elements = 0;
+		if (!r.read(elements))
+			return false;
+		obs_data_array_t* array = obs_data_array_create();
+		obs_data_set_array(data, name.c_str(), array);
+		bool ok = true;
+		for (uint32_t idx = 0; ok && (idx < elements); idx++) {
+			obs_data_t* obj = obs_data_create();
+			ok              = decode_object(r, obj, name, value);
+			obs_data_array_push_back(array, obj);
+			obs_data_release(obj);
+		}
+		obs_data_array_release(array);
+		if (!ok)
+			return false;
+		break;
+	}
+	default:
+		return false;
+	}
+	return true;
+}
+
+static bool decode_object(obs_data_binary::reader& r, obs_data_t* data, std::string& name, std::string& value)
+{
+	uint32_t count = 0;
+	if (!r.read(count))
+		return false;
+
+	for (uint32_t n = 0; n < count; n++) {
+		const char* chars  = nullptr;
+		uint32_t    length = 0;
+		uint8_t     t      = 0;
+		r.read(chars, length);
+		if (!r.read(t))
+			return false;
+		name.assign(chars, length);
+		if (!decode_value(r, t, data, name, value))
+			return false;
+	}
+	return true;
+}
+
+void osn::common::EncodeData(obs_data_t* data, std::vector<char>& buf)
+{
+	obs_data_binary::writer w(buf);
+	encode_object(data, w);
+}
+
+obs_data_t* osn::common::DecodeData(std::vector<char> const& buf)
+{
+	obs_data_binary::reader r(buf);
+	std::string             name, value;
+	obs_data_t*             data = obs_data_create();
+	if (!decode_object(r, data, name, value)) {
+		obs_data_release(data);
+		return nullptr;
+	}
+	return data;
+}
+
+bool osn::common::DecodeValue(obs_data_binary::reader& r, uint8_t type, obs_data_t* data, const std::string& name)
+{
+	std::string key = name, value;
+	return decode_value(r, type, data, key, value);
+}
+
+obs_data_t* osn::common::DataFromValue(const ipc::value& value)
+{
+	if (value.type == ipc::type::Binary)
+		return DecodeData(value.value_bin);
+	return obs_data_create_from_json(value.value_str.c_str());
+}
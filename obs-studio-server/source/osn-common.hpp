@@ -19,10 +19,22 @@
 #pragma once
 #include <ipc-value.hpp>
 #include <obs.h>
+#include <string>
 #include <vector>
+#include "obs-data-binary.hpp"
 
 namespace osn
 {
 	namespace common
-	{}
+	{
+		// Settings in the binary encoding described in obs-data-binary.hpp.
+		void        EncodeData(obs_data_t* data, std::vector<char>& buf);
+		obs_data_t* DecodeData(std::vector<char> const& buf);
+		// Reads a single value of 'type' and sets it as 'name' in 'data'.
+		bool DecodeValue(obs_data_binary::reader& r, uint8_t type, obs_data_t* data, const std::string& name);
+
+		// Settings sent either as JSON or binary. Returns a new reference, or
+		//  null if the value could not be parsed.
+		obs_data_t* DataFromValue(const ipc::value& value);
+	} // namespace common
 } // namespace osn
@@ -0,0 +1,114 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-events.hpp"
+#include "callback-manager.h"
+#include "error.hpp"
+#include "event-frame.hpp"
+#include "nodeobs_autoconfig.h"
+#include "nodeobs_service.h"
+#include "osn-sceneitem.hpp"
+#include "osn-volmeter.hpp"
+#include "shared.hpp"
+#include "util-callstats.h"
+
+std::mutex                            osn::Events::mtx;
+std::condition_variable               osn::Events::cv;
+bool                                  osn::Events::urgent = false;
+std::chrono::steady_clock::time_point osn::Events::next_meter_flush;
+
+void osn::Events::Register(ipc::server& srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Events");
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Poll", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32}, Poll));
+	srv.register_collection(cls);
+}
+
+void osn::Events::Notify()
+{
+	{
+		std::unique_lock<std::mutex> ulock(mtx);
+		urgent = true;
+	}
+	cv.notify_one();
+}
+
+void osn::Events::NotifyMeters()
+{
+	cv.notify_one();
+}
+
+void osn::Events::Poll(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	auto timeout        = std::chrono::milliseconds(args[0].value_union.ui32);
+	auto meter_interval = std::chrono::milliseconds(args[1].value_union.ui32);
+	auto deadline       = std::chrono::steady_clock::now() + timeout;
+	auto types          = args[2].value_union.ui32;
+	auto wants          = [types](event_frame::type t) { return (types & (1u << uint32_t(t))) != 0; };
+
+	{
+		std::unique_lock<std::mutex> ulock(mtx);
+		for (;;) {
+			if (urgent)
+				break;
+
+			auto now = std::chrono::steady_clock::now();
+			if (now >= deadline)
+				break;
+
+			auto wake = deadline;
+			if (meter_interval.count() > 0 && wants(event_frame::type::volmeter_frames)) {
+				if (now >= next_meter_flush) {
+					if (osn::VolMeter::HasPendingFrames())
+						break;
+					// NotifyMeters may race with us since it does not lock, so
+					//  also look again after one interval.
+					wake = std::min(wake, now + meter_interval);
+				} else {
+					wake = std::min(wake, next_meter_flush);
+				}
+			}
+			cv.wait_until(ulock, wake);
+		}
+		urgent = false;
+	}
+
+	// Types the client has no handler for stay queued until it subscribes.
+	std::vector<char> events;
+	if (wants(event_frame::type::output_signal))
+		OBS_service::WriteEvents(events);
+	if (wants(event_frame::type::source_size))
+		CallbackManager::WriteEvents(events);
+	if (wants(event_frame::type::scene_item))
+		osn::SceneItem::WriteEvents(events);
+	if (wants(event_frame::type::autoconfig))
+		autoConfig::WriteEvents(events);
+	if (wants(event_frame::type::volmeter_frames) && osn::VolMeter::WriteEvents(events)) {
+		std::unique_lock<std::mutex> ulock(mtx);
+		next_meter_flush = std::chrono::steady_clock::now() + meter_interval;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(events));
+	AUTO_DEBUG;
+}
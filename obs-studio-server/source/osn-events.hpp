@@ -0,0 +1,56 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <ipc-server.hpp>
+#include <mutex>
+
+namespace osn
+{
+	// Single channel for everything the server has to tell the client.
+	//
+	// Producers queue their data as before and call Notify(). Poll blocks
+	//  until something is pending and then collects output signals, source
+	//  sizes, autoconfig progress and volmeter frames into one framed reply
+	//  (see event-frame.hpp). Volmeter frames are only flushed once per meter
+	//  interval, everything else is delivered as soon as it arrives. Only the
+	//  event types the client asks for are collected, one bit per
+	//  event_frame::type, the others stay queued.
+	class Events
+	{
+		static std::mutex                            mtx;
+		static std::condition_variable               cv;
+		static bool                                  urgent;
+		static std::chrono::steady_clock::time_point next_meter_flush;
+
+		public:
+		static void Register(ipc::server&);
+
+		// Wakes up Poll right away.
+		static void Notify();
+
+		// Lets Poll re-check for volmeter frames. Does not lock, so that it can
+		//  be called from the libobs audio thread.
+		static void NotifyMeters();
+
+		static void Poll(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+	};
+} // namespace osn
@@ -21,6 +21,7 @@
 #include "obs.h"
 #include "osn-source.hpp"
 #include "shared.hpp"
+#include "util-callstats.h"
 #include "utility.hpp"
 
 osn::Fader::Manager& osn::Fader::Manager::GetInstance()
@@ -32,29 +33,30 @@ osn::Fader::Manager& osn::Fader::Manager::GetInstance()
 void osn::Fader::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Fader");
-	cls->register_function(std::make_shared<ipc::function>("Create", std::vector<ipc::type>{ipc::type::Int32}, Create));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
+	    std::make_shared<util::TimedFunction>(cls, "Create", std::vector<ipc::type>{ipc::type::Int32}, Create));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetDeziBel", std::vector<ipc::type>{ipc::type::UInt64}, GetDeziBel));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetDeziBel", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeziBel));
+	    std::make_shared<util::TimedFunction>(cls, "Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetDeziBel", std::vector<ipc::type>{ipc::type::UInt64}, GetDeziBel));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetDeziBel", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeziBel));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetDeflection", std::vector<ipc::type>{ipc::type::UInt64}, GetDeflection));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetDeflection", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeflection));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetMultiplier", std::vector<ipc::type>{ipc::type::UInt64}, GetMultiplier));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetMultiplier", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetMultiplier));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetDeflection", std::vector<ipc::type>{ipc::type::UInt64}, GetDeflection));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetDeflection", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeflection));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetMultiplier", std::vector<ipc::type>{ipc::type::UInt64}, GetMultiplier));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetMultiplier", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetMultiplier));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
-	cls->register_function(
-	    std::make_shared<ipc::function>("Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
-	cls->register_function(
-	    std::make_shared<ipc::function>("AddCallback", std::vector<ipc::type>{ipc::type::UInt64}, AddCallback));
-	cls->register_function(
-	    std::make_shared<ipc::function>("RemoveCallback", std::vector<ipc::type>{ipc::type::UInt64}, RemoveCallback));
+	    std::make_shared<util::TimedFunction>(cls, "Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "AddCallback", std::vector<ipc::type>{ipc::type::UInt64}, AddCallback));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "RemoveCallback", std::vector<ipc::type>{ipc::type::UInt64}, RemoveCallback));
 	srv.register_collection(cls);
 }
 
@@ -85,7 +87,7 @@ void osn::Fader::Create(
 	}
 
 	auto uid = Manager::GetInstance().allocate(fader);
-	if (uid == std::numeric_limits<utility::unique_id::id_t>::max()) {
+	if (uid == std::numeric_limits<utility::handle_table::id_t>::max()) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
 		rval.push_back(ipc::value("Failed to allocate unique id for Fader."));
 		obs_fader_destroy(fader);
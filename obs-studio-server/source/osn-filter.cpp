@@ -23,15 +23,16 @@
 #include "error.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
+#include "util-callstats.h"
 
 void osn::Filter::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Filter");
-	cls->register_function(std::make_shared<ipc::function>("Types", std::vector<ipc::type>{}, Types));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
+	cls->register_function(std::make_shared<util::TimedFunction>(cls, "Types", std::vector<ipc::type>{}, Types));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
 	srv.register_collection(cls);
 }
 
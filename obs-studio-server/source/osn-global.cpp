@@ -19,23 +19,28 @@
 #include "osn-global.hpp"
 #include <error.hpp>
 #include <obs.h>
+#include "nodeobs_settings.h"
 #include "osn-source.hpp"
 #include "shared.hpp"
+#include "util-callstats.h"
 
 void osn::Global::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Global");
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetOutputSource", std::vector<ipc::type>{ipc::type::UInt32}, GetOutputSource));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetOutputSource", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt64}, SetOutputSource));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetOutputFlagsFromId", std::vector<ipc::type>{ipc::type::String}, GetOutputFlagsFromId));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetOutputSource", std::vector<ipc::type>{ipc::type::UInt32}, GetOutputSource));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetOutputSource", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt64}, SetOutputSource));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetOutputFlagsFromId", std::vector<ipc::type>{ipc::type::String}, GetOutputFlagsFromId));
-	cls->register_function(std::make_shared<ipc::function>("LaggedFrames", std::vector<ipc::type>{}, LaggedFrames));
-	cls->register_function(std::make_shared<ipc::function>("TotalFrames", std::vector<ipc::type>{}, TotalFrames));
-	cls->register_function(std::make_shared<ipc::function>("GetLocale", std::vector<ipc::type>{}, GetLocale));
+	    std::make_shared<util::TimedFunction>(cls, "LaggedFrames", std::vector<ipc::type>{}, LaggedFrames));
 	cls->register_function(
-	    std::make_shared<ipc::function>("SetLocale", std::vector<ipc::type>{ipc::type::String}, SetLocale));
+	    std::make_shared<util::TimedFunction>(cls, "TotalFrames", std::vector<ipc::type>{}, TotalFrames));
+	cls->register_function(
+	    std::make_shared<util::TimedFunction>(cls, "GetLocale", std::vector<ipc::type>{}, GetLocale));
+	cls->register_function(
+	    std::make_shared<util::TimedFunction>(cls, "SetLocale", std::vector<ipc::type>{ipc::type::String}, SetLocale));
 	srv.register_collection(cls);
 }
 
@@ -161,6 +166,8 @@ void osn::Global::SetLocale(
     std::vector<ipc::value>&       rval)
 {
 	obs_set_locale(args[0].value_str.c_str());
+	osn::Source::InvalidateTypeInfo();
+	OBS_settings::invalidateCache();
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
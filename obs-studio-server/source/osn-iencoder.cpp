@@ -18,30 +18,32 @@
 
 #include "osn-IEncoder.hpp"
 #include "error.hpp"
+#include "util-callstats.h"
 #include <obs.h>
 
 void osn::IEncoder::Register(ipc::server& srv)
 {
 	auto cls = std::make_shared<ipc::collection>("IEncoder");
-	cls->register_function(std::make_shared<ipc::function>("GetId", std::vector<ipc::type>{ipc::type::String}, &GetId));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetName", std::vector<ipc::type>{ipc::type::String}, &GetName));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetName", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, &SetName));
+	    std::make_shared<util::TimedFunction>(cls, "GetId", std::vector<ipc::type>{ipc::type::String}, &GetId));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetCaps", std::vector<ipc::type>{ipc::type::String}, &GetCaps));
+	    std::make_shared<util::TimedFunction>(cls, "GetName", std::vector<ipc::type>{ipc::type::String}, &GetName));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetName", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, &SetName));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetType", std::vector<ipc::type>{ipc::type::String}, &GetType));
+	    std::make_shared<util::TimedFunction>(cls, "GetCaps", std::vector<ipc::type>{ipc::type::String}, &GetCaps));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetCodec", std::vector<ipc::type>{ipc::type::String}, &GetCodec));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Update", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, &Update));
+	    std::make_shared<util::TimedFunction>(cls, "GetType", std::vector<ipc::type>{ipc::type::String}, &GetType));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetProperties", std::vector<ipc::type>{ipc::type::String}, &GetProperties));
+	    std::make_shared<util::TimedFunction>(cls, "GetCodec", std::vector<ipc::type>{ipc::type::String}, &GetCodec));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Update", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, &Update));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetProperties", std::vector<ipc::type>{ipc::type::String}, &GetProperties));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetSettings", std::vector<ipc::type>{ipc::type::String}, &GetSettings));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetSettings", std::vector<ipc::type>{ipc::type::String}, &GetSettings));
-	cls->register_function(
-	    std::make_shared<ipc::function>("Release", std::vector<ipc::type>{ipc::type::String}, &Release));
+	    std::make_shared<util::TimedFunction>(cls, "Release", std::vector<ipc::type>{ipc::type::String}, &Release));
 	srv.register_collection(cls);
 }
 
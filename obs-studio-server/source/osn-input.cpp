@@ -22,85 +22,105 @@
 #include <memory>
 #include <obs.h>
 #include "error.hpp"
+#include "osn-common.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
+#include "util-callstats.h"
 
 void osn::Input::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Input");
-	cls->register_function(std::make_shared<ipc::function>("Types", std::vector<ipc::type>{}, Types));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(std::make_shared<util::TimedFunction>(cls, "Types", std::vector<ipc::type>{}, Types));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
 	    "Create",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String, ipc::type::String},
 	    Create));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "CreatePrivate", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, CreatePrivate));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::Binary}, Create));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
+	    "Create",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::Binary, ipc::type::String},
+	    Create));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "CreatePrivate", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, CreatePrivate));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
 	    "CreatePrivate",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String},
 	    CreatePrivate));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
+	    "CreatePrivate",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::Binary},
+	    CreatePrivate));
 	cls->register_function(
-	    std::make_shared<ipc::function>("FromName", std::vector<ipc::type>{ipc::type::String}, FromName));
+	    std::make_shared<util::TimedFunction>(cls, "FromName", std::vector<ipc::type>{ipc::type::String}, FromName));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetPublicSources", std::vector<ipc::type>{}, GetPublicSources));
+	    std::make_shared<util::TimedFunction>(cls, "GetPublicSources", std::vector<ipc::type>{}, GetPublicSources));
 
 	cls->register_function(
-	    std::make_shared<ipc::function>("Duplicate", std::vector<ipc::type>{ipc::type::UInt64}, Duplicate));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Duplicate));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::Int32}, Duplicate));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetActive", std::vector<ipc::type>{ipc::type::UInt64}, GetActive));
+	    std::make_shared<util::TimedFunction>(cls, "Duplicate", std::vector<ipc::type>{ipc::type::UInt64}, Duplicate));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Duplicate));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::Int32}, Duplicate));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetShowing", std::vector<ipc::type>{ipc::type::UInt64}, GetShowing));
+	    std::make_shared<util::TimedFunction>(cls, "GetActive", std::vector<ipc::type>{ipc::type::UInt64}, GetActive));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetShowing", std::vector<ipc::type>{ipc::type::UInt64}, GetShowing));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetWidth", std::vector<ipc::type>{ipc::type::UInt64}, GetWidth));
+	    std::make_shared<util::TimedFunction>(cls, "GetWidth", std::vector<ipc::type>{ipc::type::UInt64}, GetWidth));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetHeight", std::vector<ipc::type>{ipc::type::UInt64}, GetHeight));
+	    std::make_shared<util::TimedFunction>(cls, "GetHeight", std::vector<ipc::type>{ipc::type::UInt64}, GetHeight));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetVolume", std::vector<ipc::type>{ipc::type::UInt64}, GetVolume));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetVolume", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetVolume));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64}, GetSyncOffset));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, SetSyncOffset));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetAudioMixers", std::vector<ipc::type>{ipc::type::UInt64}, GetAudioMixers));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetAudioMixers", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetAudioMixers));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetMonitoringType", std::vector<ipc::type>{ipc::type::UInt64}, GetMonitoringType));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetMonitoringType", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetMonitoringType));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetDeInterlaceFieldOrder", std::vector<ipc::type>{ipc::type::UInt64}, GetDeInterlaceFieldOrder));
-	cls->register_function(std::make_shared<ipc::function>(
+	    std::make_shared<util::TimedFunction>(cls, "GetVolume", std::vector<ipc::type>{ipc::type::UInt64}, GetVolume));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetVolume", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetVolume));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64}, GetSyncOffset));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, SetSyncOffset));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetAudioMixers", std::vector<ipc::type>{ipc::type::UInt64}, GetAudioMixers));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetAudioMixers", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetAudioMixers));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetMonitoringType", std::vector<ipc::type>{ipc::type::UInt64}, GetMonitoringType));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetMonitoringType", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetMonitoringType));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetDeInterlaceFieldOrder", std::vector<ipc::type>{ipc::type::UInt64}, GetDeInterlaceFieldOrder));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
 	    "SetDeInterlaceFieldOrder",
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32},
 	    SetDeInterlaceFieldOrder));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetDeInterlaceMode", std::vector<ipc::type>{ipc::type::UInt64}, GetDeInterlaceMode));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetDeInterlaceMode", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, GetDeInterlaceMode));
-
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetFilters", std::vector<ipc::type>{ipc::type::UInt64}, GetFilters));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "AddFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, AddFilter));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "RemoveFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, RemoveFilter));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "MoveFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64, ipc::type::UInt32}, MoveFilter));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "FindFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, FindFilter));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "CopyFiltersTo", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, CopyFiltersTo));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetDeInterlaceMode", std::vector<ipc::type>{ipc::type::UInt64}, GetDeInterlaceMode));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetDeInterlaceMode", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, GetDeInterlaceMode));
+
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetFilters", std::vector<ipc::type>{ipc::type::UInt64}, GetFilters));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "AddFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, AddFilter));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "RemoveFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, RemoveFilter));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
+	    "MoveFilter",
+	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64, ipc::type::UInt32},
+	    MoveFilter));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "FindFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, FindFilter));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "CopyFiltersTo", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, CopyFiltersTo));
 
 	srv.register_collection(cls);
 }
@@ -128,13 +148,21 @@ void osn::Input::Create(
 	case 4:
 		hotkeys = obs_data_create_from_json(args[3].value_str.c_str());
 	case 3:
-		settings = obs_data_create_from_json(args[2].value_str.c_str());
+		settings = osn::common::DataFromValue(args[2]);
 	case 2:
 		name     = args[1].value_str;
 		sourceId = args[0].value_str;
 		break;
 	}
 
+	if (!settings && args.size() >= 3 && args[2].type == ipc::type::Binary) {
+		obs_data_release(hotkeys);
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Settings are malformed."));
+		AUTO_DEBUG;
+		return;
+	}
+
 	obs_source_t* source = obs_source_create(sourceId.c_str(), name.c_str(), settings, hotkeys);
 	if (!source) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
@@ -171,13 +199,20 @@ void osn::Input::CreatePrivate(
 
 	switch (args.size()) {
 	case 3:
-		settings = obs_data_create_from_json(args[2].value_str.c_str());
+		settings = osn::common::DataFromValue(args[2]);
 	case 2:
 		name     = args[1].value_str;
 		sourceId = args[0].value_str;
 		break;
 	}
 
+	if (!settings && args.size() >= 3 && args[2].type == ipc::type::Binary) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Settings are malformed."));
+		AUTO_DEBUG;
+		return;
+	}
+
 	obs_source_t* source = obs_source_create_private(sourceId.c_str(), name.c_str(), settings);
 	if (!source) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
@@ -18,32 +18,34 @@
 
 #include "osn-module.hpp"
 #include "error.hpp"
+#include "nodeobs_settings.h"
+#include "osn-source.hpp"
 #include "shared.hpp"
+#include "util-callstats.h"
 
 void osn::Module::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Module");
 
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Open", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Open));
+	cls->register_function(std::make_shared<util::TimedFunction>(cls, "Modules", std::vector<ipc::type>{}, Modules));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Initialize", std::vector<ipc::type>{ipc::type::UInt64}, Initialize));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Open", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Open));
+	    std::make_shared<util::TimedFunction>(cls, "GetName", std::vector<ipc::type>{ipc::type::UInt64}, GetName));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetFileName", std::vector<ipc::type>{ipc::type::UInt64}, GetFileName));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Modules", std::vector<ipc::type>{}, Modules));
-	cls->register_function(
-	    std::make_shared<ipc::function>("Initialize", std::vector<ipc::type>{ipc::type::UInt64}, Initialize));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetName", std::vector<ipc::type>{ipc::type::UInt64}, GetName));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetFileName", std::vector<ipc::type>{ipc::type::UInt64}, GetFileName));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetAuthor", std::vector<ipc::type>{ipc::type::UInt64}, GetAuthor));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetDescription", std::vector<ipc::type>{ipc::type::UInt64}, GetDescription));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetBinaryPath", std::vector<ipc::type>{ipc::type::UInt64}, GetBinaryPath));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetDataPath", std::vector<ipc::type>{ipc::type::UInt64}, GetDataPath));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetDataPath", std::vector<ipc::type>{ipc::type::UInt64}, GetDataPath));
+	    std::make_shared<util::TimedFunction>(cls, "GetAuthor", std::vector<ipc::type>{ipc::type::UInt64}, GetAuthor));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetDescription", std::vector<ipc::type>{ipc::type::UInt64}, GetDescription));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetBinaryPath", std::vector<ipc::type>{ipc::type::UInt64}, GetBinaryPath));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetDataPath", std::vector<ipc::type>{ipc::type::UInt64}, GetDataPath));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetDataPath", std::vector<ipc::type>{ipc::type::UInt64}, GetDataPath));
 
 	srv.register_collection(cls);
 }
@@ -56,6 +58,8 @@ void osn::Module::Open(void* data, const int64_t id, const std::vector<ipc::valu
 	const std::string data_path = args[1].value_str.c_str();
 
 	int64_t result = obs_open_module(&module, bin_path.c_str(), data_path.c_str());
+	osn::Source::InvalidateTypeInfo();
+	OBS_settings::invalidateCache();
 
 	if (result == MODULE_SUCCESS) {
 		uint64_t uid = osn::Module::Manager::GetInstance().allocate(module);
@@ -105,8 +109,12 @@ void osn::Module::Initialize(
 		return;
 	}
 	
+	bool result = obs_init_module(module);
+	osn::Source::InvalidateTypeInfo();
+	OBS_settings::invalidateCache();
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	rval.push_back(ipc::value(obs_init_module(module)));
+	rval.push_back(ipc::value(result));
 	AUTO_DEBUG;
 }
 
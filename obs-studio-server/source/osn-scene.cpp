@@ -17,52 +17,58 @@
 ******************************************************************************/
 
 #include "osn-scene.hpp"
+#include <cstring>
 #include <list>
 #include "error.hpp"
 #include "osn-sceneitem.hpp"
+#include "scene-snapshot.hpp"
 #include "shared.hpp"
+#include "util-callstats.h"
 
 void osn::Scene::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Scene");
 	cls->register_function(
-	    std::make_shared<ipc::function>("Create", std::vector<ipc::type>{ipc::type::String}, Create));
+	    std::make_shared<util::TimedFunction>(cls, "Create", std::vector<ipc::type>{ipc::type::String}, Create));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "CreatePrivate", std::vector<ipc::type>{ipc::type::String}, CreatePrivate));
 	cls->register_function(
-	    std::make_shared<ipc::function>("CreatePrivate", std::vector<ipc::type>{ipc::type::String}, CreatePrivate));
-	cls->register_function(
-	    std::make_shared<ipc::function>("FromName", std::vector<ipc::type>{ipc::type::String}, FromName));
+	    std::make_shared<util::TimedFunction>(cls, "FromName", std::vector<ipc::type>{ipc::type::String}, FromName));
 
 	cls->register_function(
-	    std::make_shared<ipc::function>("Release", std::vector<ipc::type>{ipc::type::UInt64}, Release));
+	    std::make_shared<util::TimedFunction>(cls, "Release", std::vector<ipc::type>{ipc::type::UInt64}, Release));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
+	    std::make_shared<util::TimedFunction>(cls, "Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
 
 	cls->register_function(
-	    std::make_shared<ipc::function>("AsSource", std::vector<ipc::type>{ipc::type::UInt64}, AsSource));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::Int32}, Duplicate));
-
-	cls->register_function(std::make_shared<ipc::function>(
-	    "AddSource", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, AddSource));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "FindItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, FindItemByName));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "FindItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, FindItemByItemId));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "MoveItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32}, MoveItem));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, GetItem));
+	    std::make_shared<util::TimedFunction>(cls, "AsSource", std::vector<ipc::type>{ipc::type::UInt64}, AsSource));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::Int32}, Duplicate));
+
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "AddSource", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, AddSource));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "FindItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, FindItemByName));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "FindItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, FindItemByItemId));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "MoveItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32}, MoveItem));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, GetItem));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetItems", std::vector<ipc::type>{ipc::type::UInt64}, GetItems));
-	cls->register_function(std::make_shared<ipc::function>(
+	    std::make_shared<util::TimedFunction>(cls, "GetItems", std::vector<ipc::type>{ipc::type::UInt64}, GetItems));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
 	    "GetItemsInRange",
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32},
 	    GetItemsInRange));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetSnapshot", std::vector<ipc::type>{ipc::type::UInt64}, GetSnapshot));
 
 	cls->register_function(
-	    std::make_shared<ipc::function>("Connect", std::vector<ipc::type>{ipc::type::UInt64}, Connect));
-	cls->register_function(
-	    std::make_shared<ipc::function>("Disconnect", std::vector<ipc::type>{ipc::type::UInt64}, Disconnect));
+	    std::make_shared<util::TimedFunction>(cls, "Connect", std::vector<ipc::type>{ipc::type::UInt64}, Connect));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Disconnect", std::vector<ipc::type>{ipc::type::UInt64}, Disconnect));
 	srv.register_collection(cls);
 }
 
@@ -131,6 +137,9 @@ void osn::Scene::CreatePrivate(
 		return;
 	}
 
+	// Private scenes never go through the global source_create signal.
+	osn::SceneItem::attach_scene_signals(source);
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
 	AUTO_DEBUG;
@@ -205,7 +214,7 @@ void osn::Scene::Release(
 	if (obs_source_removed(source)) {
 		osn::Source::Manager::GetInstance().free(args[0].value_union.ui64);
 		for (auto item : items) {
-			osn::SceneItem::Manager::GetInstance().free(item);
+			osn::SceneItem::untrack(item, osn::SceneItem::Manager::GetInstance().free(item));
 			obs_sceneitem_release(item);
 		}
 	}
@@ -253,7 +262,7 @@ void osn::Scene::Remove(
 	osn::Source::Manager::GetInstance().free(args[0].value_union.ui64);
 
 	for (auto item : items) {
-		osn::SceneItem::Manager::GetInstance().free(item);
+		osn::SceneItem::untrack(item, osn::SceneItem::Manager::GetInstance().free(item));
 		obs_sceneitem_release(item);
 		obs_sceneitem_release(item);
 	}
@@ -296,8 +305,8 @@ void osn::Scene::Duplicate(
 		return;
 	}
 
-	obs_scene_t* scene2 =
-	    obs_scene_duplicate(scene, args[1].value_str.c_str(), (obs_scene_duplicate_type)args[2].value_union.i32);
+	obs_scene_duplicate_type type   = (obs_scene_duplicate_type)args[2].value_union.i32;
+	obs_scene_t*             scene2 = obs_scene_duplicate(scene, args[1].value_str.c_str(), type);
 	if (!scene2) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
 		rval.push_back(ipc::value("Failed to duplicate scene."));
@@ -321,6 +330,10 @@ void osn::Scene::Duplicate(
 		return;
 	}
 
+	// Private duplicates never go through the global source_create signal.
+	if (type == OBS_SCENE_DUP_PRIVATE_REFS || type == OBS_SCENE_DUP_PRIVATE_COPY)
+		osn::SceneItem::attach_scene_signals(source2);
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
 	AUTO_DEBUG;
@@ -358,7 +371,7 @@ void osn::Scene::AddSource(
 
 	obs_sceneitem_t* item = obs_scene_add(scene, added_source);
 
-	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().allocate(item);
+	utility::handle_table::id_t uid = osn::SceneItem::Manager::GetInstance().allocate(item);
 	if (uid == UINT64_MAX) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
 		rval.push_back(ipc::value("Index list is full."));
@@ -402,7 +415,7 @@ void osn::Scene::FindItemByName(
 		return;
 	}
 
-	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+	utility::handle_table::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
 	if (uid == UINT64_MAX) {
 		uid = osn::SceneItem::Manager::GetInstance().allocate(item);
 		if (uid == UINT64_MAX) {
@@ -449,7 +462,7 @@ void osn::Scene::FindItemByItemId(
 		return;
 	}
 
-	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+	utility::handle_table::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
 	if (uid == UINT64_MAX) {
 		uid = osn::SceneItem::Manager::GetInstance().allocate(item);
 		if (uid == UINT64_MAX) {
@@ -581,7 +594,7 @@ void osn::Scene::GetItem(
 		return;
 	}
 
-	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(ed.item);
+	utility::handle_table::id_t uid = osn::SceneItem::Manager::GetInstance().find(ed.item);
 	if (uid == UINT64_MAX) {
 		uid = osn::SceneItem::Manager::GetInstance().allocate(ed.item);
 		if (uid == UINT64_MAX) {
@@ -630,7 +643,7 @@ void osn::Scene::GetItems(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	for (obs_sceneitem_t* item : items) {
-		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+		utility::handle_table::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
 		if (uid == UINT64_MAX) {
 			uid = osn::SceneItem::Manager::GetInstance().allocate(item);
 			if (uid == UINT64_MAX) {
@@ -691,7 +704,7 @@ void osn::Scene::GetItemsInRange(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	for (obs_sceneitem_t* item : ed.items) {
-		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+		utility::handle_table::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
 		if (uid == UINT64_MAX) {
 			uid = osn::SceneItem::Manager::GetInstance().allocate(item);
 			if (uid == UINT64_MAX) {
@@ -707,6 +720,113 @@ void osn::Scene::GetItemsInRange(
 	AUTO_DEBUG;
 }
 
+void osn::Scene::GetSnapshot(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	obs_scene_t* scene = obs_scene_from_source(source);
+	if (!scene) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not a scene."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	struct EnumData
+	{
+		std::vector<scene_snapshot::item_record> records;
+		std::vector<char>                        strings;
+		bool                                     full = false;
+	} ed;
+
+	// Everything is read in the one pass, which holds the scene lock.
+	auto cb = [](obs_scene_t* scene, obs_sceneitem_t* item, void* data) {
+		EnumData* ed = reinterpret_cast<EnumData*>(data);
+
+		utility::handle_table::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+		if (uid == UINT64_MAX) {
+			uid = osn::SceneItem::Manager::GetInstance().allocate(item);
+			if (uid == UINT64_MAX) {
+				ed->full = true;
+				return false;
+			}
+			obs_sceneitem_addref(item);
+		}
+
+		obs_source_t*               item_source = obs_sceneitem_get_source(item);
+		utility::handle_table::id_t source_uid  = osn::Source::Manager::GetInstance().find(item_source);
+		int64_t                     item_id     = obs_sceneitem_get_id(item);
+
+		scene_snapshot::item_record record;
+		record.item_uid[0]   = uint32_t(uid);
+		record.item_uid[1]   = uint32_t(uid >> 32);
+		record.source_uid[0] = uint32_t(source_uid);
+		record.source_uid[1] = uint32_t(source_uid >> 32);
+		record.item_id[0]    = uint32_t(item_id);
+		record.item_id[1]    = uint32_t(uint64_t(item_id) >> 32);
+		record.source_type   = uint32_t(obs_source_get_type(item_source));
+		record.flags         = (obs_sceneitem_visible(item) ? scene_snapshot::visible : 0)
+		               | (obs_sceneitem_selected(item) ? scene_snapshot::selected : 0)
+		               | (obs_sceneitem_locked(item) ? scene_snapshot::locked : 0);
+
+		vec2 vec;
+		obs_sceneitem_get_pos(item, &vec);
+		record.pos[0] = vec.x;
+		record.pos[1] = vec.y;
+		obs_sceneitem_get_scale(item, &vec);
+		record.scale[0]  = vec.x;
+		record.scale[1]  = vec.y;
+		record.rot       = obs_sceneitem_get_rot(item);
+		record.alignment = obs_sceneitem_get_alignment(item);
+		obs_sceneitem_get_bounds(item, &vec);
+		record.bounds[0]        = vec.x;
+		record.bounds[1]        = vec.y;
+		record.bounds_type      = uint32_t(obs_sceneitem_get_bounds_type(item));
+		record.bounds_alignment = obs_sceneitem_get_bounds_alignment(item);
+
+		obs_sceneitem_crop crop;
+		obs_sceneitem_get_crop(item, &crop);
+		record.crop[0]      = crop.left;
+		record.crop[1]      = crop.top;
+		record.crop[2]      = crop.right;
+		record.crop[3]      = crop.bottom;
+		record.scale_filter = uint32_t(obs_sceneitem_get_scale_filter(item));
+		ed->records.push_back(record);
+
+		scene_snapshot::write_string(ed->strings, obs_source_get_name(item_source));
+		scene_snapshot::write_string(ed->strings, obs_source_get_id(item_source));
+		return true;
+	};
+	obs_scene_enum_items(scene, cb, &ed);
+
+	if (ed.full) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
+		rval.push_back(ipc::value("Index list is full."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	std::vector<char> records(ed.records.size() * sizeof(scene_snapshot::item_record));
+	if (!records.empty())
+		std::memcpy(records.data(), ed.records.data(), records.size());
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(uint32_t(ed.records.size())));
+	rval.push_back(ipc::value(records));
+	rval.push_back(ipc::value(ed.strings));
+	AUTO_DEBUG;
+}
+
 void osn::Scene::Connect(
     void*                          data,
     const int64_t                  id,
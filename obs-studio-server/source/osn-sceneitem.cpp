@@ -17,81 +17,244 @@
 ******************************************************************************/
 
 #include "osn-sceneitem.hpp"
+#include <cstring>
 #include <error.hpp>
+#include <mutex>
+#include <unordered_map>
+#include "event-frame.hpp"
+#include "osn-events.hpp"
 #include "osn-source.hpp"
+#include "sceneitem-batch.hpp"
 #include "shared.hpp"
+#include "util-callstats.h"
+
+// Transform and visibility of an item, compared to detect changes.
+struct ItemState
+{
+	vec2               pos;
+	vec2               scale;
+	obs_scale_type     scale_filter;
+	float              rot;
+	uint32_t           alignment;
+	vec2               bounds;
+	obs_bounds_type    bounds_type;
+	uint32_t           bounds_alignment;
+	obs_sceneitem_crop crop;
+	bool               visible;
+};
+
+struct TrackedItem
+{
+	ItemState state;
+	uint64_t  version = 0;
+};
+
+static std::mutex                                         tracked_mtx;
+static std::unordered_map<obs_sceneitem_t*, TrackedItem> tracked;
+// Versions to announce by item id, UINT64_MAX once the item is gone.
+static std::unordered_map<utility::handle_table::id_t, uint64_t> changed;
+
+// Field by field, so that padding and signed zeros never count as a change.
+static bool same_state(const ItemState& a, const ItemState& b)
+{
+	return (a.pos.x == b.pos.x) && (a.pos.y == b.pos.y) && (a.scale.x == b.scale.x) && (a.scale.y == b.scale.y)
+	       && (a.scale_filter == b.scale_filter) && (a.rot == b.rot) && (a.alignment == b.alignment)
+	       && (a.bounds.x == b.bounds.x) && (a.bounds.y == b.bounds.y) && (a.bounds_type == b.bounds_type)
+	       && (a.bounds_alignment == b.bounds_alignment) && (a.crop.left == b.crop.left)
+	       && (a.crop.top == b.crop.top) && (a.crop.right == b.crop.right) && (a.crop.bottom == b.crop.bottom)
+	       && (a.visible == b.visible);
+}
+
+static void capture(obs_sceneitem_t* item, ItemState& state)
+{
+	obs_sceneitem_get_pos(item, &state.pos);
+	obs_sceneitem_get_scale(item, &state.scale);
+	state.scale_filter = obs_sceneitem_get_scale_filter(item);
+	state.rot          = obs_sceneitem_get_rot(item);
+	state.alignment    = obs_sceneitem_get_alignment(item);
+	obs_sceneitem_get_bounds(item, &state.bounds);
+	state.bounds_type      = obs_sceneitem_get_bounds_type(item);
+	state.bounds_alignment = obs_sceneitem_get_bounds_alignment(item);
+	obs_sceneitem_get_crop(item, &state.crop);
+	state.visible = obs_sceneitem_visible(item);
+}
+
+// Captures the current state and moves the version forward if it differs
+//  from the last capture. The capture happens under tracked_mtx so versions
+//  never go back to older state.
+static bool refresh(obs_sceneitem_t* item, TrackedItem*& entry)
+{
+	ItemState state;
+	capture(item, state);
+
+	entry = &tracked[item];
+	if (entry->version != 0 && same_state(entry->state, state))
+		return false;
+
+	entry->state = state;
+	entry->version++;
+	return true;
+}
+
+static void item_changed_cb(void* data, calldata_t* cd)
+{
+	obs_sceneitem_t* item = nullptr;
+	if (!calldata_get_ptr(cd, "item", &item) || !item)
+		return;
+
+	osn::SceneItem::track(item, true);
+}
+
+static void item_removed_cb(void* data, calldata_t* cd)
+{
+	obs_sceneitem_t* item = nullptr;
+	if (!calldata_get_ptr(cd, "item", &item) || !item)
+		return;
+
+	osn::SceneItem::untrack(item, osn::SceneItem::Manager::GetInstance().find(item));
+}
+
+void osn::SceneItem::attach_scene_signals(obs_source_t* scene)
+{
+	signal_handler_t* sh = obs_source_get_signal_handler(scene);
+	if (!sh)
+		return;
+	signal_handler_connect(sh, "item_transform", item_changed_cb, nullptr);
+	signal_handler_connect(sh, "item_visible", item_changed_cb, nullptr);
+	signal_handler_connect(sh, "item_remove", item_removed_cb, nullptr);
+}
+
+uint64_t osn::SceneItem::track(obs_sceneitem_t* item, bool notify)
+{
+	// Items the client holds no id for can't be cached, and the manager lock
+	//  is never taken inside tracked_mtx.
+	utility::handle_table::id_t uid = UINT64_MAX;
+	if (notify) {
+		uid = Manager::GetInstance().find(item);
+		if (uid == UINT64_MAX)
+			return 0;
+	}
+
+	TrackedItem* entry;
+	uint64_t     version;
+	{
+		std::unique_lock<std::mutex> ulock(tracked_mtx);
+		if (!refresh(item, entry) || !notify)
+			return entry->version;
+		version      = entry->version;
+		changed[uid] = version;
+	}
+	osn::Events::Notify();
+	return version;
+}
+
+void osn::SceneItem::untrack(obs_sceneitem_t* item, utility::handle_table::id_t uid)
+{
+	{
+		std::unique_lock<std::mutex> ulock(tracked_mtx);
+		tracked.erase(item);
+		if (uid == UINT64_MAX)
+			return;
+		changed[uid] = UINT64_MAX;
+	}
+	osn::Events::Notify();
+}
+
+void osn::SceneItem::WriteEvents(std::vector<char>& buf)
+{
+	std::unique_lock<std::mutex> ulock(tracked_mtx);
+	if (changed.empty())
+		return;
+
+	event_frame::writer frame(buf, event_frame::type::scene_item);
+	frame.write(uint32_t(changed.size()));
+	for (auto& kv : changed) {
+		frame.write(uint64_t(kv.first));
+		frame.write(kv.second);
+	}
+	changed.clear();
+}
 
 void osn::SceneItem::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("SceneItem");
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetSource", std::vector<ipc::type>{ipc::type::UInt64}, GetSource));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetScene", std::vector<ipc::type>{ipc::type::UInt64}, GetScene));
-	cls->register_function(
-	    std::make_shared<ipc::function>("Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
-	cls->register_function(
-	    std::make_shared<ipc::function>("IsVisible", std::vector<ipc::type>{ipc::type::UInt64}, IsVisible));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetVisible", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetVisible));
-	cls->register_function(
-	    std::make_shared<ipc::function>("IsSelected", std::vector<ipc::type>{ipc::type::UInt64}, IsSelected));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetSelected", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetSelected));
+	    std::make_shared<util::TimedFunction>(cls, "GetSource", std::vector<ipc::type>{ipc::type::UInt64}, GetSource));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetPosition", std::vector<ipc::type>{ipc::type::UInt64}, GetPosition));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetPosition", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetPosition));
+	    std::make_shared<util::TimedFunction>(cls, "GetScene", std::vector<ipc::type>{ipc::type::UInt64}, GetScene));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetRotation", std::vector<ipc::type>{ipc::type::UInt64}, GetRotation));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetRotation", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetRotation));
+	    std::make_shared<util::TimedFunction>(cls, "Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetScale", std::vector<ipc::type>{ipc::type::UInt64}, GetScale));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetScale", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetScale));
+	    std::make_shared<util::TimedFunction>(cls, "IsVisible", std::vector<ipc::type>{ipc::type::UInt64}, IsVisible));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetVisible", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetVisible));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "IsSelected", std::vector<ipc::type>{ipc::type::UInt64}, IsSelected));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetSelected", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetSelected));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetPosition", std::vector<ipc::type>{ipc::type::UInt64}, GetPosition));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
+	    "SetPosition",
+	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float},
+	    SetPosition));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetRotation", std::vector<ipc::type>{ipc::type::UInt64}, GetRotation));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetRotation", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetRotation));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetScaleFilter", std::vector<ipc::type>{ipc::type::UInt64}, GetScaleFilter));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetScaleFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetScaleFilter));
+	    std::make_shared<util::TimedFunction>(cls, "GetScale", std::vector<ipc::type>{ipc::type::UInt64}, GetScale));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetScale", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetScale));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetScaleFilter", std::vector<ipc::type>{ipc::type::UInt64}, GetScaleFilter));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetScaleFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetScaleFilter));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetAlignment", std::vector<ipc::type>{ipc::type::UInt64}, GetAlignment));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetAlignment));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetAlignment", std::vector<ipc::type>{ipc::type::UInt64}, GetAlignment));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetAlignment));
+	    std::make_shared<util::TimedFunction>(cls, "GetBounds", std::vector<ipc::type>{ipc::type::UInt64}, GetBounds));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetBounds", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetBounds));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetBoundsAlignment", std::vector<ipc::type>{ipc::type::UInt64}, GetBoundsAlignment));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetBoundsAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBoundsAlignment));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetBoundsType", std::vector<ipc::type>{ipc::type::UInt64}, GetBoundsType));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetBoundsType", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetBoundsType));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetBounds", std::vector<ipc::type>{ipc::type::UInt64}, GetBounds));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetBounds", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetBounds));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetBoundsAlignment", std::vector<ipc::type>{ipc::type::UInt64}, GetBoundsAlignment));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetBoundsAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBoundsAlignment));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetBoundsType", std::vector<ipc::type>{ipc::type::UInt64}, GetBoundsType));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetBoundsType", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetBoundsType));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetCrop", std::vector<ipc::type>{ipc::type::UInt64}, GetCrop));
-	cls->register_function(std::make_shared<ipc::function>(
+	    std::make_shared<util::TimedFunction>(cls, "GetCrop", std::vector<ipc::type>{ipc::type::UInt64}, GetCrop));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
 	    "SetCrop",
 	    std::vector<ipc::type>{
 	        ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32, ipc::type::Int32, ipc::type::Int32},
 	    SetCrop));
-	cls->register_function(std::make_shared<ipc::function>("GetId", std::vector<ipc::type>{ipc::type::UInt64}, GetId));
-	cls->register_function(
-	    std::make_shared<ipc::function>("MoveUp", std::vector<ipc::type>{ipc::type::UInt64}, MoveUp));
-	cls->register_function(
-	    std::make_shared<ipc::function>("MoveDown", std::vector<ipc::type>{ipc::type::UInt64}, MoveDown));
 	cls->register_function(
-	    std::make_shared<ipc::function>("MoveTop", std::vector<ipc::type>{ipc::type::UInt64}, MoveTop));
+	    std::make_shared<util::TimedFunction>(cls, "GetId", std::vector<ipc::type>{ipc::type::UInt64}, GetId));
 	cls->register_function(
-	    std::make_shared<ipc::function>("MoveBottom", std::vector<ipc::type>{ipc::type::UInt64}, MoveBottom));
+	    std::make_shared<util::TimedFunction>(cls, "MoveUp", std::vector<ipc::type>{ipc::type::UInt64}, MoveUp));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Move", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, Move));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "DeferUpdateBegin", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateBegin));
+	    std::make_shared<util::TimedFunction>(cls, "MoveDown", std::vector<ipc::type>{ipc::type::UInt64}, MoveDown));
 	cls->register_function(
-	    std::make_shared<ipc::function>("DeferUpdateEnd", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateEnd));
+	    std::make_shared<util::TimedFunction>(cls, "MoveTop", std::vector<ipc::type>{ipc::type::UInt64}, MoveTop));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "MoveBottom", std::vector<ipc::type>{ipc::type::UInt64}, MoveBottom));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Move", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, Move));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "DeferUpdateBegin", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateBegin));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "DeferUpdateEnd", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateEnd));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "UpdateBatch", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, UpdateBatch));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetTransformInfo", std::vector<ipc::type>{ipc::type::UInt64}, GetTransformInfo));
 	srv.register_collection(cls);
 }
 
@@ -174,6 +337,7 @@ void osn::SceneItem::Remove(
 	}
 
 	osn::SceneItem::Manager::GetInstance().free(args[0].value_union.ui64);
+	untrack(item, args[0].value_union.ui64);
 	obs_sceneitem_release(item);
 	obs_sceneitem_remove(item);
 
@@ -218,6 +382,7 @@ void osn::SceneItem::SetVisible(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(obs_sceneitem_visible(item)));
+	rval.push_back(ipc::value(track(item, false)));
 	AUTO_DEBUG;
 }
 
@@ -308,6 +473,7 @@ void osn::SceneItem::SetPosition(
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(pos.x));
 	rval.push_back(ipc::value(pos.y));
+	rval.push_back(ipc::value(track(item, false)));
 	AUTO_DEBUG;
 }
 
@@ -348,6 +514,7 @@ void osn::SceneItem::SetRotation(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(obs_sceneitem_get_rot(item)));
+	rval.push_back(ipc::value(track(item, false)));
 	AUTO_DEBUG;
 }
 
@@ -398,6 +565,7 @@ void osn::SceneItem::SetScale(
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(scale.x));
 	rval.push_back(ipc::value(scale.y));
+	rval.push_back(ipc::value(track(item, false)));
 	AUTO_DEBUG;
 }
 
@@ -441,6 +609,7 @@ void osn::SceneItem::SetScaleFilter(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(type));
+	rval.push_back(ipc::value(track(item, false)));
 	AUTO_DEBUG;
 }
 
@@ -484,6 +653,7 @@ void osn::SceneItem::SetAlignment(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(align));
+	rval.push_back(ipc::value(track(item, false)));
 	AUTO_DEBUG;
 }
 
@@ -527,10 +697,12 @@ void osn::SceneItem::SetBounds(
 	bounds.x = args[1].value_union.fp32;
 	bounds.y = args[2].value_union.fp32;
 
+	obs_sceneitem_set_bounds(item, &bounds);
 	obs_sceneitem_get_bounds(item, &bounds);
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(bounds.x));
 	rval.push_back(ipc::value(bounds.y));
+	rval.push_back(ipc::value(track(item, false)));
 	AUTO_DEBUG;
 }
 
@@ -574,6 +746,7 @@ void osn::SceneItem::SetBoundsAlignment(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(align));
+	rval.push_back(ipc::value(track(item, false)));
 	AUTO_DEBUG;
 }
 
@@ -617,6 +790,7 @@ void osn::SceneItem::SetBoundsType(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(bounds));
+	rval.push_back(ipc::value(track(item, false)));
 	AUTO_DEBUG;
 }
 
@@ -673,6 +847,7 @@ void osn::SceneItem::SetCrop(
 	rval.push_back(ipc::value(crop.top));
 	rval.push_back(ipc::value(crop.right));
 	rval.push_back(ipc::value(crop.bottom));
+	rval.push_back(ipc::value(track(item, false)));
 	AUTO_DEBUG;
 }
 
@@ -833,9 +1008,174 @@ void osn::SceneItem::DeferUpdateEnd(
 	AUTO_DEBUG;
 }
 
+struct BatchData
+{
+	std::vector<sceneitem_batch::command> commands;
+	std::vector<obs_sceneitem_t*>         items;
+	std::vector<uint32_t>                 status;
+};
+
+static void apply_command(obs_sceneitem_t* item, const sceneitem_batch::command& cmd)
+{
+	vec2 vec;
+	if (cmd.mask & sceneitem_batch::position) {
+		vec2_set(&vec, cmd.pos[0], cmd.pos[1]);
+		obs_sceneitem_set_pos(item, &vec);
+	}
+	if (cmd.mask & sceneitem_batch::scale) {
+		vec2_set(&vec, cmd.scale[0], cmd.scale[1]);
+		obs_sceneitem_set_scale(item, &vec);
+	}
+	if (cmd.mask & sceneitem_batch::rotation)
+		obs_sceneitem_set_rot(item, cmd.rot);
+	if (cmd.mask & sceneitem_batch::alignment)
+		obs_sceneitem_set_alignment(item, cmd.alignment);
+	if (cmd.mask & sceneitem_batch::bounds) {
+		vec2_set(&vec, cmd.bounds[0], cmd.bounds[1]);
+		obs_sceneitem_set_bounds(item, &vec);
+	}
+	if (cmd.mask & sceneitem_batch::bounds_type)
+		obs_sceneitem_set_bounds_type(item, (obs_bounds_type)cmd.bounds_type);
+	if (cmd.mask & sceneitem_batch::bounds_alignment)
+		obs_sceneitem_set_bounds_alignment(item, cmd.bounds_alignment);
+	if (cmd.mask & sceneitem_batch::crop) {
+		obs_sceneitem_crop crop;
+		crop.left   = cmd.crop[0];
+		crop.top    = cmd.crop[1];
+		crop.right  = cmd.crop[2];
+		crop.bottom = cmd.crop[3];
+		obs_sceneitem_set_crop(item, &crop);
+	}
+	if (cmd.mask & sceneitem_batch::scale_filter)
+		obs_sceneitem_set_scale_filter(item, (obs_scale_type)cmd.scale_filter);
+	if (cmd.mask & sceneitem_batch::visible)
+		obs_sceneitem_set_visible(item, !!cmd.visible);
+	if (cmd.mask & sceneitem_batch::selected)
+		obs_sceneitem_select(item, !!cmd.selected);
+}
+
+static void apply_batch(void* data, obs_scene_t* scene)
+{
+	BatchData* bd = reinterpret_cast<BatchData*>(data);
+
+	for (size_t idx = 0; idx < bd->commands.size(); idx++) {
+		obs_sceneitem_t* item = bd->items[idx];
+		if (!item || obs_sceneitem_get_scene(item) != scene) {
+			bd->status[idx] = uint32_t(ErrorCode::InvalidReference);
+			continue;
+		}
+
+		// One transform update per command instead of one per field.
+		obs_sceneitem_defer_update_begin(item);
+		apply_command(item, bd->commands[idx]);
+		obs_sceneitem_defer_update_end(item);
+
+		// Moves the version forward now, the transform signal then finds
+		//  nothing new to announce.
+		osn::SceneItem::track(item, false);
+		bd->status[idx] = uint32_t(ErrorCode::Ok);
+	}
+}
+
+void osn::SceneItem::UpdateBatch(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	obs_scene_t* scene = obs_scene_from_source(source);
+	if (!scene) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not a scene."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	std::vector<char> const& buf = args[1].value_bin;
+	if (buf.size() % sizeof(sceneitem_batch::command) != 0) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Malformed batch."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	BatchData bd;
+	bd.commands.resize(buf.size() / sizeof(sceneitem_batch::command));
+	if (!buf.empty())
+		std::memcpy(bd.commands.data(), buf.data(), buf.size());
+
+	// Handles are resolved before taking the scene lock.
+	bd.items.resize(bd.commands.size());
+	bd.status.resize(bd.commands.size());
+	for (size_t idx = 0; idx < bd.commands.size(); idx++)
+		bd.items[idx] = Manager::GetInstance().find(bd.commands[idx].item_uid);
+
+	obs_scene_atomic_update(scene, apply_batch, &bd);
+
+	std::vector<char> status(bd.status.size() * sizeof(uint32_t));
+	if (!status.empty())
+		std::memcpy(status.data(), bd.status.data(), status.size());
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(status));
+	AUTO_DEBUG;
+}
+
 osn::SceneItem::Manager& osn::SceneItem::Manager::GetInstance()
 {
 	// Thread Safe since C++13 (Visual Studio 2015, GCC 4.3).
 	static Manager instance;
 	return instance;
 }
+
+void osn::SceneItem::GetTransformInfo(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_sceneitem_t* item = osn::SceneItem::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!item) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Item reference is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	TrackedItem tracked_item;
+	{
+		std::unique_lock<std::mutex> ulock(tracked_mtx);
+		TrackedItem*                 entry;
+		refresh(item, entry);
+		tracked_item = *entry;
+	}
+	ItemState& state = tracked_item.state;
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(state.pos.x));
+	rval.push_back(ipc::value(state.pos.y));
+	rval.push_back(ipc::value(state.scale.x));
+	rval.push_back(ipc::value(state.scale.y));
+	rval.push_back(ipc::value(uint32_t(state.scale_filter)));
+	rval.push_back(ipc::value(state.rot));
+	rval.push_back(ipc::value(state.alignment));
+	rval.push_back(ipc::value(state.bounds.x));
+	rval.push_back(ipc::value(state.bounds.y));
+	rval.push_back(ipc::value(uint32_t(state.bounds_type)));
+	rval.push_back(ipc::value(state.bounds_alignment));
+	rval.push_back(ipc::value(state.crop.left));
+	rval.push_back(ipc::value(state.crop.top));
+	rval.push_back(ipc::value(state.crop.right));
+	rval.push_back(ipc::value(state.crop.bottom));
+	rval.push_back(ipc::value(state.visible));
+	rval.push_back(ipc::value(tracked_item.version));
+	AUTO_DEBUG;
+}
@@ -18,6 +18,7 @@
 
 #pragma once
 #include <ipc-server.hpp>
+#include <vector>
 #include <obs.h>
 #include <utility.hpp>
 
@@ -45,6 +46,15 @@ namespace osn
 		public:
 		static void Register(ipc::server&);
 
+		// Change tracking for client side caches. Every item carries a version
+		//  that moves forward whenever its transform or visibility changes,
+		//  setters reply with it and changes made by anyone else are announced
+		//  as scene_item events.
+		static void     attach_scene_signals(obs_source_t* scene);
+		static uint64_t track(obs_sceneitem_t* item, bool notify);
+		static void     untrack(obs_sceneitem_t* item, utility::handle_table::id_t uid);
+		static void     WriteEvents(std::vector<char>& buf);
+
 		static void
 		    GetSource(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 		static void
@@ -169,5 +179,15 @@ namespace osn
 		    const int64_t                  id,
 		    const std::vector<ipc::value>& args,
 		    std::vector<ipc::value>&       rval);
+		static void UpdateBatch(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+		static void GetTransformInfo(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
 	};
 } // namespace osn
@@ -21,27 +21,125 @@
 #include <ipc-function.hpp>
 #include <ipc-server.hpp>
 #include <ipc-value.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <obs-data.h>
 #include <obs.h>
 #include <obs.hpp>
 #include "error.hpp"
 #include "obs-property.hpp"
 #include "osn-common.hpp"
+#include "osn-sceneitem.hpp"
 #include "shared.hpp"
 #include "callback-manager.h"
+#include "util-callstats.h"
+
+// Settings patches received since the last flush, applied with a single
+//  obs_source_update per source by the patch worker, at most once per video
+//  frame. Every source in here holds a reference until its patch is applied.
+//  Patches are applied under patches_apply_mtx, taken before patches_mtx, so a
+//  patch can never be applied after a later full update of its source.
+static std::mutex                                     patches_mtx;
+static std::mutex                                     patches_apply_mtx;
+static std::condition_variable                        patches_cv;
+static std::thread                                    patches_worker;
+static bool                                           patches_running = false;
+static std::unordered_map<obs_source_t*, obs_data_t*> patches;
+
+static void apply_patches(std::unordered_map<obs_source_t*, obs_data_t*>& ready)
+{
+	for (auto& kv : ready) {
+		obs_source_update(kv.first, kv.second);
+		obs_data_release(kv.second);
+		obs_source_release(kv.first);
+	}
+}
+
+static void flush_patches()
+{
+	std::unique_lock<std::mutex>                   alock(patches_apply_mtx);
+	std::unordered_map<obs_source_t*, obs_data_t*> ready;
+	{
+		std::unique_lock<std::mutex> ulock(patches_mtx);
+		ready.swap(patches);
+	}
+	apply_patches(ready);
+}
+
+// Applies the pending patch of 'src' right away, for calls that must observe
+//  or come after it.
+static void flush_patch(obs_source_t* src)
+{
+	std::unique_lock<std::mutex>                   alock(patches_apply_mtx);
+	std::unordered_map<obs_source_t*, obs_data_t*> ready;
+	{
+		std::unique_lock<std::mutex> ulock(patches_mtx);
+		auto                         kv = patches.find(src);
+		if (kv == patches.end())
+			return;
+		ready.insert(*kv);
+		patches.erase(kv);
+	}
+	apply_patches(ready);
+}
+
+static std::chrono::nanoseconds patch_interval()
+{
+	video_t* video = obs_get_video();
+	return std::chrono::nanoseconds(video ? video_output_get_frame_time(video) : 16666667);
+}
+
+// Runs off the graphics thread: audio sources update synchronously, and
+//  reopening a device there would stall rendering.
+static void patch_worker()
+{
+	std::unique_lock<std::mutex> ulock(patches_mtx);
+	while (patches_running) {
+		if (patches.empty()) {
+			patches_cv.wait(ulock);
+			continue;
+		}
+
+		// Give the rest of the frame's patches a chance to be merged in.
+		patches_cv.wait_for(ulock, patch_interval(), [] { return !patches_running; });
+
+		ulock.unlock();
+		flush_patches();
+		ulock.lock();
+	}
+}
 
 void osn::Source::initialize_global_signals()
 {
 	signal_handler_t* sh = obs_get_signal_handler();
 	signal_handler_connect(sh, "source_create", osn::Source::global_source_create_cb, nullptr);
+	CallbackManager::initialize();
+	{
+		std::unique_lock<std::mutex> ulock(patches_mtx);
+		patches_running = true;
+	}
+	patches_worker = std::thread(patch_worker);
 }
 
 void osn::Source::finalize_global_signals()
 {
+	{
+		std::unique_lock<std::mutex> ulock(patches_mtx);
+		patches_running = false;
+	}
+	patches_cv.notify_all();
+	if (patches_worker.joinable())
+		patches_worker.join();
+	flush_patches();
 	signal_handler_t* sh = obs_get_signal_handler();
 	signal_handler_disconnect(sh, "source_create", osn::Source::global_source_create_cb, nullptr);
+	CallbackManager::finalize();
 }
 
 void osn::Source::attach_source_signals(obs_source_t* src)
@@ -70,6 +168,8 @@ void osn::Source::global_source_create_cb(void* ptr, calldata_t* cd)
 	osn::Source::Manager::GetInstance().allocate(source);
 	osn::Source::attach_source_signals(source);
 	CallbackManager::addSource(source);
+	if (strcmp(obs_source_get_id(source), "scene") == 0)
+		osn::SceneItem::attach_scene_signals(source);
 }
 
 void osn::Source::global_source_destroy_cb(void* ptr, calldata_t* cd)
@@ -81,81 +181,72 @@ void osn::Source::global_source_destroy_cb(void* ptr, calldata_t* cd)
 
 	CallbackManager::removeSource(source);
 	detach_source_signals(source);
+	{
+		std::unique_lock<std::mutex> ulock(snapshots_mtx);
+		snapshots.erase(source);
+	}
 	osn::Source::Manager::GetInstance().free(source);
 }
 
 void osn::Source::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Source");
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetDefaults", std::vector<ipc::type>{ipc::type::String}, GetTypeDefaults));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetProperties", std::vector<ipc::type>{ipc::type::String}, GetTypeProperties));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetOutputFlags", std::vector<ipc::type>{ipc::type::String}, GetTypeOutputFlags));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetDefaults", std::vector<ipc::type>{ipc::type::String}, GetTypeDefaults));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetProperties", std::vector<ipc::type>{ipc::type::String}, GetTypeProperties));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetOutputFlags", std::vector<ipc::type>{ipc::type::String}, GetTypeOutputFlags));
 
 	cls->register_function(
-	    std::make_shared<ipc::function>("Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
-	cls->register_function(
-	    std::make_shared<ipc::function>("Release", std::vector<ipc::type>{ipc::type::UInt64}, Release));
-	cls->register_function(
-	    std::make_shared<ipc::function>("IsConfigurable", std::vector<ipc::type>{ipc::type::UInt64}, IsConfigurable));
+	    std::make_shared<util::TimedFunction>(cls, "Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetProperties", std::vector<ipc::type>{ipc::type::UInt64}, GetProperties));
+	    std::make_shared<util::TimedFunction>(cls, "Release", std::vector<ipc::type>{ipc::type::UInt64}, Release));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "IsConfigurable", std::vector<ipc::type>{ipc::type::UInt64}, IsConfigurable));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetProperties", std::vector<ipc::type>{ipc::type::UInt64}, GetProperties));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetPropertiesDiff", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, GetPropertiesDiff));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetSettings", std::vector<ipc::type>{ipc::type::UInt64}, GetSettings));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetSettings", std::vector<ipc::type>{ipc::type::UInt64}, GetSettings));
-	cls->register_function(std::make_shared<ipc::function>("Load", std::vector<ipc::type>{ipc::type::UInt64}, Load));
-	cls->register_function(std::make_shared<ipc::function>("Save", std::vector<ipc::type>{ipc::type::UInt64}, Save));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Update", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Update));
+	    std::make_shared<util::TimedFunction>(cls, "Load", std::vector<ipc::type>{ipc::type::UInt64}, Load));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetType", std::vector<ipc::type>{ipc::type::UInt64}, GetType));
+	    std::make_shared<util::TimedFunction>(cls, "Save", std::vector<ipc::type>{ipc::type::UInt64}, Save));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Update", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Update));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Update", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, Update));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Patch", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, Patch));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetName", std::vector<ipc::type>{ipc::type::UInt64}, GetName));
+	    std::make_shared<util::TimedFunction>(cls, "GetType", std::vector<ipc::type>{ipc::type::UInt64}, GetType));
 	cls->register_function(
-	    std::make_shared<ipc::function>("SetName", std::vector<ipc::type>{ipc::type::UInt64}, SetName));
+	    std::make_shared<util::TimedFunction>(cls, "GetName", std::vector<ipc::type>{ipc::type::UInt64}, GetName));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetOutputFlags", std::vector<ipc::type>{ipc::type::UInt64}, GetOutputFlags));
+	    std::make_shared<util::TimedFunction>(cls, "SetName", std::vector<ipc::type>{ipc::type::UInt64}, SetName));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetOutputFlags", std::vector<ipc::type>{ipc::type::UInt64}, GetOutputFlags));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetFlags", std::vector<ipc::type>{ipc::type::UInt64}, GetFlags));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetFlags", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetFlags));
+	    std::make_shared<util::TimedFunction>(cls, "GetFlags", std::vector<ipc::type>{ipc::type::UInt64}, GetFlags));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetFlags", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetFlags));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetStatus", std::vector<ipc::type>{ipc::type::UInt64}, GetStatus));
-	cls->register_function(std::make_shared<ipc::function>("GetId", std::vector<ipc::type>{ipc::type::UInt64}, GetId));
+	    std::make_shared<util::TimedFunction>(cls, "GetStatus", std::vector<ipc::type>{ipc::type::UInt64}, GetStatus));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetMuted", std::vector<ipc::type>{ipc::type::UInt64}, GetMuted));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetMuted", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetMuted));
+	    std::make_shared<util::TimedFunction>(cls, "GetId", std::vector<ipc::type>{ipc::type::UInt64}, GetId));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetEnabled", std::vector<ipc::type>{ipc::type::UInt64}, GetEnabled));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetEnabled", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetEnabled));
+	    std::make_shared<util::TimedFunction>(cls, "GetMuted", std::vector<ipc::type>{ipc::type::UInt64}, GetMuted));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetMuted", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetMuted));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetEnabled", std::vector<ipc::type>{ipc::type::UInt64}, GetEnabled));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetEnabled", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetEnabled));
 	srv.register_collection(cls);
 }
 
-void osn::Source::GetTypeProperties(
-    void*                          data,
-    const int64_t                  id,
-    const std::vector<ipc::value>& args,
-    std::vector<ipc::value>&       rval)
-{
-	AUTO_DEBUG;
-	// Per Type Properties (doesn't have an object).
-	//obs_get_source_properties();
-}
-
-void osn::Source::GetTypeDefaults(
-    void*                          data,
-    const int64_t                  id,
-    const std::vector<ipc::value>& args,
-    std::vector<ipc::value>&       rval)
-{
-	AUTO_DEBUG;
-	// Per Type Defaults (doesn't have an object)
-	//obs_get_source_defaults();
-}
-
 void osn::Source::GetTypeOutputFlags(
     void*                          data,
     const int64_t                  id,
@@ -229,29 +320,34 @@ void osn::Source::IsConfigurable(
 	AUTO_DEBUG;
 }
 
-void osn::Source::GetProperties(
-    void*                          data,
-    const int64_t                  id,
-    const std::vector<ipc::value>& args,
-    std::vector<ipc::value>&       rval)
+// Serialized properties of a source, in order, sharing a single arena.
+struct SerializedProperties
 {
-	// Attempt to find the source asked to load.
-	obs_source_t* src = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
-	if (src == nullptr) {
-		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
-		rval.push_back(ipc::value("Source reference is not valid."));
-		AUTO_DEBUG;
-		return;
-	}
-
-	obs_properties_t* prp = obs_source_properties(src);
-	const char*       buf;
+	std::vector<std::string>         names;
+	std::vector<obs::Property::Type> types;
+	std::vector<char>                arena;
+	// Offset and size of every record within the arena, size prefix included.
+	std::vector<std::pair<size_t, size_t>> records;
+};
+
+// Last properties sent by GetPropertiesDiff per source, the base of the next delta.
+struct PropertiesSnapshot
+{
+	uint64_t             version = 0;
+	SerializedProperties props;
+};
 
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+static std::mutex                                            snapshots_mtx;
+static std::unordered_map<obs_source_t*, PropertiesSnapshot> snapshots;
 
-	obs_data* settings = obs_source_get_settings(src);
-	bool      updateSource = false;
+// Serializes 'prp' with the values found in 'settings'. Returns true if a list
+//  without a value was set to its first item in 'settings'.
+static bool serialize_properties(obs_properties_t* prp, obs_data_t* settings, SerializedProperties& out)
+{
+	const char* buf;
+	bool        updateSource = false;
 
+	obs::PropertyWriter w(out.arena);
 	for (obs_property_t* p = obs_properties_first(prp); (p != nullptr); obs_property_next(&p)) {
 		std::shared_ptr<obs::Property> prop;
 		const char*                    name = obs_property_name(p);
@@ -416,19 +512,144 @@ void osn::Source::GetProperties(
 		prop->enabled          = obs_property_enabled(p);
 		prop->visible          = obs_property_visible(p);
 
-		std::vector<char> buf(prop->size());
-		if (prop->serialize(buf)) {
-			rval.push_back(ipc::value(buf));
-		}
+		size_t offset = out.arena.size();
+		prop->serialize(w);
+		out.names.push_back(prop->name);
+		out.types.push_back(prop->type());
+		out.records.emplace_back(offset, out.arena.size() - offset);
 	}
-	obs_properties_destroy(prp);
+	return updateSource;
+}
 
-	if (updateSource)
+static void serialize_properties(obs_source_t* src, SerializedProperties& out)
+{
+	obs_properties_t* prp      = obs_source_properties(src);
+	obs_data_t*       settings = obs_source_get_settings(src);
+
+	if (serialize_properties(prp, settings, out))
 		obs_source_update(src, settings);
+
+	obs_properties_destroy(prp);
+	obs_data_release(settings);
+}
+
+// Type properties and defaults only change when modules load or the locale
+//  changes, so they are built once per type and locale. Types with list
+//  properties are the exception: those lists are often live enumerations of
+//  devices, windows or monitors, so their properties are rebuilt every time.
+struct TypeInfo
+{
+	SerializedProperties properties;
+	std::string          defaults;
+	bool                 live = false;
+};
+
+static std::mutex                                              type_infos_mtx;
+static std::map<std::pair<std::string, std::string>, TypeInfo> type_infos;
+
+// Serializes the properties of 'type' filled with 'values'. Returns true if
+//  they hold a list.
+static bool serialize_type_properties(const char* type, obs_data_t* values, SerializedProperties& out)
+{
+	obs_properties_t* prp = obs_get_source_properties(type);
+	if (prp == nullptr)
+		return false;
+
+	bool lists = false;
+	for (obs_property_t* p = obs_properties_first(prp); (p != nullptr) && !lists; obs_property_next(&p))
+		lists = obs_property_get_type(p) == OBS_PROPERTY_LIST;
+
+	serialize_properties(prp, values, out);
+	obs_properties_destroy(prp);
+	return lists;
+}
+
+// Returns null for unknown types. type_infos_mtx must be held.
+static TypeInfo* find_type_info(const std::string& type)
+{
+	const char* locale = obs_get_locale();
+	auto        key    = std::make_pair(type, std::string(locale ? locale : ""));
+	auto        kv     = type_infos.find(key);
+	if (kv != type_infos.end())
+		return &kv->second;
+
+	obs_data_t* defaults = obs_get_source_defaults(type.c_str());
+	if (defaults == nullptr)
+		return nullptr;
+
+	TypeInfo&   info   = type_infos[key];
+	obs_data_t* values = obs_data_get_defaults(defaults);
+	const char* json   = obs_data_get_json(values);
+	info.defaults      = json ? json : "";
+
+	info.live = serialize_type_properties(type.c_str(), values, info.properties);
+	if (info.live)
+		info.properties = SerializedProperties();
+
+	obs_data_release(values);
+	obs_data_release(defaults);
+	return &info;
+}
+
+void osn::Source::InvalidateTypeInfo()
+{
+	std::unique_lock<std::mutex> ulock(type_infos_mtx);
+	type_infos.clear();
+}
+
+void osn::Source::GetTypeProperties(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::unique_lock<std::mutex> ulock(type_infos_mtx);
+	TypeInfo*                    info = find_type_info(args[0].value_str);
+	if (info == nullptr) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source type is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	if (info->live) {
+		SerializedProperties properties;
+		obs_data_t*          values = obs_data_create_from_json(info->defaults.c_str());
+		serialize_type_properties(args[0].value_str.c_str(), values, properties);
+		obs_data_release(values);
+
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+		rval.push_back(ipc::value(properties.arena));
+		AUTO_DEBUG;
+		return;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(info->properties.arena));
 	AUTO_DEBUG;
 }
 
-void osn::Source::GetSettings(
+void osn::Source::GetTypeDefaults(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::unique_lock<std::mutex> ulock(type_infos_mtx);
+	TypeInfo*                    info = find_type_info(args[0].value_str);
+	if (info == nullptr) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source type is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(info->defaults));
+	AUTO_DEBUG;
+}
+
+void osn::Source::GetProperties(
     void*                          data,
     const int64_t                  id,
     const std::vector<ipc::value>& args,
@@ -443,10 +664,148 @@ void osn::Source::GetSettings(
 		return;
 	}
 
-	obs_data_t* sets = obs_source_get_settings(src);
+	flush_patch(src);
+
+	SerializedProperties props;
+	serialize_properties(src, props);
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	rval.push_back(ipc::value(obs_data_get_full_json(sets)));
+	rval.push_back(ipc::value(props.arena));
+	AUTO_DEBUG;
+}
+
+// A delta can only be applied if every property kept from 'from' keeps its
+//  type and its order relative to the other kept properties.
+static bool can_delta(const SerializedProperties& from, const SerializedProperties& to)
+{
+	std::unordered_map<std::string, size_t> index;
+	for (size_t idx = 0; idx < from.names.size(); idx++)
+		index.emplace(from.names[idx], idx);
+
+	size_t last  = 0;
+	bool   first = true;
+	for (size_t idx = 0; idx < to.names.size(); idx++) {
+		auto kv = index.find(to.names[idx]);
+		if (kv == index.end())
+			continue;
+		if (from.types[kv->second] != to.types[idx] || (!first && kv->second <= last))
+			return false;
+		last  = kv->second;
+		first = false;
+	}
+	return true;
+}
+
+static bool same_record(const SerializedProperties& a, size_t ia, const SerializedProperties& b, size_t ib)
+{
+	const auto& ra = a.records[ia];
+	const auto& rb = b.records[ib];
+	return (ra.second == rb.second) && (std::memcmp(&a.arena[ra.first], &b.arena[rb.first], ra.second) == 0);
+}
+
+void osn::Source::GetPropertiesDiff(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Attempt to find the source asked to load.
+	obs_source_t* src = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (src == nullptr) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
+	uint64_t known = args[1].value_union.ui64;
+
+	flush_patch(src);
+
+	// Properties are always rebuilt, only what goes over the wire shrinks.
+	SerializedProperties props;
+	serialize_properties(src, props);
+
+	std::unique_lock<std::mutex> ulock(snapshots_mtx);
+	PropertiesSnapshot&          last = snapshots[src];
+
+	bool     changed = (last.version == 0) || (last.props.names != props.names) || (last.props.arena != props.arena);
+	uint64_t version = changed ? last.version + 1 : last.version;
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(version));
+	if (known == version) {
+		rval.push_back(ipc::value(uint32_t(obs::PropertiesDiff::Unchanged)));
+	} else if (known != 0 && known == last.version && can_delta(last.props, props)) {
+		rval.push_back(ipc::value(uint32_t(obs::PropertiesDiff::Delta)));
+
+		std::unordered_map<std::string, size_t> index;
+		for (size_t idx = 0; idx < last.props.names.size(); idx++)
+			index.emplace(last.props.names[idx], idx);
+
+		std::vector<size_t> upserts;
+		for (size_t idx = 0; idx < props.names.size(); idx++) {
+			auto kv = index.find(props.names[idx]);
+			if (kv == index.end()) {
+				upserts.push_back(idx);
+				continue;
+			}
+			if (!same_record(last.props, kv->second, props, idx))
+				upserts.push_back(idx);
+			index.erase(kv);
+		}
+
+		// Whatever is left in the index is gone.
+		rval.push_back(ipc::value(uint32_t(index.size())));
+		for (auto& kv : index)
+			rval.push_back(ipc::value(kv.first));
+
+		std::vector<char>   indices(upserts.size() * sizeof(uint32_t));
+		std::vector<char>   arena;
+		obs::PropertyWriter w(arena);
+		for (size_t n = 0; n < upserts.size(); n++) {
+			uint32_t    at     = uint32_t(upserts[n]);
+			const auto& record = props.records[at];
+			std::memcpy(&indices[n * sizeof(uint32_t)], &at, sizeof(uint32_t));
+			w.append(&props.arena[record.first], record.second);
+		}
+		rval.push_back(ipc::value(indices));
+		rval.push_back(ipc::value(arena));
+	} else {
+		rval.push_back(ipc::value(uint32_t(obs::PropertiesDiff::Full)));
+		rval.push_back(ipc::value(props.arena));
+	}
+
+	if (changed) {
+		last.version = version;
+		last.props   = std::move(props);
+	}
+	AUTO_DEBUG;
+}
+
+void osn::Source::GetSettings(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Attempt to find the source asked to load.
+	obs_source_t* src = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (src == nullptr) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	flush_patch(src);
+
+	obs_data_t*       sets = obs_source_get_settings(src);
+	std::vector<char> buf;
+	osn::common::EncodeData(sets, buf);
 	obs_data_release(sets);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(buf));
 	AUTO_DEBUG;
 }
 
@@ -465,7 +824,15 @@ void osn::Source::Update(
 		return;
 	}
 
-	obs_data_t* sets = obs_data_create_from_json(args[1].value_str.c_str());
+	flush_patch(src);
+
+	obs_data_t* sets = osn::common::DataFromValue(args[1]);
+	if (!sets && args[1].type == ipc::type::Binary) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Settings are malformed."));
+		AUTO_DEBUG;
+		return;
+	}
 	obs_source_update(src, sets);
 	obs_data_release(sets);
 
@@ -473,6 +840,116 @@ void osn::Source::Update(
 	AUTO_DEBUG;
 }
 
+// Returns the object holding the last key of 'path' inside 'scratch', with a
+//  reference, and stores that key in 'key'. Objects missing from the scratch
+//  patch are seeded from the pending patch, or else from the current settings,
+//  since nested objects are replaced as a whole when merged and updated.
+static obs_data_t*
+    resolve_patch_path(obs_data_t* scratch, obs_data_t* pending, obs_data_t* current, const char* path, std::string& key)
+{
+	obs_data_t* parent   = scratch;
+	obs_data_t* bases[2] = {pending, current};
+	obs_data_addref(parent);
+	for (obs_data_t* base : bases)
+		obs_data_addref(base);
+
+	const char* dot;
+	while ((dot = std::strchr(path, '.')) != nullptr) {
+		key.assign(path, dot - path);
+		path = dot + 1;
+
+		obs_data_t* child_bases[2];
+		for (size_t idx = 0; idx < 2; idx++)
+			child_bases[idx] = bases[idx] ? obs_data_get_obj(bases[idx], key.c_str()) : nullptr;
+
+		obs_data_t* child = obs_data_get_obj(parent, key.c_str());
+		if (!child) {
+			obs_data_t* seed = child_bases[0] ? child_bases[0] : child_bases[1];
+			child            = seed ? obs_data_create_from_json(obs_data_get_json(seed)) : obs_data_create();
+			obs_data_set_obj(parent, key.c_str(), child);
+		}
+
+		obs_data_release(parent);
+		for (size_t idx = 0; idx < 2; idx++) {
+			obs_data_release(bases[idx]);
+			bases[idx] = child_bases[idx];
+		}
+		parent = child;
+	}
+
+	for (obs_data_t* base : bases)
+		obs_data_release(base);
+	key = path;
+	return parent;
+}
+
+void osn::Source::Patch(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Attempt to find the source asked to load.
+	obs_source_t* src = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (src == nullptr) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	obs_data_binary::reader r(args[1].value_bin);
+	uint32_t                count = 0;
+	bool                    valid = r.read(count);
+
+	// Decoded on its own first, a malformed patch must leave nothing behind.
+	obs_data_t* scratch = obs_data_create();
+	obs_data_t* current = obs_source_get_settings(src);
+	{
+		std::unique_lock<std::mutex> ulock(patches_mtx);
+		auto                         found   = patches.find(src);
+		obs_data_t*                  pending = found != patches.end() ? found->second : nullptr;
+
+		std::string key;
+		for (uint32_t idx = 0; valid && idx < count; idx++) {
+			const char* path   = nullptr;
+			uint32_t    length = 0;
+			uint8_t     type   = 0;
+			if (!r.read(path, length) || !r.read(type)) {
+				valid = false;
+				break;
+			}
+
+			obs_data_t* parent =
+			    resolve_patch_path(scratch, pending, current, std::string(path, length).c_str(), key);
+			valid = osn::common::DecodeValue(r, type, parent, key);
+			obs_data_release(parent);
+		}
+
+		if (valid && count > 0) {
+			if (!pending) {
+				pending = obs_data_create();
+				obs_source_addref(src);
+				patches.emplace(src, pending);
+				patches_cv.notify_one();
+			}
+			obs_data_apply(pending, scratch);
+		}
+	}
+	obs_data_release(current);
+	obs_data_release(scratch);
+
+	if (!valid) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Patch is malformed."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
 void osn::Source::Load(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
 {
 	// Attempt to find the source asked to load.
@@ -501,6 +978,7 @@ void osn::Source::Save(void* data, const int64_t id, const std::vector<ipc::valu
 		return;
 	}
 
+	flush_patch(src);
 	obs_source_save(src);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -53,6 +53,9 @@ namespace osn
 		public:
 		static void Register(ipc::server&);
 
+		// Drops the cached type properties and defaults.
+		static void InvalidateTypeInfo();
+
 		// Type Info
 		static void GetTypeProperties(
 		    void*                          data,
@@ -87,6 +90,11 @@ namespace osn
 		    const int64_t                  id,
 		    const std::vector<ipc::value>& args,
 		    std::vector<ipc::value>&       rval);
+		static void GetPropertiesDiff(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
 		static void GetSettings(
 		    void*                          data,
 		    const int64_t                  id,
@@ -94,6 +102,8 @@ namespace osn
 		    std::vector<ipc::value>&       rval);
 		static void
 		    Update(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void
+		    Patch(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 		static void
 		    Load(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 		static void
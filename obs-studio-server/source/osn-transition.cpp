@@ -23,34 +23,38 @@
 #include "error.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
+#include "util-callstats.h"
 
 void osn::Transition::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Transition");
-	cls->register_function(std::make_shared<ipc::function>("Types", std::vector<ipc::type>{}, Types));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(std::make_shared<util::TimedFunction>(cls, "Types", std::vector<ipc::type>{}, Types));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
 	    "Create",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String, ipc::type::String},
 	    Create));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "CreatePrivate", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, CreatePrivate));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "CreatePrivate", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, CreatePrivate));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls,
 	    "CreatePrivate",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String},
 	    CreatePrivate));
 	cls->register_function(
-	    std::make_shared<ipc::function>("FromName", std::vector<ipc::type>{ipc::type::UInt64}, FromName));
+	    std::make_shared<util::TimedFunction>(cls, "FromName", std::vector<ipc::type>{ipc::type::UInt64}, FromName));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetActiveSource", std::vector<ipc::type>{ipc::type::UInt64}, GetActiveSource));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetActiveSource", std::vector<ipc::type>{ipc::type::UInt64}, GetActiveSource));
-	cls->register_function(std::make_shared<ipc::function>("Clear", std::vector<ipc::type>{ipc::type::UInt64}, Clear));
-	cls->register_function(
-	    std::make_shared<ipc::function>("Set", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Set));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Start", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32, ipc::type::UInt64}, Start));
+	    std::make_shared<util::TimedFunction>(cls, "Clear", std::vector<ipc::type>{ipc::type::UInt64}, Clear));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Set", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Set));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Start", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32, ipc::type::UInt64}, Start));
 	srv.register_collection(cls);
 }
 
@@ -21,14 +21,15 @@
 #include <obs.h>
 #include "error.hpp"
 #include "shared.hpp"
+#include "util-callstats.h"
 
 void osn::Video::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Video");
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetSkippedFrames", std::vector<ipc::type>{}, GetSkippedFrames));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetTotalFrames", std::vector<ipc::type>{}, GetTotalFrames));
+	    std::make_shared<util::TimedFunction>(cls, "GetSkippedFrames", std::vector<ipc::type>{}, GetSkippedFrames));
+	cls->register_function(
+	    std::make_shared<util::TimedFunction>(cls, "GetTotalFrames", std::vector<ipc::type>{}, GetTotalFrames));
 	srv.register_collection(cls);
 }
 
@@ -18,10 +18,16 @@
 
 #include "osn-volmeter.hpp"
 #include "error.hpp"
+#include "event-frame.hpp"
 #include "obs.h"
+#include "osn-events.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
+#include "volmeter-frame.hpp"
+#include "util-callstats.h"
+
+std::atomic<uint32_t> osn::VolMeter::pending_count(0);
 
 osn::VolMeter::Manager& osn::VolMeter::Manager::GetInstance()
 {
@@ -29,7 +35,7 @@ osn::VolMeter::Manager& osn::VolMeter::Manager::GetInstance()
 	return _inst;
 }
 
-osn::VolMeter::VolMeter(obs_fader_type type)
+osn::VolMeter::VolMeter(obs_fader_type type) : pending(false)
 {
 	self = obs_volmeter_create(type);
 	if (!self)
@@ -44,22 +50,26 @@ osn::VolMeter::~VolMeter()
 void osn::VolMeter::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("VolMeter");
-	cls->register_function(std::make_shared<ipc::function>("Create", std::vector<ipc::type>{ipc::type::Int32}, Create));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetUpdateInterval", std::vector<ipc::type>{ipc::type::UInt64}, GetUpdateInterval));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetUpdateInterval", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetUpdateInterval));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
+	    std::make_shared<util::TimedFunction>(cls, "Create", std::vector<ipc::type>{ipc::type::Int32}, Create));
+	cls->register_function(
+	    std::make_shared<util::TimedFunction>(cls, "Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "GetUpdateInterval", std::vector<ipc::type>{ipc::type::UInt64}, GetUpdateInterval));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "SetUpdateInterval", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetUpdateInterval));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
+	    std::make_shared<util::TimedFunction>(cls, "Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "AddCallback", std::vector<ipc::type>{ipc::type::UInt64}, AddCallback));
+	cls->register_function(std::make_shared<util::TimedFunction>(
+	    cls, "RemoveCallback", std::vector<ipc::type>{ipc::type::UInt64}, RemoveCallback));
 	cls->register_function(
-	    std::make_shared<ipc::function>("AddCallback", std::vector<ipc::type>{ipc::type::UInt64}, AddCallback));
+	    std::make_shared<util::TimedFunction>(cls, "Query", std::vector<ipc::type>{ipc::type::UInt64}, Query));
 	cls->register_function(
-	    std::make_shared<ipc::function>("RemoveCallback", std::vector<ipc::type>{ipc::type::UInt64}, RemoveCallback));
-	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{ipc::type::UInt64}, Query));
+	    std::make_shared<util::TimedFunction>(cls, "QueryMany", std::vector<ipc::type>{ipc::type::Binary}, QueryMany));
 	srv.register_collection(cls);
 }
 
@@ -67,11 +77,12 @@ void osn::VolMeter::ClearVolmeters()
 {
     Manager::GetInstance().for_each([](const std::shared_ptr<osn::VolMeter>& volmeter)
     {
-        if (volmeter->id2) {
-            obs_volmeter_remove_callback(volmeter->self, OBSCallback, volmeter->id2);
-            delete volmeter->id2;
-            volmeter->id2 = nullptr;
+        if (volmeter->callback_count > 0) {
+            obs_volmeter_remove_callback(volmeter->self, OBSCallback, volmeter.get());
+            volmeter->callback_count = 0;
         }
+        if (volmeter->pending.exchange(false))
+            pending_count.fetch_sub(1);
     });
 
     Manager::GetInstance().clear();
@@ -96,7 +107,7 @@ void osn::VolMeter::Create(
 	}
 
 	meter->id = Manager::GetInstance().allocate(meter);
-	if (meter->id == std::numeric_limits<utility::unique_id::id_t>::max()) {
+	if (meter->id == std::numeric_limits<utility::handle_table::id_t>::max()) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
 		rval.push_back(ipc::value("Failed to allocate unique id for Meter."));
 		meter.reset();
@@ -126,12 +137,13 @@ void osn::VolMeter::Destroy(
 		return;
 	}
 
-	Manager::GetInstance().free(uid);
-	if (meter->id2) { // Ensure there are no more callbacks
-		obs_volmeter_remove_callback(meter->self, OBSCallback, meter->id2);
-		delete meter->id2;
-		meter->id2 = nullptr;
+	if (meter->callback_count > 0) { // Ensure there are no more callbacks
+		obs_volmeter_remove_callback(meter->self, OBSCallback, meter.get());
+		meter->callback_count = 0;
 	}
+	if (meter->pending.exchange(false))
+		pending_count.fetch_sub(1);
+	Manager::GetInstance().free(uid);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -255,11 +267,8 @@ void osn::VolMeter::AddCallback(
 	}
 
 	meter->callback_count++;
-	if (meter->callback_count == 1) {
-		meter->id2  = new uint64_t;
-		*meter->id2 = meter->id;
-		obs_volmeter_add_callback(meter->self, OBSCallback, meter->id2);
-	}
+	if (meter->callback_count == 1)
+		obs_volmeter_add_callback(meter->self, OBSCallback, meter.get());
 
 	rval.push_back(ipc::value(uint64_t(ErrorCode::Ok)));
 	rval.push_back(ipc::value(meter->callback_count));
@@ -282,11 +291,8 @@ void osn::VolMeter::RemoveCallback(
 	}
 
 	meter->callback_count--;
-	if (meter->callback_count == 0) {
-		obs_volmeter_remove_callback(meter->self, OBSCallback, meter->id2);
-		delete meter->id2;
-		meter->id2 = nullptr;
-	}
+	if (meter->callback_count == 0)
+		obs_volmeter_remove_callback(meter->self, OBSCallback, meter.get());
 
 	rval.push_back(ipc::value(uint64_t(ErrorCode::Ok)));
 	rval.push_back(ipc::value(meter->callback_count));
@@ -310,43 +316,106 @@ void osn::VolMeter::Query(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 
-	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
+	AudioData current;
+	meter->current_data.load(current);
 
-	rval.push_back(ipc::value(meter->current_data.ch));
+	rval.push_back(ipc::value(current.ch));
 
-	for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
-		rval.push_back(ipc::value(meter->current_data.magnitude[ch]));
-		rval.push_back(ipc::value(meter->current_data.peak[ch]));
-		rval.push_back(ipc::value(meter->current_data.input_peak[ch]));
+	for (size_t ch = 0; ch < current.ch; ch++) {
+		rval.push_back(ipc::value(current.magnitude[ch]));
+		rval.push_back(ipc::value(current.peak[ch]));
+		rval.push_back(ipc::value(current.input_peak[ch]));
 	}
 
-	ulock.unlock();
+	AUTO_DEBUG;
+}
+
+void osn::VolMeter::QueryMany(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::vector<char> const& uids  = args[0].value_bin;
+	size_t                   count = uids.size() / sizeof(uint64_t);
+
+	// Unknown meters are skipped, the caller can tell by the missing uid.
+	std::vector<char> frames;
+	frames.reserve(count * volmeter::frame_size(MAX_AUDIO_CHANNELS));
+	for (size_t idx = 0; idx < count; idx++) {
+		uint64_t uid;
+		std::memcpy(&uid, &uids[idx * sizeof(uint64_t)], sizeof(uint64_t));
+
+		auto meter = Manager::GetInstance().find(uid);
+		if (!meter)
+			continue;
+
+		meter->write_frame(frames);
+	}
 
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(frames));
 	AUTO_DEBUG;
 }
 
+bool osn::VolMeter::HasPendingFrames()
+{
+	return pending_count.load() > 0;
+}
+
+bool osn::VolMeter::WriteEvents(std::vector<char>& buf)
+{
+	if (!HasPendingFrames())
+		return false;
+
+	// Everything that arrived since the last flush is coalesced into one event.
+	event_frame::writer frame(buf, event_frame::type::volmeter_frames);
+	Manager::GetInstance().for_each([&buf](const std::shared_ptr<osn::VolMeter>& meter) {
+		if (!meter->pending.exchange(false))
+			return;
+		pending_count.fetch_sub(1);
+		meter->write_frame(buf);
+	});
+	return true;
+}
+
+void osn::VolMeter::write_frame(std::vector<char>& buf)
+{
+	AudioData current;
+	current_data.load(current);
+
+	volmeter::write_frame(
+	    buf, id, uint32_t(current.ch), current.magnitude, current.peak, current.input_peak);
+}
+
 void osn::VolMeter::OBSCallback(
     void*       param,
     const float magnitude[MAX_AUDIO_CHANNELS],
     const float peak[MAX_AUDIO_CHANNELS],
     const float input_peak[MAX_AUDIO_CHANNELS])
 {
-	auto meter = Manager::GetInstance().find(*reinterpret_cast<uint64_t*>(param));
-	if (!meter) {
-		return;
-	}
+	// Runs on the libobs audio thread: no lookups, no locks, no allocations.
+	// The callback is removed before the meter is freed, so param stays valid.
+	auto meter = reinterpret_cast<osn::VolMeter*>(param);
 
 #define MAKE_FLOAT_SANE(db) (std::isfinite(db) ? db : (db > 0 ? 0.0f : -65535.0f))
 #define PREVIOUS_FRAME_WEIGHT
 
-	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
-
-	meter->current_data.ch = obs_volmeter_get_nr_channels(meter->self);
+	AudioData current;
+	current.ch = obs_volmeter_get_nr_channels(meter->self);
 	for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++) {
-		meter->current_data.magnitude[ch]  = MAKE_FLOAT_SANE(magnitude[ch]);
-		meter->current_data.peak[ch]       = MAKE_FLOAT_SANE(peak[ch]);
-		meter->current_data.input_peak[ch] = MAKE_FLOAT_SANE(input_peak[ch]);
+		current.magnitude[ch]  = MAKE_FLOAT_SANE(magnitude[ch]);
+		current.peak[ch]       = MAKE_FLOAT_SANE(peak[ch]);
+		current.input_peak[ch] = MAKE_FLOAT_SANE(input_peak[ch]);
 	}
 
 #undef MAKE_FLOAT_SANE
+
+	meter->current_data.store(current);
+
+	// Only the first frame since the last flush has to wake up the reader.
+	if (!meter->pending.exchange(true)) {
+		pending_count.fetch_add(1);
+		osn::Events::NotifyMeters();
+	}
 }
@@ -17,11 +17,13 @@
 ******************************************************************************/
 
 #pragma once
+#include <atomic>
 #include <ipc-server.hpp>
 #include <memory>
 #include <queue>
 #include "obs.h"
 #include "utility.hpp"
+#include "volmeter-snapshot.hpp"
 
 namespace osn
 {
@@ -48,18 +50,20 @@ namespace osn
 		obs_volmeter_t* self;
 		uint64_t        id;
 		size_t          callback_count = 0;
-		uint64_t*       id2            = nullptr;
 
-		struct AudioData
-		{
-			float   magnitude[MAX_AUDIO_CHANNELS]  = {0};
-			float   peak[MAX_AUDIO_CHANNELS]       = {0};
-			float   input_peak[MAX_AUDIO_CHANNELS] = {0};
-			int32_t ch                             = 0;
-		};
+		typedef volmeter::audio_data<MAX_AUDIO_CHANNELS> AudioData;
+		typedef volmeter::snapshot<MAX_AUDIO_CHANNELS>   AudioSnapshot;
+
+		// Last frame seen by OBSCallback. The libobs audio thread writes it
+		//  without locking, IPC threads read it.
+		AudioSnapshot     current_data;
+		std::atomic<bool> pending;
 
-		AudioData current_data;
-		std::mutex                 current_data_mtx;
+		// Number of meters with a frame that has not been delivered yet.
+		static std::atomic<uint32_t> pending_count;
+
+		// Appends the current frame to a packed frame buffer.
+		void write_frame(std::vector<char>& buf);
 
 		public:
 		VolMeter(obs_fader_type type);
@@ -102,6 +106,16 @@ namespace osn
 
 		static void
 		            Query(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void QueryMany(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+
+		// Used by osn::Events to deliver pending frames to the client.
+		static bool HasPendingFrames();
+		static bool WriteEvents(std::vector<char>& buf);
+
 		static void OBSCallback(
 		    void*       param,
 		    const float magnitude[MAX_AUDIO_CHANNELS],
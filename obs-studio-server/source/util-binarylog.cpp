@@ -0,0 +1,216 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-binarylog.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static void put_u16(char* out, uint16_t value)
+{
+	out[0] = char(value & 0xFF);
+	out[1] = char(value >> 8);
+}
+
+static void put_u32(char* out, uint32_t value)
+{
+	for (size_t idx = 0; idx < 4; idx++)
+		out[idx] = char((value >> (idx * 8)) & 0xFF);
+}
+
+static void put_u64(char* out, uint64_t value)
+{
+	for (size_t idx = 0; idx < 8; idx++)
+		out[idx] = char((value >> (idx * 8)) & 0xFF);
+}
+
+#ifdef _WIN32
+util::BinaryLog::BinaryLog() : file(INVALID_HANDLE_VALUE), mapping(nullptr), view(nullptr), mapped(0), used(0) {}
+#else
+util::BinaryLog::BinaryLog() : file(-1), view(nullptr), mapped(0), used(0) {}
+#endif
+
+util::BinaryLog::~BinaryLog()
+{
+	close();
+}
+
+bool util::BinaryLog::open(const std::string& path)
+{
+	close();
+
+#ifdef _WIN32
+	int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+	if (length <= 0)
+		return false;
+	std::wstring wide(size_t(length), L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wide[0], length);
+
+	file = CreateFileW(
+	    wide.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+#else
+	file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (file < 0)
+		return false;
+#endif
+
+	if (!map(ChunkSize)) {
+		close();
+		return false;
+	}
+
+	memcpy(view, binarylog::Magic, sizeof(binarylog::Magic));
+	put_u32(view + 8, binarylog::Version);
+	put_u32(view + 12, 0);
+	used = binarylog::HeaderSize;
+	return true;
+}
+
+void util::BinaryLog::close()
+{
+	if (!isOpen())
+		return;
+
+	unmap();
+
+	// Drop the unused tail of the last chunk.
+#ifdef _WIN32
+	LARGE_INTEGER size;
+	size.QuadPart = LONGLONG(used);
+	if (SetFilePointerEx(file, size, NULL, FILE_BEGIN))
+		SetEndOfFile(file);
+	CloseHandle(file);
+	file = INVALID_HANDLE_VALUE;
+#else
+	if (ftruncate(file, off_t(used)) != 0) {
+		// Leaves the zeroed tail, which readers treat as the end.
+	}
+	::close(file);
+	file = -1;
+#endif
+	used = 0;
+}
+
+bool util::BinaryLog::isOpen() const
+{
+#ifdef _WIN32
+	return file != INVALID_HANDLE_VALUE;
+#else
+	return file >= 0;
+#endif
+}
+
+bool util::BinaryLog::write(
+    uint64_t    time,
+    int         level,
+    uint32_t    thread,
+    const char* tag,
+    size_t      tagLength,
+    const char* text,
+    size_t      length)
+{
+	if (!view)
+		return false;
+
+	if (tagLength > binarylog::MaximumTagLength)
+		tagLength = binarylog::MaximumTagLength;
+
+	size_t size = binarylog::RecordHeaderSize + tagLength + length;
+	if (size > UINT32_MAX)
+		return false;
+
+	// Keep room for the zero size that ends the log.
+	if (used + size + sizeof(uint32_t) > mapped) {
+		size_t grown = mapped;
+		while (used + size + sizeof(uint32_t) > grown)
+			grown += ChunkSize;
+		if (!map(grown))
+			return false;
+	}
+
+	char* out = view + used;
+	put_u32(out, uint32_t(size));
+	put_u64(out + 4, time);
+	put_u32(out + 12, uint32_t(level));
+	put_u32(out + 16, thread);
+	put_u16(out + 20, uint16_t(tagLength));
+	memcpy(out + binarylog::RecordHeaderSize, tag, tagLength);
+	memcpy(out + binarylog::RecordHeaderSize + tagLength, text, length);
+	used += size;
+	return true;
+}
+
+// Maps the file at the given size, extending it with zeroes. The current
+//  mapping is only replaced once the new one exists, so a failure leaves
+//  what was written mapped.
+bool util::BinaryLog::map(size_t size)
+{
+#ifdef _WIN32
+	HANDLE newMapping = CreateFileMappingW(
+	    file, NULL, PAGE_READWRITE, DWORD(uint64_t(size) >> 32), DWORD(uint64_t(size) & 0xFFFFFFFF), NULL);
+	if (!newMapping)
+		return false;
+
+	char* newView = static_cast<char*>(MapViewOfFile(newMapping, FILE_MAP_WRITE, 0, 0, size));
+	if (!newView) {
+		CloseHandle(newMapping);
+		return false;
+	}
+
+	unmap();
+	mapping = newMapping;
+#else
+	if (ftruncate(file, off_t(size)) != 0)
+		return false;
+
+	void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	if (address == MAP_FAILED)
+		return false;
+	char* newView = static_cast<char*>(address);
+
+	unmap();
+#endif
+
+	view   = newView;
+	mapped = size;
+	return true;
+}
+
+void util::BinaryLog::unmap()
+{
+#ifdef _WIN32
+	if (view)
+		UnmapViewOfFile(view);
+	if (mapping)
+		CloseHandle(mapping);
+	mapping = nullptr;
+#else
+	if (view)
+		munmap(view, mapped);
+#endif
+	view   = nullptr;
+	mapped = 0;
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace util
+{
+	// Structured log file, little endian:
+	//  header:  char magic[8], uint32_t version, uint32_t reserved
+	//  records: uint32_t size (of the whole record), uint64_t time (ns since
+	//           the Unix epoch), int32_t level, uint32_t thread,
+	//           uint16_t tag length, tag, message
+	//  A record size of zero marks the end of the log; a file left behind
+	//  by a crash ends with the zeroes of its last mapped chunk.
+	namespace binarylog
+	{
+		static const char     Magic[8]         = {'O', 'S', 'N', 'B', 'L', 'O', 'G', '1'};
+		static const uint32_t Version          = 1;
+		static const size_t   HeaderSize       = 16;
+		static const size_t   RecordHeaderSize = 22;
+		static const size_t   MaximumTagLength = 64;
+	} // namespace binarylog
+
+	// Appends records to a memory mapped file, growing the mapping a chunk
+	//  at a time. Closing truncates the file to what was written.
+	//  Not thread safe.
+	class BinaryLog
+	{
+		public:
+		static const size_t ChunkSize = 4 * 1024 * 1024;
+
+		BinaryLog();
+		~BinaryLog();
+
+		// The path is UTF-8.
+		bool open(const std::string& path);
+		void close();
+		bool isOpen() const;
+
+		// Returns false if the record could not be written, either because it
+		//  is too large or because the mapping could not grow.
+		bool write(
+		    uint64_t    time,
+		    int         level,
+		    uint32_t    thread,
+		    const char* tag,
+		    size_t      tagLength,
+		    const char* text,
+		    size_t      length);
+
+		private:
+		bool map(size_t size);
+		void unmap();
+
+#ifdef _WIN32
+		void* file;
+		void* mapping;
+#else
+		int file;
+#endif
+		char*  view;
+		size_t mapped;
+		size_t used;
+	};
+} // namespace util
@@ -0,0 +1,168 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-callstats.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include "call-stats.hpp"
+#include "settings-buffer.hpp"
+#include "util-crashmanager.h"
+
+struct CallCounters
+{
+	std::atomic<uint64_t> count;
+	std::atomic<uint64_t> totalNs;
+	std::atomic<uint64_t> maxNs;
+	std::atomic<uint32_t> buckets[call_stats::BucketCount];
+};
+
+// Counters of every function, owned by one thread. Only that thread writes
+//  them, so updates are relaxed loads and stores rather than read-modify-write
+//  operations; readers sum the counters of all threads.
+struct ThreadCallCounters
+{
+	ThreadCallCounters(size_t size) : functions(new CallCounters[size]), size(size)
+	{
+		for (size_t idx = 0; idx < size; idx++) {
+			functions[idx].count.store(0, std::memory_order_relaxed);
+			functions[idx].totalNs.store(0, std::memory_order_relaxed);
+			functions[idx].maxNs.store(0, std::memory_order_relaxed);
+			for (auto& bucket : functions[idx].buckets)
+				bucket.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	std::unique_ptr<CallCounters[]> functions;
+	size_t                          size;
+};
+
+static std::mutex                                       statsMutex;
+static std::vector<std::pair<std::string, std::string>> statsNames;
+static std::vector<std::unique_ptr<ThreadCallCounters>> statsThreads;
+
+static CallCounters& local_counters(size_t index)
+{
+	// Functions are all registered before the first call, so a thread only
+	//  takes the lock the first time it dispatches.
+	static thread_local ThreadCallCounters* local = nullptr;
+	if (!local || index >= local->size) {
+		std::unique_lock<std::mutex> lock(statsMutex);
+		statsThreads.emplace_back(new ThreadCallCounters(statsNames.size()));
+		local = statsThreads.back().get();
+	}
+	return local->functions[index];
+}
+
+template<typename T>
+static inline void add_local(std::atomic<T>& counter, T value)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+util::TimedFunction::TimedFunction(
+    const std::shared_ptr<ipc::collection>& cls,
+    const std::string&                      name,
+    const std::vector<ipc::type>&           params,
+    Handler                                 handler,
+    void*                                   data)
+    : ipc::function(name, params, &TimedFunction::dispatch, this), handler(handler), data(data),
+      breadcrumb(cls->get_name() + "." + name)
+{
+	std::unique_lock<std::mutex> lock(statsMutex);
+	index = statsNames.size();
+	statsNames.emplace_back(cls->get_name(), name);
+}
+
+void util::TimedFunction::dispatch(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	TimedFunction* self = static_cast<TimedFunction*>(data);
+	util::CrashManager::AddBreadcrumb(self->breadcrumb.data(), self->breadcrumb.size());
+
+	auto start = std::chrono::high_resolution_clock::now();
+	self->handler(self->data, id, args, rval);
+	uint64_t ns = uint64_t(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count());
+
+	CallCounters& counters = local_counters(self->index);
+	add_local(counters.count, uint64_t(1));
+	add_local(counters.totalNs, ns);
+	if (ns > counters.maxNs.load(std::memory_order_relaxed))
+		counters.maxNs.store(ns, std::memory_order_relaxed);
+	add_local(counters.buckets[call_stats::bucket_index(ns / 1000)], uint32_t(1));
+}
+
+void util::CallStats::Write(std::vector<char>& buf)
+{
+	struct Totals
+	{
+		size_t                index;
+		uint64_t              count;
+		uint64_t              totalNs;
+		uint64_t              maxNs;
+		std::vector<uint32_t> buckets;
+	};
+
+	std::unique_lock<std::mutex> lock(statsMutex);
+
+	std::vector<Totals> called;
+	for (size_t index = 0; index < statsNames.size(); index++) {
+		Totals totals = {index, 0, 0, 0, std::vector<uint32_t>(call_stats::BucketCount, 0)};
+		for (auto& thread : statsThreads) {
+			if (index >= thread->size)
+				continue;
+
+			const CallCounters& counters = thread->functions[index];
+			totals.count += counters.count.load(std::memory_order_relaxed);
+			totals.totalNs += counters.totalNs.load(std::memory_order_relaxed);
+			uint64_t maxNs = counters.maxNs.load(std::memory_order_relaxed);
+			if (maxNs > totals.maxNs)
+				totals.maxNs = maxNs;
+			for (size_t bucket = 0; bucket < call_stats::BucketCount; bucket++)
+				totals.buckets[bucket] += counters.buckets[bucket].load(std::memory_order_relaxed);
+		}
+
+		if (totals.count)
+			called.push_back(std::move(totals));
+	}
+
+	settings_buffer::writer writer(buf);
+	writer.write(called.size());
+	for (auto& totals : called) {
+		writer.write(statsNames[totals.index].first);
+		writer.write(statsNames[totals.index].second);
+		writer.write(totals.count);
+		writer.write(totals.totalNs);
+		writer.write(totals.maxNs);
+
+		uint32_t used = 0;
+		for (uint32_t calls : totals.buckets)
+			used += calls ? 1 : 0;
+		writer.write(used);
+		for (size_t bucket = 0; bucket < call_stats::BucketCount; bucket++) {
+			if (!totals.buckets[bucket])
+				continue;
+			writer.write(uint16_t(bucket));
+			writer.write(totals.buckets[bucket]);
+		}
+	}
+}
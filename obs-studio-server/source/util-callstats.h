@@ -0,0 +1,62 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <ipc-class.hpp>
+#include <ipc-function.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace util
+{
+	// ipc::function that times every call for System.GetCallStats and leaves
+	//  a crash report breadcrumb. Registered in place of ipc::function, with
+	//  the collection it is registered on as first argument.
+	class TimedFunction : public ipc::function
+	{
+		public:
+		typedef void (*Handler)(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+
+		TimedFunction(
+		    const std::shared_ptr<ipc::collection>& cls,
+		    const std::string&                      name,
+		    const std::vector<ipc::type>&           params,
+		    Handler                                 handler,
+		    void*                                   data = nullptr);
+
+		private:
+		static void
+		    dispatch(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+
+		Handler     handler;
+		void*       data;
+		size_t      index;
+		std::string breadcrumb;
+	};
+
+	namespace CallStats
+	{
+		// Appends the statistics of every function called so far, laid out as
+		//  described in call-stats.hpp.
+		void Write(std::vector<char>& buf);
+	} // namespace CallStats
+} // namespace util
@@ -21,6 +21,7 @@
 #include "StackWalker.h"
 #include <chrono>
 #include <codecvt>
+#include <cstring>
 #include <iostream>
 #include <locale>
 #include <map>
@@ -31,6 +32,7 @@
 #include <thread>
 #include <vector>
 #include "nodeobs_api.h"
+#include "util-messagering.h"
 
 #if defined(_WIN32)
 
@@ -58,10 +60,9 @@
 std::vector<std::string>              handledOBSCrashes;
 PDH_HQUERY                            cpuQuery;
 PDH_HCOUNTER                          cpuTotal;
-std::vector<std::string>              breadcrumbs;
-std::vector<std::string>              warnings;
+util::MessageRing                     breadcrumbs;
+util::MessageRing                     warnings;
 std::chrono::steady_clock::time_point initialTime;
-std::mutex                            messageMutex;
 
 // Crashpad variables
 #ifndef _DEBUG
@@ -74,6 +75,30 @@ base::FilePath                                 handler;
 std::vector<std::string>                       arguments;
 std::map<std::string, std::string>             annotations;
 LPTOP_LEVEL_EXCEPTION_FILTER                   crashpadInternalExceptionFilterMethod = nullptr;
+
+// Values of the annotations HandleCrash fills in. PrepareAnnotations creates
+//  their map entries with room for the largest value up front, so filling
+//  them in does not allocate even if the heap is what is corrupted.
+struct CrashAnnotations
+{
+	std::string* timeElapsed;
+	std::string* status;
+	std::string* leaks;
+	std::string* totalMemory;
+	std::string* usedMemory;
+	std::string* slobsMemory;
+	std::string* cpuUsage;
+	std::string* obsErrors;
+	std::string* obsWarnings;
+	std::string* obsGeneral;
+	std::string* crashReason;
+	std::string* breadcrumbs;
+	std::string* warnings;
+	std::string* version;
+	std::string* computerName;
+	std::string* processList;
+	std::string* callStack;
+} crashAnnotations;
 #endif
 
 // Forward
@@ -81,29 +106,139 @@ std::string    FormatVAString(const char* const format, va_list args);
 nlohmann::json RewindCallStack(std::string& crashedMethod);
 
 // Transform a byte value into a string + sufix
-std::string PrettyBytes(uint64_t bytes)
+static void FormatBytes(char* buffer, size_t size, uint64_t bytes)
 {
-	const char* suffixes[7];
-	char        temp[100];
-	suffixes[0]    = "b";
-	suffixes[1]    = "kb";
-	suffixes[2]    = "mb";
-	suffixes[3]    = "gb";
-	suffixes[4]    = "tb";
-	suffixes[5]    = "pb";
-	suffixes[6]    = "eb";
-	uint64_t s     = 0; // which suffix to use
-	double count = double(bytes);
-	while (count >= 1024 && s < 7) {
+	const char* suffixes[] = {"b", "kb", "mb", "gb", "tb", "pb", "eb"};
+	size_t      s          = 0; // which suffix to use
+	double      count      = double(bytes);
+	while (count >= 1024 && s < 6) {
 		s++;
 		count /= 1024;
 	}
 	if (count - floor(count) == 0.0)
-		sprintf(temp, "%d%s", (int)count, suffixes[s]);
+		snprintf(buffer, size, "%d%s", (int)count, suffixes[s]);
 	else
-		sprintf(temp, "%.1f%s", count, suffixes[s]);
+		snprintf(buffer, size, "%.1f%s", count, suffixes[s]);
+}
+
+// Appends to a prepared annotation, truncating instead of growing it.
+static void AppendAnnotation(std::string* annotation, const char* text, size_t length)
+{
+	size_t room = annotation->capacity() - annotation->size();
+	annotation->append(text, length < room ? length : room);
+}
 
-	return std::string(temp);
+static void FormatAnnotation(std::string* annotation, const char* format, ...)
+{
+	char    buffer[256];
+	va_list args;
+	va_start(args, format);
+	int length = vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+
+	annotation->clear();
+	if (length > 0)
+		AppendAnnotation(annotation, buffer, size_t(length) < sizeof(buffer) ? size_t(length) : sizeof(buffer) - 1);
+}
+
+// Size of a string written as JSON, quotes included.
+static size_t JsonStringSize(const char* text, size_t length)
+{
+	size_t size = 2;
+	for (size_t idx = 0; idx < length; idx++) {
+		unsigned char c = static_cast<unsigned char>(text[idx]);
+		if (c == '"' || c == '\\' || c == '\n' || c == '\r' || c == '\t')
+			size += 2;
+		else if (c < 0x20)
+			size += 6;
+		else
+			size += 1;
+	}
+	return size;
+}
+
+static void AppendJsonString(std::string* annotation, const char* text, size_t length)
+{
+	char escaped[8];
+	AppendAnnotation(annotation, "\"", 1);
+	for (size_t idx = 0; idx < length; idx++) {
+		unsigned char c = static_cast<unsigned char>(text[idx]);
+		switch (c) {
+		case '"':
+			AppendAnnotation(annotation, "\\\"", 2);
+			break;
+		case '\\':
+			AppendAnnotation(annotation, "\\\\", 2);
+			break;
+		case '\n':
+			AppendAnnotation(annotation, "\\n", 2);
+			break;
+		case '\r':
+			AppendAnnotation(annotation, "\\r", 2);
+			break;
+		case '\t':
+			AppendAnnotation(annotation, "\\t", 2);
+			break;
+		default:
+			if (c < 0x20) {
+				snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+				AppendAnnotation(annotation, escaped, 6);
+			} else {
+				AppendAnnotation(annotation, &text[idx], 1);
+			}
+		}
+	}
+	AppendAnnotation(annotation, "\"", 1);
+}
+
+// Writes 'count' messages as a JSON array, keeping the newest ones that fit.
+//  get(index, text, length) returns a message, index 0 being the oldest.
+template<typename Get>
+static void WriteJsonArray(std::string* annotation, size_t count, Get get)
+{
+	const char* text;
+	size_t      length;
+
+	size_t room   = annotation->capacity() - 2;
+	size_t first  = count;
+	size_t needed = 0;
+	while (first > 0) {
+		get(first - 1, text, length);
+		size_t size = JsonStringSize(text, length) + 1;
+		if (needed + size > room)
+			break;
+		needed += size;
+		first--;
+	}
+
+	annotation->clear();
+	AppendAnnotation(annotation, "[", 1);
+	for (size_t idx = first; idx < count; idx++) {
+		get(idx, text, length);
+		if (idx > first)
+			AppendAnnotation(annotation, ",", 1);
+		AppendJsonString(annotation, text, length);
+	}
+	AppendAnnotation(annotation, "]", 1);
+}
+
+static void WriteMessages(const util::MessageRing& ring, std::string* annotation)
+{
+	// Copied out first, other threads may still be overwriting the ring.
+	static char   texts[util::MessageRing::Capacity][util::MessageRing::TextSize];
+	static size_t lengths[util::MessageRing::Capacity];
+
+	size_t count = 0;
+	for (uint64_t position = ring.begin(); position < ring.end() && count < util::MessageRing::Capacity;
+	     position++) {
+		if (ring.read(position, texts[count], lengths[count]))
+			count++;
+	}
+
+	WriteJsonArray(annotation, count, [](size_t idx, const char*& text, size_t& length) {
+		text   = texts[idx];
+		length = lengths[idx];
+	});
 }
 
 void RequestComputerUsageParams(
@@ -207,6 +342,8 @@ bool util::CrashManager::Initialize()
 {
 #ifndef _DEBUG
 
+    PrepareAnnotations();
+
     if (!SetupCrashpad()) {
 		return false;
     }
@@ -214,13 +351,14 @@ bool util::CrashManager::Initialize()
     // Handler for obs errors (mainly for bcrash() calls)
 	base_set_crash_handler(
 	    [](const char* format, va_list args, void* param) {
+		    OBS_API::flushLog();
 		    std::string errorMessage = FormatVAString(format, args);
 
 		    // Check if this crash error is handled internally (if this is a known
 		    // error that we can't do anything about it, just let the application
 		    // crash normally
 		    if (!TryHandleCrash(std::string(format), errorMessage))
-			    HandleCrash(errorMessage);
+			    HandleCrash(errorMessage.c_str());
 	    },
 	    nullptr);
 
@@ -274,6 +412,45 @@ void util::CrashManager::Configure()
 	}
 }
 
+void util::CrashManager::PrepareAnnotations()
+{
+#ifndef _DEBUG
+
+	// Creates the map entry with its final capacity, values are truncated to it
+	auto prepare = [](const char* key, size_t capacity) {
+		std::string& value = annotations[key];
+		value.reserve(capacity);
+		return &value;
+	};
+
+	// The annotations are passed to the crashpad handler on its command line, the
+	// larger ones are sized to keep it well under the limit
+	crashAnnotations.timeElapsed = prepare("Time elapsed: ", 32);
+	crashAnnotations.status      = prepare("Status", 32);
+	crashAnnotations.leaks       = prepare("Leaks", 32);
+	crashAnnotations.totalMemory = prepare("Total memory", 32);
+	crashAnnotations.usedMemory  = prepare("Total used memory", 64);
+	crashAnnotations.slobsMemory = prepare("Total SLOBS memory", 64);
+	crashAnnotations.cpuUsage    = prepare("CPU usage", 32);
+	crashAnnotations.obsErrors   = prepare("OBS errors", 4096);
+	crashAnnotations.obsWarnings = prepare("OBS warnings", 4096);
+	crashAnnotations.obsGeneral  = prepare("OBS log general", 8192);
+	crashAnnotations.crashReason = prepare("Crash reason", 1024);
+	crashAnnotations.breadcrumbs = prepare("Breadcrumbs", 4096);
+	crashAnnotations.warnings    = prepare("Warnings", 2048);
+	crashAnnotations.version     = prepare("Version", 64);
+
+	// Only filled in after the report can already be produced, see HandleCrash
+	crashAnnotations.processList = prepare("Process List", 0);
+	crashAnnotations.callStack   = prepare("Manual callstack", 0);
+
+	// Does not change while running, so it is known before any crash
+	crashAnnotations.computerName = prepare("Computer name", 0);
+	GetUserInfo(*crashAnnotations.computerName);
+
+#endif
+}
+
 bool util::CrashManager::SetupCrashpad()
 {
 	// Define if this is a preview or live version
@@ -310,7 +487,20 @@ bool util::CrashManager::SetupCrashpad()
 		return false;
 
 	database->GetSettings()->SetUploadsEnabled(true);
-    
+
+	return StartCrashpadHandler();
+
+#endif
+
+	return true;
+}
+
+// Starts, or restarts, the crashpad handler with the current annotations. The
+//  handler receives them on start, so this is how they reach a crash report.
+bool util::CrashManager::StartCrashpadHandler()
+{
+#ifndef _DEBUG
+
 	bool rc = client.StartHandler(handler, db, db, url, annotations, arguments, true, true);
 	if (!rc)
 		return false;
@@ -339,7 +529,7 @@ void util::CrashManager::HandleExit() noexcept
 	}
 }
 
-void util::CrashManager::HandleCrash(std::string _crashInfo, bool callAbort) noexcept
+void util::CrashManager::HandleCrash(const char* _crashInfo, bool callAbort) noexcept
 {
 #ifndef _DEBUG
 
@@ -352,11 +542,8 @@ void util::CrashManager::HandleCrash(std::string _crashInfo, bool callAbort) noe
 
 	insideCrashMethod = true;
 
-	// This will manually rewind the callstack, we will use this info to populate an
-	// cras report attribute, avoiding some cases that the memory dump is corrupted
-	// and we don't have access to the callstack.
-	std::string    crashedMethodName;
-	nlohmann::json callStack = RewindCallStack(crashedMethodName);
+	// The messages logged right before the crash are often the ones that explain it
+	OBS_API::flushLog();
 
 	// Get the information about the total of CPU and RAM used by this user
 	long long totalPhysMem;
@@ -365,40 +552,59 @@ void util::CrashManager::HandleCrash(std::string _crashInfo, bool callAbort) noe
 	size_t    physMemUsedByMe;
 	RequestComputerUsageParams(totalPhysMem, physMemUsed, physMemUsedByMe, totalCPUUsed);
 
-    std::string computerName;
-	GetUserInfo(computerName);
-
     auto timeElapsed =
 	    std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - initialTime);
-	
-	// Setup all the custom annotations that are important too our crash report
-	annotations.insert({{"Time elapsed: ", std::to_string(timeElapsed
-	    .count()) + "s"}});
-	annotations.insert({{"Status", obs_initialized() ? "initialized" : "shutdown"}});
-	annotations.insert({{"Leaks", std::to_string(bnum_allocs())}});
-	annotations.insert({{"Total memory", PrettyBytes(totalPhysMem)}});
-	annotations.insert({{"Total used memory",
-	                     PrettyBytes(physMemUsed)
-	                         + " - percentage: " + std::to_string(double(physMemUsed) / double(totalPhysMem)) + "%"}});
-	annotations.insert({{"Total SLOBS memory",
-	                     PrettyBytes(physMemUsedByMe) + " - percentage: "
-	                         + std::to_string(double(physMemUsedByMe) / double(totalPhysMem)) + "%"}});
-	annotations.insert({{"CPU usage", std::to_string(int(totalCPUUsed)) + "%"}});
-	annotations.insert({{"OBS errors", RequestOBSLog(OBSLogType::Errors).dump(4)}});
-	annotations.insert({{"OBS warnings", RequestOBSLog(OBSLogType::Warnings).dump(4)}});
-	annotations.insert({{"OBS log general", RequestOBSLog(OBSLogType::General).dump(4)}});
-	annotations.insert({{"Process List", RequestProcessList().dump(4)}});
-	annotations.insert({{"Crash reason", _crashInfo}});
-	annotations.insert({{"Computer name", computerName}});
-	annotations.insert({{"Breadcrumbs", ComputeBreadcrumbs().dump(4)}});
-	annotations.insert({{"Warnings", ComputeWarnings().dump(4)}});
-	annotations.insert({{"Version", OBS_API::getCurrentVersion()}});
-
-	// If the callstack rewind operation returned an error, use it instead its result
-	annotations.insert({{"Manual callstack", callStack.dump(4)}});
-	
-    // Recreate crashpad instance, this is a well defined/supported operation
-	SetupCrashpad();
+
+	char totalMemory[32], usedMemory[32], slobsMemory[32];
+	FormatBytes(totalMemory, sizeof(totalMemory), totalPhysMem);
+	FormatBytes(usedMemory, sizeof(usedMemory), physMemUsed);
+	FormatBytes(slobsMemory, sizeof(slobsMemory), physMemUsedByMe);
+
+	// Setup all the custom annotations that are important too our crash report, first
+	// the ones written into their prepared values without allocating
+	FormatAnnotation(crashAnnotations.timeElapsed, "%llds", (long long)timeElapsed.count());
+	FormatAnnotation(crashAnnotations.status, "%s", obs_initialized() ? "initialized" : "shutdown");
+	FormatAnnotation(crashAnnotations.leaks, "%ld", bnum_allocs());
+	FormatAnnotation(crashAnnotations.totalMemory, "%s", totalMemory);
+	FormatAnnotation(
+	    crashAnnotations.usedMemory,
+	    "%s - percentage: %f%%",
+	    usedMemory,
+	    double(physMemUsed) / double(totalPhysMem));
+	FormatAnnotation(
+	    crashAnnotations.slobsMemory,
+	    "%s - percentage: %f%%",
+	    slobsMemory,
+	    double(physMemUsedByMe) / double(totalPhysMem));
+	FormatAnnotation(crashAnnotations.cpuUsage, "%d%%", int(totalCPUUsed));
+	WriteOBSLog(OBSLogType::Errors, crashAnnotations.obsErrors);
+	WriteOBSLog(OBSLogType::Warnings, crashAnnotations.obsWarnings);
+	WriteOBSLog(OBSLogType::General, crashAnnotations.obsGeneral);
+	crashAnnotations.crashReason->clear();
+	AppendAnnotation(crashAnnotations.crashReason, _crashInfo, strlen(_crashInfo));
+	WriteMessages(breadcrumbs, crashAnnotations.breadcrumbs);
+	WriteMessages(warnings, crashAnnotations.warnings);
+	crashAnnotations.version->clear();
+	AppendAnnotation(
+	    crashAnnotations.version, OBS_API::getCurrentVersion().data(), OBS_API::getCurrentVersion().size());
+
+	// Restart crashpad with these before anything allocates, so a report is
+	// produced even if the heap is what is corrupted
+	StartCrashpadHandler();
+
+	// The manual callstack and process list allocate a lot. If that crashes, the
+	// nested crash aborts and the handler started above reports it; otherwise
+	// crashpad is restarted once more to include them.
+	try {
+		// This will manually rewind the callstack, we will use this info to populate an
+		// cras report attribute, avoiding some cases that the memory dump is corrupted
+		// and we don't have access to the callstack.
+		std::string crashedMethodName;
+		*crashAnnotations.callStack   = RewindCallStack(crashedMethodName).dump(4);
+		*crashAnnotations.processList = RequestProcessList().dump(4);
+		StartCrashpadHandler();
+	} catch (...) {
+	}
 
     // Finish the execution and let crashpad handle the crash
 	if(callAbort)
@@ -444,7 +650,7 @@ bool util::CrashManager::TryHandleCrash(std::string _format, std::string _crashM
 		OBS_API::destroyOBS_API();
 		exit(0);
 	} catch (...) {
-		util::CrashManager::HandleCrash(_crashMessage);
+		util::CrashManager::HandleCrash(_crashMessage.c_str());
 	}
 
 	// Unreachable statement
@@ -516,61 +722,30 @@ nlohmann::json RewindCallStack(std::string& crashedMethod)
 	return result;
 }
 
-nlohmann::json util::CrashManager::RequestOBSLog(OBSLogType type)
+void util::CrashManager::WriteOBSLog(OBSLogType type, std::string* annotation)
 {
-	nlohmann::json result;
+	const util::LogRing* ring = nullptr;
 
     switch (type)
     {
         case OBSLogType::Errors:
-        {
-		    auto& errors = OBS_API::getOBSLogErrors();
-			for (auto& msg : errors)
-				result.push_back(msg);
+            ring = &OBS_API::getOBSLogErrors();
             break;
-        }
 
         case OBSLogType::Warnings:
-        {
-		    auto& warnings = OBS_API::getOBSLogWarnings();
-			for (auto& msg : warnings)
-				result.push_back(msg);
+            ring = &OBS_API::getOBSLogWarnings();
             break;
-        }
 
         case OBSLogType::General:
-        {
-		    auto& general = OBS_API::getOBSLogGeneral();
-		    while (!general.empty()) {
-			    result.push_back(general.front());
-			    general.pop();
-            }
-		    
+            ring = &OBS_API::getOBSLogGeneral();
             break;
-        }
     }
-    
-	return result;
-}
-
-nlohmann::json util::CrashManager::ComputeBreadcrumbs()
-{
-	nlohmann::json result;
-
-    for (auto& msg : breadcrumbs)
-		result.push_back(msg);
 
-    return result;
-}
-
-nlohmann::json util::CrashManager::ComputeWarnings()
-{
-	nlohmann::json result;
-
-	for (auto& msg : warnings)
-		result.push_back(msg);
-
-	return result;
+	WriteJsonArray(annotation, ring->size(), [ring](size_t idx, const char*& text, size_t& length) {
+		const util::LogRing::Entry& entry = ring->at(idx);
+		text                              = ring->text(entry);
+		length                            = entry.length;
+	});
 }
 
 void BindCrtHandlesToStdHandles(bool bindStdIn, bool bindStdOut, bool bindStdErr)
@@ -726,18 +901,20 @@ void util::CrashManager::IPCValuesToData(const std::vector<ipc::value>& values,
 
 void util::CrashManager::AddWarning(const std::string& warning)
 {
-	std::lock_guard<std::mutex> lock(messageMutex);
-	warnings.push_back(warning);
+	warnings.push(warning.data(), warning.size());
 }
 
 void util::CrashManager::AddBreadcrumb(const std::string& message)
 {
-	std::lock_guard<std::mutex> lock(messageMutex);
-	breadcrumbs.push_back(message);
+	breadcrumbs.push(message.data(), message.size());
+}
+
+void util::CrashManager::AddBreadcrumb(const char* message, size_t length)
+{
+	breadcrumbs.push(message, length);
 }
 
 void util::CrashManager::ClearBreadcrumbs()
 {
-	std::lock_guard<std::mutex> lock(messageMutex);
 	breadcrumbs.clear();
 }
\ No newline at end of file
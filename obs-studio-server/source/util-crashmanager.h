@@ -47,16 +47,17 @@ namespace util
 		static void IPCValuesToData(const std::vector<ipc::value>&, nlohmann::json&);
 		static void AddWarning(const std::string& warning);
 		static void AddBreadcrumb(const std::string& message);
+		static void AddBreadcrumb(const char* message, size_t length);
 		static void ClearBreadcrumbs();
 
 		private:
-		static nlohmann::json RequestOBSLog(OBSLogType type);
-		static nlohmann::json ComputeBreadcrumbs();
-		static nlohmann::json ComputeWarnings();
+		static void PrepareAnnotations();
+		static void WriteOBSLog(OBSLogType type, std::string* annotation);
 		static bool SetupCrashpad();
+		static bool StartCrashpadHandler();
 		static bool TryHandleCrash(std::string format, std::string crashMessage);
 		static void HandleExit() noexcept;
-		static void HandleCrash(std::string crashInfo, bool callAbort = true) noexcept;
+		static void HandleCrash(const char* crashInfo, bool callAbort = true) noexcept;
 	};
 
 }; // namespace util
@@ -0,0 +1,108 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-logring.h"
+#include <cstring>
+
+util::LogRing::LogRing(size_t capacity, size_t arenaSize)
+    : entries(new Entry[capacity]), capacity(capacity), first(0), count(0), arena(new char[arenaSize]),
+      arenaSize(arenaSize), head(0), lastEvicted(0)
+{}
+
+void util::LogRing::push(uint64_t sequence, int level, const char* text, size_t length)
+{
+	if (length > arenaSize / 4)
+		length = arenaSize / 4;
+
+	if (count == capacity)
+		evictOldest();
+
+	// Text is laid out in push order, wrapping to the start of the arena when
+	//  it does not fit before the end. Evict from the oldest entry until the
+	//  space it needs is free.
+	size_t offset = (head + length <= arenaSize) ? head : 0;
+	while (count > 0) {
+		size_t oldest = entries[first].offset;
+		bool   overlaps;
+		if (oldest < head) {
+			// Live text is [oldest, head).
+			overlaps = (offset == 0) && (oldest < length);
+		} else {
+			// Live text is [oldest, end) followed by [0, head).
+			overlaps = (offset == 0) || (oldest < head + length);
+		}
+
+		if (!overlaps)
+			break;
+		evictOldest();
+	}
+
+	if (count == 0)
+		offset = 0;
+
+	memcpy(arena.get() + offset, text, length);
+	head = offset + length;
+
+	Entry& entry   = entries[(first + count) % capacity];
+	entry.sequence = sequence;
+	entry.level    = level;
+	entry.offset   = offset;
+	entry.length   = length;
+	count++;
+}
+
+size_t util::LogRing::size() const
+{
+	return count;
+}
+
+const util::LogRing::Entry& util::LogRing::at(size_t index) const
+{
+	return entries[(first + index) % capacity];
+}
+
+const char* util::LogRing::text(const Entry& entry) const
+{
+	return arena.get() + entry.offset;
+}
+
+size_t util::LogRing::find(uint64_t after) const
+{
+	// Sequence numbers only grow, so the entries are sorted.
+	size_t low = 0, high = count;
+	while (low < high) {
+		size_t middle = low + (high - low) / 2;
+		if (at(middle).sequence <= after)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low;
+}
+
+uint64_t util::LogRing::evicted() const
+{
+	return lastEvicted;
+}
+
+void util::LogRing::evictOldest()
+{
+	lastEvicted = entries[first].sequence;
+	first       = (first + 1) % capacity;
+	count--;
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace util
+{
+	// Fixed capacity log history. Message text is copied into a circular
+	//  arena allocated once, so pushing never allocates; the oldest entries
+	//  are evicted when either the entries or the arena run out of room.
+	//  Entries keep the sequence number they were pushed with.
+	//  Not thread safe.
+	class LogRing
+	{
+		public:
+		struct Entry
+		{
+			uint64_t sequence;
+			int      level;
+			size_t   offset;
+			size_t   length;
+		};
+
+		LogRing(size_t capacity, size_t arenaSize);
+
+		// Text longer than a quarter of the arena is truncated.
+		void push(uint64_t sequence, int level, const char* text, size_t length);
+
+		size_t size() const;
+		// Index 0 is the oldest entry.
+		const Entry& at(size_t index) const;
+		const char*  text(const Entry& entry) const;
+
+		// Index of the first entry pushed after the given sequence number,
+		//  or size() if there is none.
+		size_t find(uint64_t after) const;
+
+		// Sequence number of the newest entry evicted so far, 0 if none.
+		uint64_t evicted() const;
+
+		private:
+		void evictOldest();
+
+		std::unique_ptr<Entry[]> entries;
+		size_t                   capacity;
+		size_t                   first;
+		size_t                   count;
+
+		std::unique_ptr<char[]> arena;
+		size_t                  arenaSize;
+		size_t                  head;
+
+		uint64_t lastEvicted;
+	};
+} // namespace util
@@ -0,0 +1,238 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-logsink.h"
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <util/base.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// Warnings and errors wait this many yields for room before being dropped.
+static const int ImportantRetries = 64;
+
+// How long flush() tries to get hold of the batch writer.
+static const std::chrono::milliseconds FlushTimeout(100);
+
+static uint32_t current_thread_id()
+{
+#ifdef _WIN32
+	return GetCurrentThreadId();
+#else
+	return uint32_t(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+}
+
+util::LogSink::LogSink(BatchWriter writer)
+    : writer(writer), slots(new Slot[Capacity]), enqueuePos(0), dequeuePos(0), dropped(0), batch(Capacity),
+      running(false), producers(0), waiting(false)
+{
+	for (size_t idx = 0; idx < Capacity; idx++) {
+		slots[idx].sequence.store(idx, std::memory_order_relaxed);
+		slots[idx].heap = nullptr;
+	}
+}
+
+util::LogSink::~LogSink()
+{
+	stop();
+}
+
+void util::LogSink::start()
+{
+	if (running.exchange(true))
+		return;
+	worker = std::thread(&LogSink::run, this);
+}
+
+void util::LogSink::stop()
+{
+	if (!running.exchange(false))
+		return;
+
+	wake.notify_one();
+	if (worker.joinable())
+		worker.join();
+
+	// A thread that saw the sink running may still be queueing its message.
+	while (producers.load() != 0)
+		std::this_thread::yield();
+
+	// Whatever was queued while the writer was exiting.
+	std::unique_lock<std::mutex> ulock(writeMutex);
+	size_t                       count = drain();
+	uint64_t                     lost  = dropped.exchange(0);
+	if (count || lost)
+		writer(batch.data(), count, lost);
+}
+
+void util::LogSink::flush()
+{
+	// The writer thread may be stuck, or be the one crashing.
+	std::unique_lock<std::mutex> ulock(writeMutex, std::defer_lock);
+	auto                         deadline = std::chrono::steady_clock::now() + FlushTimeout;
+	while (!ulock.try_lock()) {
+		if (std::chrono::steady_clock::now() >= deadline)
+			return;
+		std::this_thread::yield();
+	}
+
+	size_t   count = drain();
+	uint64_t lost  = dropped.exchange(0);
+	if (count || lost)
+		writer(batch.data(), count, lost);
+}
+
+void util::LogSink::push(int level, const char* format, va_list args)
+{
+	// Paired with stop(): either it sees this producer, or this sees it stopped.
+	producers.fetch_add(1);
+	if (!running.load()) {
+		producers.fetch_sub(1);
+
+		va_list copy;
+		va_copy(copy, args);
+		int length = vsnprintf(nullptr, 0, format, copy);
+		va_end(copy);
+		if (length < 0)
+			return;
+
+		LogMessage message;
+		message.time   = std::chrono::high_resolution_clock::now();
+		message.level  = level;
+		message.thread = current_thread_id();
+		message.text.resize(size_t(length) + 1);
+		vsnprintf(&message.text[0], message.text.size(), format, args);
+		message.text.resize(size_t(length));
+
+		std::unique_lock<std::mutex> ulock(writeMutex);
+		writer(&message, 1, dropped.exchange(0));
+		return;
+	}
+
+	bool queued = enqueue(level, format, args);
+	for (int retry = 0; !queued && level <= LOG_WARNING && retry < ImportantRetries; retry++) {
+		std::this_thread::yield();
+		queued = enqueue(level, format, args);
+	}
+	if (!queued)
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	else if (waiting.load(std::memory_order_acquire))
+		wake.notify_one();
+	producers.fetch_sub(1, std::memory_order_release);
+}
+
+// Bounded queue after Dmitry Vyukov: a slot is free for the producer at
+//  position 'pos' when its sequence is 'pos', and readable once it is
+//  'pos + 1'. Producers only contend on enqueuePos.
+bool util::LogSink::enqueue(int level, const char* format, va_list args)
+{
+	uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+	Slot*    slot;
+	for (;;) {
+		slot         = &slots[pos & (Capacity - 1)];
+		uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+		int64_t  dif = int64_t(seq) - int64_t(pos);
+		if (dif == 0) {
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		} else if (dif < 0) {
+			return false;
+		} else {
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->time   = std::chrono::high_resolution_clock::now();
+	slot->level  = level;
+	slot->thread = current_thread_id();
+
+	va_list copy;
+	va_copy(copy, args);
+	int length = vsnprintf(slot->text, TextSize, format, copy);
+	va_end(copy);
+
+	slot->length = length < 0 ? 0 : size_t(length);
+	if (slot->length >= TextSize) {
+		slot->heap = static_cast<char*>(malloc(slot->length + 1));
+		if (slot->heap)
+			vsnprintf(slot->heap, slot->length + 1, format, args);
+		else
+			slot->length = TextSize - 1;
+	}
+
+	slot->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+size_t util::LogSink::drain()
+{
+	size_t count = 0;
+	while (count < Capacity) {
+		Slot& slot = slots[dequeuePos & (Capacity - 1)];
+		if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+			break;
+
+		LogMessage& message = batch[count++];
+		message.time        = slot.time;
+		message.level       = slot.level;
+		message.thread      = slot.thread;
+		if (slot.heap) {
+			message.text.assign(slot.heap, slot.length);
+			free(slot.heap);
+			slot.heap = nullptr;
+		} else {
+			message.text.assign(slot.text, slot.length);
+		}
+
+		slot.sequence.store(dequeuePos + Capacity, std::memory_order_release);
+		dequeuePos++;
+	}
+	return count;
+}
+
+void util::LogSink::run()
+{
+	for (;;) {
+		bool     stopping = !running.load(std::memory_order_acquire);
+		size_t   count    = 0;
+		uint64_t lost     = 0;
+		{
+			std::unique_lock<std::mutex> ulock(writeMutex);
+			count = drain();
+			lost  = dropped.exchange(0);
+			if (count || lost)
+				writer(batch.data(), count, lost);
+		}
+
+		if (count)
+			continue;
+		if (stopping)
+			break;
+
+		// Producers only notify while this is set; the timeout covers a
+		//  notification sent just before waiting.
+		std::unique_lock<std::mutex> ulock(wakeMutex);
+		waiting.store(true, std::memory_order_release);
+		wake.wait_for(ulock, std::chrono::milliseconds(20));
+		waiting.store(false, std::memory_order_release);
+	}
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+	struct LogMessage
+	{
+		std::chrono::high_resolution_clock::time_point time;
+		int                                            level;
+		uint32_t                                       thread; // Thread that logged the message.
+		std::string                                    text;
+	};
+
+	// Moves log formatting and I/O off the threads that log, which include
+	//  the graphics and audio threads. Logging only formats the message into
+	//  a slot of a fixed size lock-free ring; a writer thread hands whole
+	//  batches to the BatchWriter. When the ring is full, messages are
+	//  dropped and the writer is told how many were lost.
+	class LogSink
+	{
+		public:
+		typedef void (*BatchWriter)(const LogMessage* messages, size_t count, uint64_t dropped);
+
+		static const size_t Capacity = 2048;
+		static const size_t TextSize = 480;
+
+		LogSink(BatchWriter writer);
+		~LogSink();
+
+		void start();
+		// Writes everything still queued. Messages logged afterwards are
+		//  written by the thread logging them.
+		void stop();
+		// Writes everything queued so far from the calling thread, for the
+		//  crash handler. Gives up instead of blocking if another thread
+		//  keeps the batch writer busy for too long.
+		void flush();
+
+		void push(int level, const char* format, va_list args);
+
+		private:
+		struct Slot
+		{
+			std::atomic<uint64_t>                          sequence;
+			std::chrono::high_resolution_clock::time_point time;
+			int                                            level;
+			uint32_t                                       thread;
+			size_t                                         length;
+			char*                                          heap; // Text longer than TextSize.
+			char                                           text[TextSize];
+		};
+
+		bool   enqueue(int level, const char* format, va_list args);
+		size_t drain();
+		void   run();
+
+		BatchWriter             writer;
+		std::unique_ptr<Slot[]> slots;
+		std::atomic<uint64_t>   enqueuePos;
+		uint64_t                dequeuePos;
+		std::atomic<uint64_t>   dropped;
+		std::vector<LogMessage> batch;
+
+		std::atomic<bool>       running;
+		std::atomic<uint32_t>   producers; // Threads inside push() that saw 'running'.
+		std::atomic<bool>       waiting;
+		std::mutex              wakeMutex;
+		std::condition_variable wake;
+		std::thread             worker;
+
+		// Held to drain and write batches, by the writer thread, flush(), or
+		//  a thread logging while the sink is stopped.
+		std::mutex writeMutex;
+	};
+} // namespace util
@@ -0,0 +1,95 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-messagering.h"
+#include <cstring>
+#include <thread>
+
+util::MessageRing::MessageRing() : next(0), cleared(0)
+{
+	for (size_t idx = 0; idx < Capacity; idx++) {
+		slots[idx].sequence.store(0, std::memory_order_relaxed);
+		slots[idx].length = 0;
+	}
+}
+
+void util::MessageRing::push(const char* text, size_t length)
+{
+	uint64_t position = next.fetch_add(1, std::memory_order_relaxed);
+	Slot&    slot     = slots[position % Capacity];
+	uint64_t writing  = position * 2 + 1;
+
+	// Writers of the same slot are a whole lap apart; wait for an older one
+	//  to finish, and give up if a newer one already took the slot.
+	uint64_t current = slot.sequence.load(std::memory_order_relaxed);
+	for (;;) {
+		if (current >= writing)
+			return;
+		if (current & 1) {
+			std::this_thread::yield();
+			current = slot.sequence.load(std::memory_order_relaxed);
+			continue;
+		}
+		if (slot.sequence.compare_exchange_weak(
+		        current, writing, std::memory_order_acquire, std::memory_order_relaxed))
+			break;
+	}
+
+	if (length > TextSize)
+		length = TextSize;
+	memcpy(slot.text, text, length);
+	slot.length = length;
+
+	slot.sequence.store(writing + 1, std::memory_order_release);
+}
+
+void util::MessageRing::clear()
+{
+	cleared.store(next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+uint64_t util::MessageRing::begin() const
+{
+	uint64_t last  = end();
+	uint64_t first = cleared.load(std::memory_order_relaxed);
+	if (last > Capacity && last - Capacity > first)
+		first = last - Capacity;
+	return first;
+}
+
+uint64_t util::MessageRing::end() const
+{
+	return next.load(std::memory_order_relaxed);
+}
+
+bool util::MessageRing::read(uint64_t position, char* text, size_t& length) const
+{
+	const Slot& slot     = slots[position % Capacity];
+	uint64_t    complete = position * 2 + 2;
+	if (slot.sequence.load(std::memory_order_acquire) != complete)
+		return false;
+
+	length = slot.length;
+	if (length > TextSize)
+		length = TextSize;
+	memcpy(text, slot.text, length);
+
+	// The copy is only valid if no writer took the slot meanwhile.
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return slot.sequence.load(std::memory_order_relaxed) == complete;
+}
@@ -0,0 +1,64 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace util
+{
+	// Fixed ring of the most recent short messages, such as crash report
+	//  breadcrumbs. Pushing is lock-free and never allocates; messages
+	//  longer than a slot are truncated and the oldest message is
+	//  overwritten once the ring is full. Reading never allocates either,
+	//  so it is safe from a crash handler.
+	class MessageRing
+	{
+		public:
+		static const size_t Capacity = 64;
+		static const size_t TextSize = 248;
+
+		MessageRing();
+
+		void push(const char* text, size_t length);
+		// Messages pushed before this are no longer read.
+		void clear();
+
+		// Positions of the messages still held are [begin(), end()).
+		uint64_t begin() const;
+		uint64_t end() const;
+
+		// Copies the message at a position into 'text', or returns false if it
+		//  was overwritten or is still being written.
+		bool read(uint64_t position, char* text, size_t& length) const;
+
+		private:
+		// A slot's sequence is 2 * position + 1 while the message at that
+		//  position is written and 2 * position + 2 once it is complete.
+		struct Slot
+		{
+			std::atomic<uint64_t> sequence;
+			size_t                length;
+			char                  text[TextSize];
+		};
+
+		Slot                  slots[Capacity];
+		std::atomic<uint64_t> next;
+		std::atomic<uint64_t> cleared;
+	};
+} // namespace util
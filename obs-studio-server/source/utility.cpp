@@ -18,162 +18,115 @@
 
 #include "utility.hpp"
 
-utility::unique_id::unique_id() {}
-
-utility::unique_id::~unique_id() {}
-
-utility::unique_id::id_t utility::unique_id::allocate()
+utility::handle_table::handle_table() : capacity(0), live(0)
 {
-	if (allocated.size() > 0) {
-		for (auto& v : allocated) {
-			if (v.first > 0) {
-				utility::unique_id::id_t v2 = v.first - 1;
-				mark_used(v2);
-				return v2;
-			} else if (v.second < std::numeric_limits<utility::unique_id::id_t>::max()) {
-				utility::unique_id::id_t v2 = v.second + 1;
-				mark_used(v2);
-				return v2;
-			}
-		}
-	} else {
-		mark_used(0);
-		return 0;
+	for (uint32_t idx = 0; idx < max_pages; idx++) {
+		pages[idx].store(nullptr, std::memory_order_relaxed);
 	}
-
-	// No more free indexes. However that has happened.
-	return std::numeric_limits<utility::unique_id::id_t>::max();
 }
 
-void utility::unique_id::free(utility::unique_id::id_t v)
+utility::handle_table::~handle_table()
 {
-	mark_free(v);
+	for (uint32_t idx = 0; idx < max_pages; idx++) {
+		delete[] pages[idx].load(std::memory_order_relaxed);
+	}
 }
 
-bool utility::unique_id::is_allocated(utility::unique_id::id_t v)
+utility::handle_table::id_t utility::handle_table::allocate(void* value)
 {
-	for (auto& v2 : allocated) {
-		if ((v >= v2.first) && (v <= v2.second))
-			return true;
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	uint32_t index;
+	if (free_slots.size() > 0) {
+		index = free_slots.back();
+		free_slots.pop_back();
+	} else {
+		index = capacity.load(std::memory_order_relaxed);
+		if ((index >> page_bits) >= max_pages) {
+			// No more free slots. However that has happened.
+			return invalid_id;
+		}
+
+		if ((index & page_mask) == 0) {
+			slot* page = new slot[page_size];
+			for (uint32_t idx = 0; idx < page_size; idx++) {
+				page[idx].generation.store(1, std::memory_order_relaxed);
+				page[idx].value.store(nullptr, std::memory_order_relaxed);
+			}
+			pages[index >> page_bits].store(page, std::memory_order_release);
+		}
+		capacity.store(index + 1, std::memory_order_release);
 	}
-	return false;
+
+	// The generation was already advanced when the slot was last freed, so the
+	//  value only has to be published.
+	slot& s = pages[index >> page_bits].load(std::memory_order_relaxed)[index & page_mask];
+	s.value.store(value, std::memory_order_release);
+	live++;
+
+	return (id_t(s.generation.load(std::memory_order_relaxed)) << 32) | index;
 }
 
-utility::unique_id::id_t utility::unique_id::count(bool count_free)
+void* utility::handle_table::free(id_t id)
 {
-	id_t count = 0;
-	for (auto& v : allocated) {
-		count += (v.second - v.first);
-	}
-	return count_free ? (std::numeric_limits<id_t>::max() - count) : count;
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	uint32_t index = uint32_t(id & 0xFFFFFFFF);
+	if (index >= capacity.load(std::memory_order_relaxed))
+		return nullptr;
+
+	slot&    s          = pages[index >> page_bits].load(std::memory_order_relaxed)[index & page_mask];
+	uint32_t generation = s.generation.load(std::memory_order_relaxed);
+	void*    value      = s.value.load(std::memory_order_relaxed);
+	if ((generation != uint32_t(id >> 32)) || (value == nullptr))
+		return nullptr;
+
+	// Invalidate outstanding ids before clearing the value, so a concurrent
+	//  find() either sees the old value with a matching generation or fails.
+	generation++;
+	if (generation == 0)
+		generation = 1;
+	s.generation.store(generation, std::memory_order_release);
+	s.value.store(nullptr, std::memory_order_release);
+
+	free_slots.push_back(index);
+	live--;
+	return value;
 }
 
-bool utility::unique_id::mark_used(utility::unique_id::id_t v)
+bool utility::handle_table::is_allocated(id_t id) const
 {
-	// If no elements have been assigned, simply insert v as used.
-	if (allocated.size() == 0) {
-		range_t r;
-		r.first = r.second = v;
-		allocated.push_back(r);
-		return true;
-	}
-
-	// Otherwise, attempt to find the best fitting element.
-	bool lastWasSmaller = false;
-	for (auto iter = allocated.begin(); iter != allocated.end(); iter++) {
-		auto fiter = std::list<range_t>::iterator(iter);
-		auto riter = std::list<range_t>::reverse_iterator(iter);
-		if ((iter->first > 0) && (v == (iter->first - 1))) {
-			// If the minimum of the selected element is > 0 and v is equal to
-			//  (minimum - 1), decrease the minimum.
-			iter->first--;
-
-			// Then test if the previous elements maximum is equal to (v - 1),
-			//  if so merge the two since they are now continuous.
-			riter--;
-			if ((riter != allocated.rend()) && (riter->second == (v - 1))) {
-				riter->second = iter->second;
-				allocated.erase(iter);
-			}
-
-			return true;
-		} else if ((iter->second < std::numeric_limits<utility::unique_id::id_t>::max()) && (v == (iter->second + 1))) {
-			// If the maximum of the selected element is < UINT_MAX and v is
-			//  equal to (maximum + 1), increase the maximum.
-			iter->second++;
-
-			// Then test if the next elements minimum is equal to (v + 1),
-			//  if so merge the two since they are now continuous.
-			fiter++;
-			if ((fiter != allocated.end()) && (fiter->first == (v + 1))) {
-				iter->second = fiter->second;
-				allocated.erase(fiter);
-			}
-
-			return true;
-		} else if (lastWasSmaller && (v < iter->first)) {
-			// If we are between two ranges that are smaller and larger than v
-			//  insert a new element before the larger range containing only v.
-			allocated.insert(iter, {v, v});
-			return true;
-		} else if ((fiter++) == allocated.end()) {
-			// Otherwise if we reached the end of the list, append v.
-			allocated.insert(fiter, {v, v});
-			return true;
-		}
-		lastWasSmaller = (v > iter->second);
-	}
-	return false;
+	return find(id) != nullptr;
 }
 
-void utility::unique_id::mark_used_range(utility::unique_id::id_t min, utility::unique_id::id_t max)
+utility::handle_table::id_t utility::handle_table::count() const
 {
-	for (utility::unique_id::id_t v = min; v < max; v++) {
-		mark_used(v);
-	}
+	return live;
 }
 
-bool utility::unique_id::mark_free(utility::unique_id::id_t v)
+void utility::handle_table::for_each(std::function<void(id_t, void*)> for_each_method)
 {
-	for (auto iter = allocated.begin(); iter != allocated.end(); iter++) {
-		// Is v inside this range?
-		if ((v >= iter->first) && (v <= iter->second)) {
-			if (v == iter->first) {
-				// If v is simply the beginning of the range, increase the
-				//  minimum and test if the range is now no longer valid.
-				iter->first++;
-				if (iter->first > iter->second) {
-					// If the range is no longer valid, just erase it.
-					allocated.erase(iter);
-				}
-				return true;
-			} else if (v == iter->second) {
-				// If v is simply the end of the range, decrease the maximum
-				//  and test if the range is now no longer valid.
-				iter->second--;
-				if (iter->second < iter->first) {
-					// If the range is no longer valid, just erase it.
-					allocated.erase(iter);
-				}
-				return true;
-			} else {
-				// Otherwise, since v is inside the range, split the range at
-				// v and insert a new element.
-				range_t x;
-				x.first     = iter->first;
-				x.second    = v - 1;
-				iter->first = v + 1;
-				allocated.insert(iter, x);
-				return true;
-			}
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	uint32_t size = capacity.load(std::memory_order_relaxed);
+	for (uint32_t index = 0; index < size; index++) {
+		slot& s     = pages[index >> page_bits].load(std::memory_order_relaxed)[index & page_mask];
+		void* value = s.value.load(std::memory_order_relaxed);
+		if (value) {
+			for_each_method((id_t(s.generation.load(std::memory_order_relaxed)) << 32) | index, value);
 		}
 	}
-	return false;
 }
 
-void utility::unique_id::mark_free_range(utility::unique_id::id_t min, utility::unique_id::id_t max)
+void utility::handle_table::clear()
 {
-	for (utility::unique_id::id_t v = min; v < max; v++) {
-		mark_free(v);
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	uint32_t size = capacity.load(std::memory_order_relaxed);
+	for (uint32_t index = 0; index < size; index++) {
+		slot& s = pages[index >> page_bits].load(std::memory_order_relaxed)[index & page_mask];
+		if (s.value.load(std::memory_order_relaxed)) {
+			free((id_t(s.generation.load(std::memory_order_relaxed)) << 32) | index);
+		}
 	}
 }
@@ -17,11 +17,13 @@
 ******************************************************************************/
 
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <limits>
-#include <list>
-#include <map>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #if defined(_MSC_VER)
 #define FORCE_INLINE __forceinline
@@ -32,39 +34,76 @@
 
 namespace utility
 {
-	class unique_id
+	// Generational slot map that hands out 64-bit ids for stored pointers.
+	//
+	// An id is (generation << 32 | slot). Freeing a slot bumps its generation,
+	//  so ids held by a client after the object is gone no longer resolve.
+	//  Slots are kept in fixed pages that are never moved while the table
+	//  exists, which lets find() run without taking the lock. allocate(), free()
+	//  and for_each() are serialized by a recursive mutex.
+	class handle_table
 	{
 		public:
-		typedef uint64_t              id_t;
-		typedef std::pair<id_t, id_t> range_t;
+		typedef uint64_t id_t;
+
+		static const id_t invalid_id = std::numeric_limits<id_t>::max();
 
 		public:
-		unique_id();
-		virtual ~unique_id();
+		handle_table();
+		virtual ~handle_table();
 
-		id_t allocate();
-		void free(id_t);
+		id_t  allocate(void* value);
+		void* free(id_t id);
 
-		bool is_allocated(id_t);
-		id_t count(bool count_free);
+		force_inline void* find(id_t id) const
+		{
+			uint32_t index = uint32_t(id & 0xFFFFFFFF);
+			if (index >= capacity.load(std::memory_order_acquire))
+				return nullptr;
 
-		protected:
-		bool mark_used(id_t);
-		void mark_used_range(id_t, id_t);
-		bool mark_free(id_t);
-		void mark_free_range(id_t, id_t);
+			const slot& s     = pages[index >> page_bits].load(std::memory_order_acquire)[index & page_mask];
+			void*       value = s.value.load(std::memory_order_acquire);
+			if (s.generation.load(std::memory_order_acquire) != uint32_t(id >> 32))
+				return nullptr;
+			return value;
+		}
+
+		bool is_allocated(id_t id) const;
+		id_t count() const;
+
+		void for_each(std::function<void(id_t, void*)> for_each_method);
+		void clear();
 
 		private:
-		std::list<range_t> allocated;
+		struct slot
+		{
+			std::atomic<uint32_t> generation;
+			std::atomic<void*>    value;
+		};
+
+		static const uint32_t page_bits = 10;
+		static const uint32_t page_size = 1 << page_bits;
+		static const uint32_t page_mask = page_size - 1;
+		static const uint32_t max_pages = 4096;
+
+		std::atomic<slot*>    pages[max_pages];
+		std::atomic<uint32_t> capacity;
+		std::vector<uint32_t> free_slots;
+		id_t                  live;
+		std::recursive_mutex  internal_mutex;
 	};
 
 	template<typename T>
 	class unique_object_manager
 	{
 		protected:
-		utility::unique_id                     id_generator;
-		std::map<utility::unique_id::id_t, T*> object_map;
-		std::recursive_mutex                   internal_mutex;
+		utility::handle_table handles;
+
+		// Reverse index for find(T*) and free(T*). The same object may be
+		//  registered more than once (e.g. a scene source is allocated both by
+		//  Scene.Create and the global source_create signal), hence multimap.
+		std::unordered_multimap<T*, utility::handle_table::id_t> reverse_map;
+		std::recursive_mutex                                     internal_mutex;
 
 		public:
 		unique_object_manager() {}
@@ -73,87 +112,86 @@ namespace utility
 			clear();
 		}
 
-		utility::unique_id::id_t allocate(T* obj)
+		utility::handle_table::id_t allocate(T* obj)
 		{
 			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
 
-			utility::unique_id::id_t uid = id_generator.allocate();
-			if (uid == std::numeric_limits<utility::unique_id::id_t>::max()) {
-				return uid;
-			}
-			object_map.insert_or_assign(uid, obj);
+			utility::handle_table::id_t uid = handles.allocate(obj);
+			if (uid != utility::handle_table::invalid_id)
+				reverse_map.emplace(obj, uid);
 			return uid;
 		}
 
-		utility::unique_id::id_t find(T* obj)
+		utility::handle_table::id_t find(T* obj)
 		{
 			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
 
-			for (auto kv : object_map) {
-				if (kv.second == obj) {
-					return kv.first;
-				}
+			auto iter = reverse_map.find(obj);
+			if (iter != reverse_map.end()) {
+				return iter->second;
 			}
-			return std::numeric_limits<utility::unique_id::id_t>::max();
+			return utility::handle_table::invalid_id;
 		}
-		T* find(utility::unique_id::id_t id)
+		T* find(utility::handle_table::id_t id)
 		{
-			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
-
-			auto iter = object_map.find(id);
-			if (iter != object_map.end()) {
-				return iter->second;
-			}
-			return nullptr;
+			return reinterpret_cast<T*>(handles.find(id));
 		}
 
-		utility::unique_id::id_t free(T* obj)
+		utility::handle_table::id_t free(T* obj)
 		{
 			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
 
-			utility::unique_id::id_t uid = std::numeric_limits<utility::unique_id::id_t>::max();
-			for (auto kv : object_map) {
-				if (kv.second == obj) {
-					uid = kv.first;
-					object_map.erase(kv.first);
-					break;
-				}
+			auto iter = reverse_map.find(obj);
+			if (iter == reverse_map.end()) {
+				return utility::handle_table::invalid_id;
 			}
+			utility::handle_table::id_t uid = iter->second;
+			reverse_map.erase(iter);
+			handles.free(uid);
 			return uid;
 		}
-		T* free(utility::unique_id::id_t id)
+		T* free(utility::handle_table::id_t id)
 		{
 			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
 
-			auto iter = object_map.find(id);
-			if (iter == object_map.end()) {
-				return nullptr;
+			T* obj = reinterpret_cast<T*>(handles.free(id));
+			if (obj) {
+				auto range = reverse_map.equal_range(obj);
+				for (auto iter = range.first; iter != range.second; ++iter) {
+					if (iter->second == id) {
+						reverse_map.erase(iter);
+						break;
+					}
+				}
 			}
-			T* obj = iter->second;
-			object_map.erase(iter);
 			return obj;
 		}
 
         void for_each(std::function<void(T*)> for_each_method)
         {
-            for (auto it = object_map.begin(); it != object_map.end(); ++it) {
-                for_each_method(it->second);
-            }
+            handles.for_each([&for_each_method](utility::handle_table::id_t, void* value) {
+                for_each_method(reinterpret_cast<T*>(value));
+            });
         }
 
         void clear()
         {
-            object_map.clear();
+            std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+            handles.clear();
+            reverse_map.clear();
         }
 	};
 
+	// Same as unique_object_manager, but for values that are not plain
+	//  pointers (e.g. std::shared_ptr). Each value is boxed in a slot, and since
+	//  copying it out is not atomic, lookups take the manager lock.
 	template<typename T>
 	class generic_object_manager
 	{
 		protected:
-		utility::unique_id                    id_generator;
-		std::map<utility::unique_id::id_t, T> object_map;
-		std::recursive_mutex                  internal_mutex;
+		utility::handle_table                                   handles;
+		std::unordered_multimap<T, utility::handle_table::id_t> reverse_map;
+		std::recursive_mutex                                    internal_mutex;
 
 		public:
 		generic_object_manager() {}
@@ -162,77 +200,89 @@ namespace utility
 			clear();
 		}
 
-		utility::unique_id::id_t allocate(T obj)
+		utility::handle_table::id_t allocate(T obj)
 		{
 			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
 
-			utility::unique_id::id_t uid = id_generator.allocate();
-			if (uid == std::numeric_limits<utility::unique_id::id_t>::max()) {
+			T*                          box = new T(obj);
+			utility::handle_table::id_t uid = handles.allocate(box);
+			if (uid == utility::handle_table::invalid_id) {
+				delete box;
 				return uid;
 			}
-			object_map.insert_or_assign(uid, obj);
+			reverse_map.emplace(obj, uid);
 			return uid;
 		}
 
-		utility::unique_id::id_t find(T obj)
+		utility::handle_table::id_t find(T obj)
 		{
 			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
 
-			for (auto kv : object_map) {
-				if (kv.second == obj) {
-					return kv.first;
-				}
+			auto iter = reverse_map.find(obj);
+			if (iter != reverse_map.end()) {
+				return iter->second;
 			}
-			return std::numeric_limits<utility::unique_id::id_t>::max();
+			return utility::handle_table::invalid_id;
 		}
-		T find(utility::unique_id::id_t id)
+		T find(utility::handle_table::id_t id)
 		{
 			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
 
-			auto iter = object_map.find(id);
-			if (iter != object_map.end()) {
-				return iter->second;
+			T* box = reinterpret_cast<T*>(handles.find(id));
+			if (!box) {
+				return nullptr;
 			}
-			return nullptr;
+			return *box;
 		}
 
-		utility::unique_id::id_t free(T obj)
+		utility::handle_table::id_t free(T obj)
 		{
 			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
 
-			utility::unique_id::id_t uid = std::numeric_limits<utility::unique_id::id_t>::max();
-			for (auto kv : object_map) {
-				if (kv.second == obj) {
-					uid = kv.first;
-					object_map.erase(kv.first);
-					break;
-				}
+			auto iter = reverse_map.find(obj);
+			if (iter == reverse_map.end()) {
+				return utility::handle_table::invalid_id;
 			}
+			utility::handle_table::id_t uid = iter->second;
+			reverse_map.erase(iter);
+			delete reinterpret_cast<T*>(handles.free(uid));
 			return uid;
 		}
-		T free(utility::unique_id::id_t id)
+		T free(utility::handle_table::id_t id)
 		{
 			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
 
-			auto iter = object_map.find(id);
-			if (iter == object_map.end()) {
+			T* box = reinterpret_cast<T*>(handles.free(id));
+			if (!box) {
 				return nullptr;
 			}
-			T obj = iter->second;
-			object_map.erase(iter);
+			T obj = *box;
+			delete box;
+
+			auto range = reverse_map.equal_range(obj);
+			for (auto iter = range.first; iter != range.second; ++iter) {
+				if (iter->second == id) {
+					reverse_map.erase(iter);
+					break;
+				}
+			}
 			return obj;
 		}
 
         void for_each(std::function<void(T&)> for_each_method)
         {
-            for (auto it = object_map.begin(); it != object_map.end(); ++it) {
-                for_each_method(it->second);
-            }
+            std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+            handles.for_each([&for_each_method](utility::handle_table::id_t, void* value) {
+                for_each_method(*reinterpret_cast<T*>(value));
+            });
         }
 
         void clear()
         {
-            object_map.clear();
+            std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+            handles.for_each([](utility::handle_table::id_t, void* value) { delete reinterpret_cast<T*>(value); });
+            handles.clear();
+            reverse_map.clear();
         }
 	};
 } // namespace utility
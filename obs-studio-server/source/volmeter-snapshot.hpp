@@ -0,0 +1,94 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace volmeter
+{
+	template<size_t Channels>
+	struct audio_data
+	{
+		float   magnitude[Channels]  = {0};
+		float   peak[Channels]       = {0};
+		float   input_peak[Channels] = {0};
+		int32_t ch                   = 0;
+	};
+
+	// Last frame of a meter, published through a sequence lock.
+	//
+	// There is a single writer (the libobs audio thread) that never waits.
+	//  Readers retry when they raced a write, so they always see a complete
+	//  frame without ever stalling the writer.
+	template<size_t Channels>
+	class snapshot
+	{
+		std::atomic<uint32_t> sequence;
+		std::atomic<int32_t>  ch;
+		std::atomic<float>    magnitude[Channels];
+		std::atomic<float>    peak[Channels];
+		std::atomic<float>    input_peak[Channels];
+
+		public:
+		snapshot() : sequence(0)
+		{
+			store(audio_data<Channels>());
+		}
+
+		void store(const audio_data<Channels>& data)
+		{
+			// An odd sequence marks a write in progress.
+			uint32_t seq = sequence.load(std::memory_order_relaxed);
+			sequence.store(seq + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			ch.store(data.ch, std::memory_order_relaxed);
+			for (size_t idx = 0; idx < Channels; idx++) {
+				magnitude[idx].store(data.magnitude[idx], std::memory_order_relaxed);
+				peak[idx].store(data.peak[idx], std::memory_order_relaxed);
+				input_peak[idx].store(data.input_peak[idx], std::memory_order_relaxed);
+			}
+
+			sequence.store(seq + 2, std::memory_order_release);
+		}
+
+		void load(audio_data<Channels>& data) const
+		{
+			uint32_t seq0, seq1;
+			do {
+				seq0 = sequence.load(std::memory_order_acquire);
+				if (seq0 & 1) {
+					seq1 = seq0 + 1;
+					continue;
+				}
+
+				data.ch = ch.load(std::memory_order_relaxed);
+				for (size_t idx = 0; idx < Channels; idx++) {
+					data.magnitude[idx]  = magnitude[idx].load(std::memory_order_relaxed);
+					data.peak[idx]       = peak[idx].load(std::memory_order_relaxed);
+					data.input_peak[idx] = input_peak[idx].load(std::memory_order_relaxed);
+				}
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				seq1 = sequence.load(std::memory_order_relaxed);
+			} while (seq0 != seq1);
+		}
+	};
+} // namespace volmeter
@@ -0,0 +1,65 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Latency histograms of System.GetCallStats. Durations are bucketed in
+//  microseconds on a log-linear scale: below 2^SubBucketBits every value
+//  has its own bucket, above it every power of two is split into
+//  2^SubBucketBits buckets, so a bucket is at most 12.5% wide.
+//
+// The reply is a settings_buffer with a size_t function count followed by
+//  only the functions that were called:
+//  - collection, function:         string
+//  - count, totalNs, maxNs:        uint64_t
+//  - bucket count:                 uint32_t
+//  - buckets (index, calls):       uint16_t, uint32_t each; empty ones left out
+namespace call_stats
+{
+	static const size_t SubBucketBits = 3;
+	static const size_t SubBuckets    = size_t(1) << SubBucketBits;
+	static const size_t MaximumBits   = 26;
+
+	// About 67 seconds, longer calls share the last bucket.
+	static const uint64_t MaximumUs   = (uint64_t(1) << MaximumBits) - 1;
+	static const size_t   BucketCount = (MaximumBits - SubBucketBits + 1) * SubBuckets;
+
+	inline size_t bucket_index(uint64_t us)
+	{
+		if (us > MaximumUs)
+			us = MaximumUs;
+		if (us < SubBuckets)
+			return size_t(us);
+
+		size_t magnitude = 0;
+		while ((us >> magnitude) >= 2 * SubBuckets)
+			magnitude++;
+		return (magnitude + 1) * SubBuckets + size_t(us >> magnitude) - SubBuckets;
+	}
+
+	// Smallest duration, in microseconds, that falls into a bucket.
+	inline uint64_t bucket_lower(size_t index)
+	{
+		if (index < SubBuckets)
+			return index;
+
+		size_t magnitude = index / SubBuckets - 1;
+		return uint64_t(SubBuckets + index % SubBuckets) << magnitude;
+	}
+} // namespace call_stats
@@ -0,0 +1,153 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <inttypes.h>
+#include <string>
+#include <vector>
+
+// Typed events multiplexed into the single reply of Events.Poll.
+//
+// A buffer is a plain sequence of frames, each frame being a frame_header
+//  followed by 'size' bytes of payload. Payloads are built from fixed-size
+//  values and u32 length-prefixed strings:
+//  - output_signal:   string type, string signal, int32 code, string error,
+//                     uint64 timestamp (server os_gettime_ns)
+//  - source_size:     uint32 count, then per source: uint64 uid, string name,
+//                     uint32 width, height, flags
+//  - volmeter_frames: packed frames as described in volmeter-frame.hpp
+//  - autoconfig:      string event, string description, double percentage
+//  - scene_item:      uint32 count, then per item: uint64 id, uint64 version
+//                     (UINT64_MAX once the item is gone)
+namespace event_frame
+{
+	enum class type : uint32_t
+	{
+		output_signal   = 0,
+		source_size     = 1,
+		volmeter_frames = 2,
+		autoconfig      = 3,
+		scene_item      = 4,
+	};
+
+	struct frame_header
+	{
+		uint32_t type;
+		uint32_t size;
+	};
+
+	// Appends one frame to 'buf'. The payload size is patched in when the
+	//  writer goes out of scope, so payload can also be appended to 'buf'
+	//  directly in between.
+	class writer
+	{
+		std::vector<char>& buf;
+		size_t             start;
+
+		public:
+		writer(std::vector<char>& buf, type t) : buf(buf), start(buf.size())
+		{
+			frame_header hdr = {uint32_t(t), 0};
+			buf.resize(start + sizeof(frame_header));
+			std::memcpy(&buf[start], &hdr, sizeof(frame_header));
+		}
+		~writer()
+		{
+			uint32_t size = uint32_t(buf.size() - start - sizeof(frame_header));
+			std::memcpy(&buf[start + offsetof(frame_header, size)], &size, sizeof(uint32_t));
+		}
+
+		template<typename T>
+		void write(const T& value)
+		{
+			size_t offset = buf.size();
+			buf.resize(offset + sizeof(T));
+			std::memcpy(&buf[offset], &value, sizeof(T));
+		}
+		void write(const std::string& value)
+		{
+			write(uint32_t(value.size()));
+			buf.insert(buf.end(), value.begin(), value.end());
+		}
+	};
+
+	// Reads values from a single frame payload. Every read fails once the
+	//  payload is exhausted, so callers only need to check the last one.
+	class reader
+	{
+		const char* data;
+		size_t      size;
+		size_t      offset;
+
+		public:
+		reader() : data(nullptr), size(0), offset(0) {}
+		reader(const char* data, size_t size) : data(data), size(size), offset(0) {}
+
+		template<typename T>
+		bool read(T& value)
+		{
+			if (size - offset < sizeof(T)) {
+				offset = size;
+				return false;
+			}
+			std::memcpy(&value, data + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+		bool read(std::string& value)
+		{
+			uint32_t length = 0;
+			if (!read(length) || (size - offset < length)) {
+				offset = size;
+				return false;
+			}
+			value.assign(data + offset, length);
+			offset += length;
+			return true;
+		}
+
+		// Remaining payload, for types that embed their own packed format.
+		std::vector<char> remaining() const
+		{
+			return std::vector<char>(data + offset, data + size);
+		}
+	};
+
+	// Reads the frame at 'offset' and advances it. Returns false once the
+	//  buffer is exhausted or the remaining data is truncated.
+	inline bool read_frame(std::vector<char> const& buf, size_t& offset, type& t, reader& payload)
+	{
+		if (buf.size() < offset + sizeof(frame_header)) {
+			return false;
+		}
+
+		frame_header hdr;
+		std::memcpy(&hdr, &buf[offset], sizeof(frame_header));
+		if (buf.size() - offset - sizeof(frame_header) < hdr.size) {
+			return false;
+		}
+		offset += sizeof(frame_header);
+
+		t       = type(hdr.type);
+		payload = reader(buf.data() + offset, hdr.size);
+		offset += hdr.size;
+		return true;
+	}
+} // namespace event_frame
@@ -0,0 +1,116 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <cstring>
+#include <inttypes.h>
+#include <string>
+#include <vector>
+
+// Binary encoding of settings objects, used instead of JSON where settings
+//  are sent often or can get large.
+//
+// An object is a uint32 item count followed by per item its string name, a
+//  uint8 type and the value:
+//  - boolean: uint8
+//  - integer: int64
+//  - number:  double
+//  - string:  string
+//  - object:  object
+//  - array:   uint32 count followed by that many objects
+// Strings are a uint32 length followed by the characters, not terminated.
+namespace obs_data_binary
+{
+	enum class type : uint8_t
+	{
+		boolean = 0,
+		integer = 1,
+		number  = 2,
+		string  = 3,
+		object  = 4,
+		array   = 5,
+	};
+
+	class writer
+	{
+		std::vector<char>& buf;
+
+		public:
+		writer(std::vector<char>& buf) : buf(buf) {}
+
+		template<typename T>
+		void write(const T& value)
+		{
+			size_t offset = buf.size();
+			buf.resize(offset + sizeof(T));
+			std::memcpy(&buf[offset], &value, sizeof(T));
+		}
+		void write(const char* value, size_t length)
+		{
+			write(uint32_t(length));
+			buf.insert(buf.end(), value, value + length);
+		}
+
+		// Counts are often only known once the items are written: reserve
+		//  one here and patch it in later.
+		size_t reserve_count()
+		{
+			size_t offset = buf.size();
+			write(uint32_t(0));
+			return offset;
+		}
+		void patch_count(size_t offset, uint32_t count)
+		{
+			std::memcpy(&buf[offset], &count, sizeof(uint32_t));
+		}
+	};
+
+	// Every read fails once the buffer is exhausted, so callers only need to
+	//  check the last one.
+	class reader
+	{
+		const char* data;
+		size_t      size;
+		size_t      offset;
+
+		public:
+		reader(std::vector<char> const& buf) : data(buf.data()), size(buf.size()), offset(0) {}
+
+		template<typename T>
+		bool read(T& value)
+		{
+			if (size - offset < sizeof(T)) {
+				offset = size;
+				return false;
+			}
+			std::memcpy(&value, data + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+		// Points 'value' into the buffer, nothing is copied.
+		bool read(const char*& value, uint32_t& length)
+		{
+			if (!read(length) || (size - offset < length)) {
+				offset = size;
+				return false;
+			}
+			value = data + offset;
+			offset += length;
+			return true;
+		}
+	};
+} // namespace obs_data_binary
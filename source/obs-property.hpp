@@ -17,13 +17,142 @@
 ******************************************************************************/
 
 #pragma once
+#include <cmath>
+#include <cstring>
 #include <inttypes.h>
 #include <list>
 #include <memory>
+#include <string>
 #include <vector>
 
+// A property set travels as a single arena: a uint32 record count followed by
+//  the records, each a uint32 size and one serialized property. A property is
+//  its uint8 type, string name, description, long description, uint8 enabled,
+//  uint8 visible and then the fields of its type, in declaration order.
+//  Values are fixed-size, strings are a uint32 length and the characters.
 namespace obs
 {
+	// A string inside an arena, only valid as long as the arena is.
+	struct string_ref
+	{
+		const char* data = nullptr;
+		size_t      size = 0;
+
+		bool operator==(const std::string& other) const
+		{
+			return (other.size() == size) && (std::memcmp(other.data(), data, size) == 0);
+		}
+		void assign_to(std::string& out) const
+		{
+			out.assign(data, size);
+		}
+	};
+
+	// Appends records to an arena started at the current end of 'buf'.
+	class PropertyWriter
+	{
+		std::vector<char>& buf;
+		size_t             start;
+		size_t             record;
+
+		void count_record()
+		{
+			uint32_t count = 0;
+			std::memcpy(&count, &buf[start], sizeof(uint32_t));
+			count++;
+			std::memcpy(&buf[start], &count, sizeof(uint32_t));
+		}
+
+		public:
+		PropertyWriter(std::vector<char>& buf) : buf(buf), start(buf.size()), record(0)
+		{
+			write(uint32_t(0));
+		}
+
+		// Opens a record, everything written until end() belongs to it.
+		void begin()
+		{
+			record = buf.size();
+			write(uint32_t(0));
+		}
+		void end()
+		{
+			uint32_t size = uint32_t(buf.size() - record - sizeof(uint32_t));
+			std::memcpy(&buf[record], &size, sizeof(uint32_t));
+			count_record();
+		}
+
+		// Copies a whole record, size included, out of another arena.
+		void append(const char* data, size_t size)
+		{
+			buf.insert(buf.end(), data, data + size);
+			count_record();
+		}
+
+		template<typename T>
+		void write(const T& value)
+		{
+			size_t offset = buf.size();
+			buf.resize(offset + sizeof(T));
+			std::memcpy(&buf[offset], &value, sizeof(T));
+		}
+		void write(const std::string& value)
+		{
+			write(uint32_t(value.size()));
+			buf.insert(buf.end(), value.begin(), value.end());
+		}
+	};
+
+	// Reads an arena or a single record in place. Every read fails once the
+	//  data is exhausted, so callers only need to check the last one.
+	class PropertyReader
+	{
+		const char* data;
+		size_t      size;
+		size_t      offset;
+
+		public:
+		PropertyReader() : data(nullptr), size(0), offset(0) {}
+		PropertyReader(const char* data, size_t size) : data(data), size(size), offset(0) {}
+		PropertyReader(std::vector<char> const& buf) : data(buf.data()), size(buf.size()), offset(0) {}
+
+		template<typename T>
+		bool read(T& value)
+		{
+			if (size - offset < sizeof(T)) {
+				offset = size;
+				return false;
+			}
+			std::memcpy(&value, data + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+		bool read(string_ref& value)
+		{
+			uint32_t length = 0;
+			if (!read(length) || (size - offset < length)) {
+				offset = size;
+				return false;
+			}
+			value.data = data + offset;
+			value.size = length;
+			offset += length;
+			return true;
+		}
+		// Reads the next record of an arena.
+		bool read(PropertyReader& record)
+		{
+			uint32_t length = 0;
+			if (!read(length) || (size - offset < length)) {
+				offset = size;
+				return false;
+			}
+			record = PropertyReader(data + offset, length);
+			offset += length;
+			return true;
+		}
+	};
+
 	struct Property
 	{
 		enum class Type : uint8_t
@@ -50,14 +179,13 @@ namespace obs
 
 		virtual ~Property(){};
 
-		static std::shared_ptr<Property> deserialize(std::vector<char> const& buf);
-
 		virtual obs::Property::Type type();
-		virtual size_t              size();
-		virtual bool                serialize(std::vector<char>& buf);
+
+		// Appends this property as the next record of the arena.
+		void serialize(PropertyWriter& w);
 
 		protected:
-		virtual bool read(std::vector<char> const& buf);
+		virtual void write(PropertyWriter& w);
 	};
 
 	struct BooleanProperty : Property
@@ -66,11 +194,9 @@ namespace obs
 		virtual ~BooleanProperty(){};
 
 		virtual obs::Property::Type type() override;
-		virtual size_t              size() override;
-		virtual bool                serialize(std::vector<char>& buf) override;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
 	};
 
 	struct NumberProperty : Property
@@ -83,11 +209,9 @@ namespace obs
 		NumberType field_type;
 		virtual ~NumberProperty(){};
 
-		virtual size_t size() override;
-		virtual bool   serialize(std::vector<char>& buf) override;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
 	};
 
 	struct IntegerProperty : NumberProperty
@@ -100,11 +224,9 @@ namespace obs
 		virtual ~IntegerProperty(){};
 
 		virtual obs::Property::Type type() override;
-		virtual size_t              size() override;
-		virtual bool                serialize(std::vector<char>& buf) override;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
 	};
 
 	struct FloatProperty : NumberProperty
@@ -117,11 +239,9 @@ namespace obs
 		virtual ~FloatProperty(){};
 
 		virtual obs::Property::Type type() override;
-		virtual size_t              size() override;
-		virtual bool                serialize(std::vector<char>& buf) override;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
 	};
 
 	struct TextProperty : Property
@@ -138,11 +258,9 @@ namespace obs
 		virtual ~TextProperty(){};
 
 		virtual obs::Property::Type type() override;
-		virtual size_t              size() override;
-		virtual bool                serialize(std::vector<char>& buf) override;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
 	};
 
 	struct PathProperty : Property
@@ -161,11 +279,9 @@ namespace obs
 		virtual ~PathProperty(){};
 
 		virtual obs::Property::Type type() override;
-		virtual size_t              size() override;
-		virtual bool                serialize(std::vector<char>& buf) override;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
 	};
 
 	struct ListProperty : Property
@@ -204,11 +320,9 @@ namespace obs
 		virtual ~ListProperty(){};
 
 		virtual obs::Property::Type type() override;
-		virtual size_t              size() override;
-		virtual bool                serialize(std::vector<char>& buf) override;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
 	};
 
 	struct ColorProperty : NumberProperty
@@ -216,12 +330,10 @@ namespace obs
 		virtual ~ColorProperty(){};
 
 		virtual obs::Property::Type type() override;
-		virtual size_t              size() override;
-		virtual bool                serialize(std::vector<char>& buf) override;
 		int64_t                     value;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
 	};
 
 	struct ButtonProperty : Property
@@ -229,11 +341,9 @@ namespace obs
 		virtual ~ButtonProperty(){};
 
 		virtual obs::Property::Type type() override;
-		virtual size_t              size() override;
-		virtual bool                serialize(std::vector<char>& buf) override;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
 	};
 
 	struct FontProperty : Property
@@ -247,11 +357,9 @@ namespace obs
 		virtual ~FontProperty(){};
 
 		virtual obs::Property::Type type() override;
-		virtual size_t              size() override;
-		virtual bool                serialize(std::vector<char>& buf) override;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
 	};
 
 	struct EditableListProperty : Property
@@ -270,11 +378,9 @@ namespace obs
 		virtual ~EditableListProperty(){};
 
 		virtual obs::Property::Type type() override;
-		virtual size_t              size() override;
-		virtual bool                serialize(std::vector<char>& buf) override;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
 	};
 
 	struct FrameRateProperty : Property
@@ -296,11 +402,21 @@ namespace obs
 		virtual ~FrameRateProperty(){};
 
 		virtual obs::Property::Type type() override;
-		virtual size_t              size() override;
-		virtual bool                serialize(std::vector<char>& buf) override;
 
 		protected:
-		virtual bool read(std::vector<char> const& buf) override;
+		virtual void write(PropertyWriter& w) override;
+	};
+
+	// Reply kinds of Source.GetPropertiesDiff.
+	enum class PropertiesDiff : uint32_t
+	{
+		// The version the client holds is current, nothing follows.
+		Unchanged,
+		// uint32 removed count and removed names, then a binary of uint32
+		//  indices and an arena holding the changed or added property for each.
+		Delta,
+		// An arena of every property, in order.
+		Full,
 	};
 
 } // namespace obs
@@ -0,0 +1,86 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <cstring>
+#include <inttypes.h>
+#include <string>
+#include <vector>
+
+// Packed scene items returned by Scene.GetSnapshot.
+//
+// The reply carries 'count' item_record structs in one buffer and the item
+//  names and source type ids in a second one, as u32 length-prefixed strings
+//  in record order. Every record field is 4 bytes wide so the client can hand
+//  the record buffer to JavaScript as is and read it through typed arrays.
+namespace scene_snapshot
+{
+	enum flags : uint32_t
+	{
+		visible  = 1 << 0,
+		selected = 1 << 1,
+		locked   = 1 << 2,
+	};
+
+	struct item_record
+	{
+		uint32_t item_uid[2];   // osn::SceneItem handle, low word first
+		uint32_t source_uid[2]; // osn::Source handle, low word first
+		uint32_t item_id[2];    // obs_sceneitem_get_id, low word first
+		uint32_t source_type;   // obs_source_type
+		uint32_t flags;
+		float    pos[2];
+		float    scale[2];
+		float    rot;
+		uint32_t alignment;
+		float    bounds[2];
+		uint32_t bounds_type;
+		uint32_t bounds_alignment;
+		int32_t  crop[4]; // left, top, right, bottom
+		uint32_t scale_filter;
+	};
+
+	static const uint32_t record_words = sizeof(item_record) / sizeof(uint32_t);
+	static_assert(sizeof(item_record) % sizeof(uint32_t) == 0, "item_record must be made of 32-bit words");
+
+	inline void write_string(std::vector<char>& buf, const char* value)
+	{
+		uint32_t length = value ? uint32_t(std::strlen(value)) : 0;
+		size_t   offset = buf.size();
+		buf.resize(offset + sizeof(uint32_t) + length);
+		std::memcpy(&buf[offset], &length, sizeof(uint32_t));
+		if (length)
+			std::memcpy(&buf[offset + sizeof(uint32_t)], value, length);
+	}
+
+	// Reads the string at 'offset' and advances it. Returns false once the
+	//  buffer is exhausted or the remaining data is truncated.
+	inline bool read_string(std::vector<char> const& buf, size_t& offset, std::string& value)
+	{
+		uint32_t length;
+		if (buf.size() < offset + sizeof(uint32_t)) {
+			return false;
+		}
+		std::memcpy(&length, &buf[offset], sizeof(uint32_t));
+		if (buf.size() - offset - sizeof(uint32_t) < length) {
+			return false;
+		}
+		value.assign(&buf[offset + sizeof(uint32_t)], length);
+		offset += sizeof(uint32_t) + length;
+		return true;
+	}
+} // namespace scene_snapshot
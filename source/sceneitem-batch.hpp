@@ -0,0 +1,58 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <inttypes.h>
+
+// Packed scene item changes applied by SceneItem.UpdateBatch.
+//
+// The batch is a plain array of fixed-size commands. Only the fields named by
+//  a command's mask are applied, the others are ignored.
+namespace sceneitem_batch
+{
+	enum field : uint32_t
+	{
+		position         = 1 << 0,
+		scale            = 1 << 1,
+		rotation         = 1 << 2,
+		alignment        = 1 << 3,
+		bounds           = 1 << 4,
+		bounds_type      = 1 << 5,
+		bounds_alignment = 1 << 6,
+		crop             = 1 << 7,
+		scale_filter     = 1 << 8,
+		visible          = 1 << 9,
+		selected         = 1 << 10,
+	};
+
+	struct command
+	{
+		uint64_t item_uid;
+		uint32_t mask;
+		float    pos[2];
+		float    scale[2];
+		float    rot;
+		uint32_t alignment;
+		float    bounds[2];
+		uint32_t bounds_type;
+		uint32_t bounds_alignment;
+		int32_t  crop[4]; // left, top, right, bottom
+		uint32_t scale_filter;
+		uint32_t visible;
+		uint32_t selected;
+	};
+} // namespace sceneitem_batch
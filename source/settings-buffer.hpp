@@ -0,0 +1,123 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Layout of the settings categories sent by OBS_settings_getSettings and
+//  OBS_settings_saveSettings. Every sub category is its string name and a
+//  size_t parameter count followed by the parameters:
+//  - name, description, type, subType: string
+//  - enabled, masked, visible:         bool
+//  - minVal, maxVal, stepVal:          double
+//  - currentValue:                     string
+//  - sizeOfValues, countValues:        size_t
+//  - values:                           sizeOfValues bytes
+// Strings are a size_t length followed by the characters, not terminated.
+namespace settings_buffer
+{
+	inline size_t string_size(size_t length)
+	{
+		return sizeof(size_t) + length;
+	}
+
+	// Appends to 'buf'. Callers reserve the full size up front, so a whole
+	//  category is written without reallocating.
+	class writer
+	{
+		std::vector<char>& buf;
+
+		public:
+		writer(std::vector<char>& buf) : buf(buf) {}
+
+		template<typename T>
+		void write(const T& value)
+		{
+			append(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+		void write(const char* value, size_t length)
+		{
+			write(length);
+			append(value, length);
+		}
+		void write(const std::string& value)
+		{
+			write(value.data(), value.length());
+		}
+		void append(const char* value, size_t length)
+		{
+			size_t offset = buf.size();
+			buf.resize(offset + length);
+			if (length)
+				std::memcpy(&buf[offset], value, length);
+		}
+	};
+
+	// Every read fails once the buffer is exhausted, so callers only need to
+	//  check the last one.
+	class reader
+	{
+		const char* data;
+		size_t      size;
+		size_t      offset;
+
+		public:
+		reader(const char* data, size_t size) : data(data), size(size), offset(0) {}
+
+		template<typename T>
+		bool read(T& value)
+		{
+			if (size - offset < sizeof(T)) {
+				offset = size;
+				return false;
+			}
+			std::memcpy(&value, data + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+		// Points 'value' at the next 'length' bytes, nothing is copied.
+		bool read(const char*& value, size_t length)
+		{
+			if (size - offset < length) {
+				offset = size;
+				return false;
+			}
+			value = data + offset;
+			offset += length;
+			return true;
+		}
+		bool read(std::string& value)
+		{
+			size_t      length = 0;
+			const char* chars  = nullptr;
+			if (!read(length) || !read(chars, length))
+				return false;
+			value.assign(chars, length);
+			return true;
+		}
+		bool read(std::vector<char>& value, size_t length)
+		{
+			const char* chars = nullptr;
+			if (!read(chars, length))
+				return false;
+			value.assign(chars, chars + length);
+			return true;
+		}
+	};
+} // namespace settings_buffer
@@ -0,0 +1,105 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstring>
+#include <inttypes.h>
+#include <vector>
+
+// Packed volmeter frames exchanged by Events.Poll and VolMeter.QueryMany.
+//
+// A buffer is a plain sequence of frames, each frame being a frame_header
+//  followed by 'channels' magnitude, 'channels' peak and 'channels'
+//  input_peak floats. This avoids boxing every float into an ipc::value.
+namespace volmeter
+{
+	struct frame_header
+	{
+		uint64_t uid;
+		uint32_t channels;
+		uint32_t reserved;
+	};
+
+	inline size_t frame_size(uint32_t channels)
+	{
+		return sizeof(frame_header) + sizeof(float) * channels * 3;
+	}
+
+	inline void write_frame(
+	    std::vector<char>& buf,
+	    uint64_t           uid,
+	    uint32_t           channels,
+	    const float*       magnitude,
+	    const float*       peak,
+	    const float*       input_peak)
+	{
+		size_t offset = buf.size();
+		buf.resize(offset + frame_size(channels));
+
+		frame_header hdr = {uid, channels, 0};
+		std::memcpy(&buf[offset], &hdr, sizeof(frame_header));
+		offset += sizeof(frame_header);
+		if (channels == 0) {
+			return;
+		}
+
+		std::memcpy(&buf[offset], magnitude, sizeof(float) * channels);
+		offset += sizeof(float) * channels;
+		std::memcpy(&buf[offset], peak, sizeof(float) * channels);
+		offset += sizeof(float) * channels;
+		std::memcpy(&buf[offset], input_peak, sizeof(float) * channels);
+	}
+
+	// Reads the frame at 'offset' and advances it. Returns false once the
+	//  buffer is exhausted or the remaining data is truncated.
+	inline bool read_frame(
+	    std::vector<char> const& buf,
+	    size_t&                  offset,
+	    uint64_t&                uid,
+	    std::vector<float>&      magnitude,
+	    std::vector<float>&      peak,
+	    std::vector<float>&      input_peak)
+	{
+		if (buf.size() < offset + sizeof(frame_header)) {
+			return false;
+		}
+
+		frame_header hdr;
+		std::memcpy(&hdr, &buf[offset], sizeof(frame_header));
+		if (buf.size() < offset + frame_size(hdr.channels)) {
+			return false;
+		}
+		offset += sizeof(frame_header);
+
+		uid = hdr.uid;
+		magnitude.resize(hdr.channels);
+		peak.resize(hdr.channels);
+		input_peak.resize(hdr.channels);
+		if (hdr.channels == 0) {
+			return true;
+		}
+
+		std::memcpy(magnitude.data(), &buf[offset], sizeof(float) * hdr.channels);
+		offset += sizeof(float) * hdr.channels;
+		std::memcpy(peak.data(), &buf[offset], sizeof(float) * hdr.channels);
+		offset += sizeof(float) * hdr.channels;
+		std::memcpy(input_peak.data(), &buf[offset], sizeof(float) * hdr.channels);
+		offset += sizeof(float) * hdr.channels;
+		return true;
+	}
+} // namespace volmeter
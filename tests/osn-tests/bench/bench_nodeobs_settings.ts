@@ -0,0 +1,64 @@
+import 'mocha';
+import * as osn from 'obs-studio-node';
+import { OBSProcessHandler } from '../util/obs_process_handler';
+import { deleteConfigFiles } from '../util/general';
+
+describe('nodeobs_settings', () => {
+    let obs: OBSProcessHandler;
+
+    // Initialize OBS process
+    before(function() {
+        obs = new OBSProcessHandler();
+
+        if (obs.startup() !== osn.EVideoCodes.Success)
+        {
+            throw new Error("Could not start OBS process. Aborting!")
+        }
+    });
+
+    // Shutdown OBS process
+    after(function() {
+        obs.shutdown();
+        obs = null;
+        deleteConfigFiles();
+    });
+
+    context('# Settings serialization', () => {
+        it('Get and save round trip of every category', () => {
+            const roundTrips = 20;
+            const categories = osn.NodeObs.OBS_settings_getListCategories();
+
+            categories.forEach(category => {
+                const start = process.hrtime();
+                for (let i = 0; i < roundTrips; i++) {
+                    osn.NodeObs.OBS_settings_saveSettings(category, osn.NodeObs.OBS_settings_getSettings(category));
+                }
+                const elapsed = process.hrtime(start);
+
+                const perRoundTripMs = (elapsed[0] * 1e3 + elapsed[1] / 1e6) / roundTrips;
+                console.log('      * ' + category + ': ' + perRoundTripMs.toFixed(3) + ' ms/round trip');
+            });
+        });
+
+        it('Built against cached category results', () => {
+            const categories = osn.NodeObs.OBS_settings_getListCategories();
+
+            categories.forEach(category => {
+                // Saving drops every cached category
+                osn.NodeObs.OBS_settings_saveSettings(category, osn.NodeObs.OBS_settings_getSettings(category));
+
+                let start = process.hrtime();
+                osn.NodeObs.OBS_settings_getSettings(category);
+                const buildElapsed = process.hrtime(start);
+
+                start = process.hrtime();
+                osn.NodeObs.OBS_settings_getSettings(category);
+                const cachedElapsed = process.hrtime(start);
+
+                console.log('      * ' + category + ': ' +
+                    (buildElapsed[0] * 1e3 + buildElapsed[1] / 1e6).toFixed(3) + ' ms built, ' +
+                    (cachedElapsed[0] * 1e3 + cachedElapsed[1] / 1e6).toFixed(3) + ' ms cached');
+            });
+        });
+    });
+});
@@ -0,0 +1,46 @@
+import 'mocha';
+import * as osn from 'obs-studio-node';
+import { OBSProcessHandler } from '../util/obs_process_handler';
+
+describe('osn-input', () => {
+    let obs: OBSProcessHandler;
+
+    // Initialize OBS process
+    before(function() {
+        obs = new OBSProcessHandler();
+
+        if (obs.startup() !== osn.EVideoCodes.Success)
+        {
+            throw new Error("Could not start OBS process. Aborting!")
+        }
+    });
+
+    // Shutdown OBS process
+    after(function() {
+        obs.shutdown();
+        obs = null;
+    });
+
+    context('# GetTypeProperties', () => {
+        // color_source is cached, dshow_input lists devices and is rebuilt every time
+        ['color_source', 'dshow_input'].forEach(function(inputType) {
+            it('Repeated type property fetches of ' + inputType, () => {
+                const fetchCount = 200;
+
+                const first = process.hrtime();
+                osn.InputFactory.getTypeProperties(inputType);
+                const firstElapsed = process.hrtime(first);
+
+                const start = process.hrtime();
+                for (let i = 0; i < fetchCount; i++) {
+                    osn.InputFactory.getTypeProperties(inputType);
+                }
+                const elapsed = process.hrtime(start);
+
+                console.log('      * first fetch: ' + (firstElapsed[0] * 1e3 + firstElapsed[1] / 1e6).toFixed(3) + ' ms');
+                console.log('      * next fetches: ' +
+                    ((elapsed[0] * 1e3 + elapsed[1] / 1e6) / fetchCount).toFixed(3) + ' ms');
+            });
+        });
+    });
+});
@@ -0,0 +1,60 @@
+import 'mocha';
+import * as osn from 'obs-studio-node';
+import { IInput } from 'obs-studio-node';
+import { OBSProcessHandler } from '../util/obs_process_handler';
+
+// Number of calls issued per measurement
+const callCount = 2000;
+
+// Issues callCount calls while keeping at most `depth` of them in flight
+async function measureCallsPerSecond(input: IInput, depth: number): Promise<number> {
+    let issued = 0;
+
+    async function lane(): Promise<void> {
+        while (issued < callCount) {
+            issued++;
+            await input.getSettingsAsync();
+        }
+    }
+
+    const start = process.hrtime();
+    const lanes: Promise<void>[] = [];
+    for (let i = 0; i < depth; i++) {
+        lanes.push(lane());
+    }
+    await Promise.all(lanes);
+    const elapsed = process.hrtime(start);
+
+    return callCount / (elapsed[0] + elapsed[1] / 1e9);
+}
+
+describe('osn-pipeline', () => {
+    let obs: OBSProcessHandler;
+    let input: IInput;
+
+    // Initialize OBS process
+    before(function() {
+        obs = new OBSProcessHandler();
+
+        if (obs.startup() !== osn.EVideoCodes.Success)
+        {
+            throw new Error("Could not start OBS process. Aborting!")
+        }
+
+        input = osn.InputFactory.create('color_source', 'pipeline_input');
+    });
+
+    // Shutdown OBS process
+    after(function() {
+        input.release();
+        obs.shutdown();
+        obs = null;
+    });
+
+    [1, 8, 64].forEach(function(depth) {
+        it('Calls per second at pipeline depth ' + depth, async () => {
+            const rate = await measureCallsPerSecond(input, depth);
+            console.log('      * ' + Math.round(rate) + ' calls/s');
+        });
+    });
+});
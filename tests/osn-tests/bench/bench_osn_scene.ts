@@ -0,0 +1,94 @@
+import 'mocha';
+import * as osn from 'obs-studio-node';
+import { ISceneItem } from 'obs-studio-node';
+import { OBSProcessHandler } from '../util/obs_process_handler';
+
+describe('osn-scene', () => {
+    let obs: OBSProcessHandler;
+
+    // Initialize OBS process
+    before(function() {
+        obs = new OBSProcessHandler();
+
+        if (obs.startup() !== osn.EVideoCodes.Success)
+        {
+            throw new Error("Could not start OBS process. Aborting!")
+        }
+    });
+
+    // Shutdown OBS process
+    after(function() {
+        obs.shutdown();
+        obs = null;
+    });
+
+    context('# GetSnapshot', () => {
+        it('Snapshot against per item getters', () => {
+            const itemCount = 200;
+            const scene = osn.SceneFactory.create('snapshot_bench');
+            const input = osn.InputFactory.create('color_source', 'snapshot_bench_input');
+            for (let i = 0; i < itemCount; i++) {
+                scene.add(input).position = {x: i, y: i};
+            }
+
+            const rows: any[] = [];
+            let start = process.hrtime();
+            scene.getItems().forEach(function(sceneItem) {
+                rows.push([sceneItem.source.name, sceneItem.position, sceneItem.scale, sceneItem.rotation,
+                    sceneItem.crop, sceneItem.bounds, sceneItem.visible, sceneItem.selected]);
+            });
+            let elapsed = process.hrtime(start);
+            const gettersMs = elapsed[0] * 1e3 + elapsed[1] / 1e6;
+
+            start = process.hrtime();
+            scene.getSnapshot();
+            elapsed = process.hrtime(start);
+            const snapshotMs = elapsed[0] * 1e3 + elapsed[1] / 1e6;
+
+            console.log('      * ' + itemCount + ' items, getters: ' + gettersMs.toFixed(2) + ' ms');
+            console.log('      * ' + itemCount + ' items, snapshot: ' + snapshotMs.toFixed(2) + ' ms');
+
+            scene.getItems().forEach(function(sceneItem) {
+                sceneItem.remove();
+            });
+            input.release();
+            scene.release();
+        });
+    });
+
+    context('# UpdateItems', () => {
+        it('Moving a 50 item selection', () => {
+            const itemCount = 50;
+            const scene = osn.SceneFactory.create('update_items_bench');
+            const input = osn.InputFactory.create('color_source', 'update_items_bench_input');
+            const sceneItems: ISceneItem[] = [];
+            for (let i = 0; i < itemCount; i++) {
+                sceneItems.push(scene.add(input));
+            }
+
+            let start = process.hrtime();
+            sceneItems.forEach(function(sceneItem, i) {
+                sceneItem.position = {x: i, y: i};
+                sceneItem.scale = {x: 2, y: 2};
+            });
+            let elapsed = process.hrtime(start);
+            const settersMs = elapsed[0] * 1e3 + elapsed[1] / 1e6;
+
+            start = process.hrtime();
+            scene.updateItems(sceneItems.map(function(sceneItem, i) {
+                return {item: sceneItem, position: {x: i + 1, y: i + 1}, scale: {x: 1, y: 1}};
+            }));
+            elapsed = process.hrtime(start);
+            const batchMs = elapsed[0] * 1e3 + elapsed[1] / 1e6;
+
+            console.log('      * ' + itemCount + ' items, setters: ' + settersMs.toFixed(2) + ' ms');
+            console.log('      * ' + itemCount + ' items, batch: ' + batchMs.toFixed(2) + ' ms');
+
+            sceneItems.forEach(function(sceneItem) {
+                sceneItem.remove();
+            });
+            input.release();
+            scene.release();
+        });
+    });
+});
@@ -0,0 +1,53 @@
+import 'mocha';
+import * as osn from 'obs-studio-node';
+import { OBSProcessHandler } from '../util/obs_process_handler';
+
+describe('osn-sceneitem', () => {
+    let obs: OBSProcessHandler;
+    let sceneName: string = 'bench_scene';
+
+    // Initialize OBS process
+    before(function() {
+        obs = new OBSProcessHandler();
+
+        if (obs.startup() !== osn.EVideoCodes.Success)
+        {
+            throw new Error("Could not start OBS process. Aborting!")
+        }
+
+        osn.SceneFactory.create(sceneName);
+    });
+
+    // Shutdown OBS process
+    after(function() {
+        obs.shutdown();
+        obs = null;
+    });
+
+    context('# Transform cache', () => {
+        it('Cached position reads', () => {
+            const readCount = 10000;
+            const scene = osn.SceneFactory.fromName(sceneName);
+            const source = osn.InputFactory.create('image_source', 'cache_bench_source');
+            const sceneItem = scene.add(source);
+            sceneItem.position = {x: 10, y: 20};
+
+            // Nothing was read from this item yet, the first read goes to the server
+            let start = process.hrtime();
+            let position = sceneItem.position;
+            let elapsed = process.hrtime(start);
+            const firstNs = elapsed[0] * 1e9 + elapsed[1];
+
+            start = process.hrtime();
+            for (let i = 0; i < readCount; i++) {
+                position = sceneItem.position;
+            }
+            elapsed = process.hrtime(start);
+            const cachedNs = (elapsed[0] * 1e9 + elapsed[1]) / readCount;
+
+            console.log('      * first read: ' + Math.round(firstNs) + ' ns/op');
+            console.log('      * cached read: ' + Math.round(cachedNs) + ' ns/op');
+            sceneItem.remove();
+        });
+    });
+});
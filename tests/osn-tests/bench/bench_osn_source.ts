@@ -0,0 +1,78 @@
+import 'mocha';
+import * as osn from 'obs-studio-node';
+import { OBSProcessHandler } from '../util/obs_process_handler';
+
+describe('osn-source', () => {
+    let obs: OBSProcessHandler;
+
+    // Initialize OBS process
+    before(function() {
+        obs = new OBSProcessHandler();
+
+        if (obs.startup() !== osn.EVideoCodes.Success)
+        {
+            throw new Error("Could not start OBS process. Aborting!")
+        }
+    });
+
+    // Shutdown OBS process
+    after(function() {
+        obs.shutdown();
+        obs = null;
+    });
+
+    context('# Incremental GetProperties', () => {
+        it('Fetching unchanged properties', () => {
+            const fetchCount = 200;
+            const input = osn.InputFactory.create('dshow_input', 'properties_diff_bench');
+
+            const start = process.hrtime();
+            for (let i = 0; i < fetchCount; i++) {
+                const properties = input.properties;
+            }
+            const elapsed = process.hrtime(start);
+
+            const perFetchMs = (elapsed[0] * 1e3 + elapsed[1] / 1e6) / fetchCount;
+            console.log('      * unchanged properties: ' + perFetchMs.toFixed(3) + ' ms/fetch');
+            input.release();
+        });
+    });
+
+    context('# Binary settings', () => {
+        [1024, 100 * 1024].forEach(function(size) {
+            it('Update and get of ' + size / 1024 + ' KB settings', () => {
+                const updateCount = 100;
+                const input = osn.InputFactory.create('color_source', 'binary_settings_bench');
+                const css = 'a'.repeat(size);
+
+                const start = process.hrtime();
+                for (let i = 0; i < updateCount; i++) {
+                    input.update({ css: css, color: i });
+                    const settings = input.settings;
+                }
+                const elapsed = process.hrtime(start);
+
+                const perUpdateMs = (elapsed[0] * 1e3 + elapsed[1] / 1e6) / updateCount;
+                console.log('      * ' + size / 1024 + ' KB: ' + perUpdateMs.toFixed(3) + ' ms/update+get');
+                input.release();
+            });
+        });
+    });
+
+    context('# Settings patch', () => {
+        it('Patches of a dragged slider', () => {
+            const patchCount = 1000;
+            const input = osn.InputFactory.create('color_source', 'settings_patch_bench');
+
+            const start = process.hrtime();
+            for (let i = 0; i < patchCount; i++) {
+                input.patchSettings([{ path: 'color', value: i }]);
+            }
+            const elapsed = process.hrtime(start);
+
+            const perPatchMs = (elapsed[0] * 1e3 + elapsed[1] / 1e6) / patchCount;
+            console.log('      * ' + perPatchMs.toFixed(3) + ' ms/patch');
+            input.release();
+        });
+    });
+});
@@ -155,6 +155,63 @@ describe('nodeobs_api', function() {
         });
     });
 
+    context('# OBS_API_getLogMessages', function() {
+        it('Fetch log messages incrementally', function() {
+            // 0 selects the general log
+            const first = osn.NodeObs.OBS_API_getLogMessages(0, 0, 10);
+
+            // Startup already logged more than ten lines
+            expect(first.messages.length).to.equal(10);
+            expect(first.last).to.equal(first.messages[9].sequence);
+            first.messages.forEach(function(message: any, index: number) {
+                expect(message.message).to.be.a('string');
+                if (index > 0) {
+                    expect(message.sequence).to.be.above(first.messages[index - 1].sequence);
+                }
+            });
+
+            // Continuing after the last entry only returns newer ones
+            const next = osn.NodeObs.OBS_API_getLogMessages(0, first.last, 1000);
+            next.messages.forEach(function(message: any) {
+                expect(message.sequence).to.be.above(first.last);
+            });
+
+            // Nothing is returned past the newest entry
+            const last = osn.NodeObs.OBS_API_getLogMessages(0, next.last, 1000);
+            expect(last.last).to.be.at.least(next.last);
+        });
+
+        it('Fail to fetch an unknown log', function() {
+            expect(function() {
+                osn.NodeObs.OBS_API_getLogMessages(3, 0, 10);
+            }).to.throw();
+        });
+    });
+
+    context('# GetCallStats', function() {
+        it('Get timing statistics of called functions', function() {
+            osn.NodeObs.OBS_API_getPerformanceStatistics();
+            const stats = osn.NodeObs.GetCallStats();
+
+            const entry = stats.find(function(stat: any) {
+                return stat.collection === 'API' && stat.name === 'OBS_API_getPerformanceStatistics';
+            });
+            expect(entry).to.not.equal(undefined);
+            expect(entry.count).to.be.at.least(1);
+            expect(entry.maxNs).to.be.at.most(entry.totalNs);
+
+            // Buckets are sorted by duration and account for every call
+            let calls = 0;
+            entry.buckets.forEach(function(bucket: number[], index: number) {
+                if (index > 0) {
+                    expect(bucket[0]).to.be.above(entry.buckets[index - 1][0]);
+                }
+                calls += bucket[1];
+            });
+            expect(calls).to.equal(entry.count);
+        });
+    });
+
     context('# StopCrashHandler', function() {
         it('Stop crash handler', function() {
             // Stopping crash handler as a last test case
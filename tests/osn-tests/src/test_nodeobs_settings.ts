@@ -2605,4 +2605,47 @@ describe('nodeobs_settings', function() {
             expect(categories).to.include.members(basicOBSSettingsCategories);
         });
     });
+
+    context('# Settings serialization', function() {
+        it('Keep every category unchanged through a get and save round trip', function() {
+            const categories = osn.NodeObs.OBS_settings_getListCategories();
+
+            categories.forEach(category => {
+                const settings = osn.NodeObs.OBS_settings_getSettings(category);
+
+                // Saving unchanged settings must not change them
+                osn.NodeObs.OBS_settings_saveSettings(category, osn.NodeObs.OBS_settings_getSettings(category));
+                expect(osn.NodeObs.OBS_settings_getSettings(category)).to.eql(settings);
+            });
+        });
+
+        it('Rebuild cached category results after settings are saved', function() {
+            // Getting twice keeps the second result from the cache
+            osn.NodeObs.OBS_settings_getSettings('General');
+            const generalSettings = osn.NodeObs.OBS_settings_getSettings('General');
+
+            const findBool = (settings: any[]) => {
+                for (const subCategory of settings) {
+                    for (const parameter of subCategory.parameters) {
+                        if (parameter.type === 'OBS_PROPERTY_BOOL') {
+                            return parameter;
+                        }
+                    }
+                }
+            };
+
+            const parameter = findBool(generalSettings);
+            expect(parameter, 'General has no bool parameter').to.not.be.undefined;
+            const previousValue = parameter.currentValue;
+
+            // A stale cache would still return the previous value
+            parameter.currentValue = !previousValue;
+            osn.NodeObs.OBS_settings_saveSettings('General', generalSettings);
+            expect(findBool(osn.NodeObs.OBS_settings_getSettings('General')).currentValue).to.equal(!previousValue);
+
+            parameter.currentValue = previousValue;
+            osn.NodeObs.OBS_settings_saveSettings('General', generalSettings);
+            expect(findBool(osn.NodeObs.OBS_settings_getSettings('General')).currentValue).to.equal(previousValue);
+        });
+    });
 });
\ No newline at end of file
@@ -69,6 +69,24 @@ describe('osn-input', () => {
                 input.release();
             });
         });
+
+        it('Create an input without blocking the event loop', async () => {
+            let settings: ISettings = {};
+            settings['test'] = 1;
+
+            const input = await osn.InputFactory.createAsync('color_source', 'async_input', settings);
+
+            // Checking if input source was created correctly
+            expect(input).to.not.equal(undefined);
+            expect(input.id).to.equal('color_source');
+            expect(input.name).to.equal('async_input');
+
+            // Updating and reading back settings asynchronously
+            settings['test'] = 2;
+            expect(await input.updateAsync(settings)).to.equal(true);
+            expect(await input.getSettingsAsync()).to.include(settings);
+            input.release();
+        });
     });
 
     context('# FromName', () => {
@@ -427,4 +445,33 @@ describe('osn-input', () => {
             expect(input.filters[0].name).to.equal('filter2');
         });
     });
+
+    context('# GetTypeProperties and GetTypeDefaults', () => {
+        it('Get properties and defaults of an input type', () => {
+            const defaults = osn.InputFactory.getTypeDefaults('color_source');
+            const properties = osn.InputFactory.getTypeProperties('color_source');
+
+            // Type properties carry the default values
+            expect(properties.get('width').value).to.equal(defaults.width);
+
+            // Changing the locale rebuilds them with the translated names
+            const locale = osn.Global.locale;
+            const description = properties.get('width').description;
+            osn.Global.locale = 'pt-BR';
+            const localized = osn.InputFactory.getTypeProperties('color_source');
+            expect(localized.count()).to.equal(properties.count());
+            expect(localized.get('width').description).to.not.equal(description);
+
+            osn.Global.locale = locale;
+            expect(osn.InputFactory.getTypeProperties('color_source').get('width').description).to.equal(description);
+        });
+
+        it('Get properties of an input type listing devices', () => {
+            // Device lists are never cached, every fetch enumerates them again
+            const first = osn.InputFactory.getTypeProperties('wasapi_input_capture');
+            const second = osn.InputFactory.getTypeProperties('wasapi_input_capture');
+            expect(second.count()).to.equal(first.count());
+            expect(second.get('device_id').value).to.equal(first.get('device_id').value);
+        });
+    });
 });
\ No newline at end of file
@@ -0,0 +1,61 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from 'obs-studio-node';
+import { ISettings } from 'obs-studio-node';
+import { OBSProcessHandler } from '../util/obs_process_handler';
+
+describe('osn-pipeline', () => {
+    let obs: OBSProcessHandler;
+
+    // Initialize OBS process
+    before(function() {
+        obs = new OBSProcessHandler();
+
+        if (obs.startup() !== osn.EVideoCodes.Success)
+        {
+            throw new Error("Could not start OBS process. Aborting!")
+        }
+    });
+
+    // Shutdown OBS process
+    after(function() {
+        obs.shutdown();
+        obs = null;
+    });
+
+    context('# Pipelined calls', () => {
+        it('Apply an async update before a later synchronous call', async () => {
+            const input = osn.InputFactory.create('color_source', 'pipeline_sync', { color: 1 });
+
+            // The update is still in flight when the synchronous getter is made
+            const updated = input.updateAsync({ color: 2 });
+            expect(input.settings.color).to.equal(2);
+
+            await updated;
+            input.release();
+        });
+
+        it('Complete pipelined calls in the order they were made', async () => {
+            const input = osn.InputFactory.create('color_source', 'pipeline_order', { color: 0 });
+            const order: number[] = [];
+            const calls: Promise<void>[] = [];
+
+            // Every read is issued right after an update, without waiting for either
+            for (let i = 1; i <= 32; i++) {
+                calls.push(input.updateAsync({ color: i }).then(function() {
+                    order.push(i * 2);
+                }));
+                calls.push(input.getSettingsAsync().then(function(settings: ISettings) {
+                    expect(settings.color).to.equal(i);
+                    order.push(i * 2 + 1);
+                }));
+            }
+            await Promise.all(calls);
+
+            order.forEach(function(entry: number, index: number) {
+                expect(entry).to.equal(index + 2);
+            });
+            input.release();
+        });
+    });
+});
@@ -55,6 +55,16 @@ describe('osn-scene', () => {
             const scene = createScene('create_test');
             scene.release();
         });
+
+        it('Create scene without blocking the event loop', async () => {
+            const scene = await osn.SceneFactory.createAsync('create_async_test');
+
+            // Checking if scene was created correctly
+            expect(scene).to.not.equal(undefined);
+            expect(scene.id).to.equal('scene');
+            expect(scene.name).to.equal('create_async_test');
+            scene.release();
+        });
     });
 
     context('# Duplicate', () => {
@@ -251,4 +261,59 @@ describe('osn-scene', () => {
             scene.release();
         });
     });
+
+    context('# GetSnapshot', () => {
+        it('Get every item of a scene in one call', () => {
+            const scene = createScene('snapshot_test');
+            const input = createSource('color_source', 'snapshot_input');
+            const sceneItem = scene.add(input);
+            sceneItem.position = {x: 12, y: 34};
+            sceneItem.rotation = 90;
+            sceneItem.visible = false;
+
+            const snapshot = scene.getSnapshot();
+            const base = 0 * snapshot.stride;
+
+            expect(snapshot.count).to.equal(1);
+            expect(snapshot.names[0]).to.equal('snapshot_input');
+            expect(snapshot.types[0]).to.equal('color_source');
+            expect(snapshot.u32[base + osn.ESnapshotField.ItemIdLow]).to.equal(sceneItem.id);
+            expect(snapshot.u32[base + osn.ESnapshotField.SourceType]).to.equal(osn.ESourceType.Input);
+            expect(snapshot.f32[base + osn.ESnapshotField.PositionX]).to.equal(12);
+            expect(snapshot.f32[base + osn.ESnapshotField.PositionY]).to.equal(34);
+            expect(snapshot.f32[base + osn.ESnapshotField.Rotation]).to.equal(90);
+            expect(snapshot.u32[base + osn.ESnapshotField.Flags] & osn.ESnapshotFlags.Visible).to.equal(0);
+
+            sceneItem.remove();
+            input.release();
+            scene.release();
+        });
+    });
+
+    context('# UpdateItems', () => {
+        it('Apply changes to many items at once', () => {
+            const scene = createScene('update_items_test');
+            const input = createSource('color_source', 'update_items_input');
+            const first = scene.add(input);
+            const second = scene.add(input);
+
+            const status = scene.updateItems([
+                {item: first, position: {x: 10, y: 20}, rotation: 45},
+                {item: second, scale: {x: 2, y: 3}, visible: false}
+            ]);
+
+            expect(status).to.eql([0, 0]);
+            expect(first.position.x).to.equal(10);
+            expect(first.position.y).to.equal(20);
+            expect(first.rotation).to.equal(45);
+            expect(second.scale.x).to.equal(2);
+            expect(second.scale.y).to.equal(3);
+            expect(second.visible).to.equal(false);
+
+            first.remove();
+            second.remove();
+            input.release();
+            scene.release();
+        });
+    });
 });
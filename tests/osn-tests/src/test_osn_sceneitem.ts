@@ -346,4 +346,43 @@ describe('osn-sceneitem', () => {
             sceneItem.remove();
         });
     });
+
+    context('# Transform cache', () => {
+        it('Read back a transform changed by a setter', () => {
+            const scene = osn.SceneFactory.fromName(sceneName);
+            const source = createInputSource('image_source', 'cache_source');
+            const sceneItem = scene.add(source);
+
+            // Fill the cache, then change the item behind it
+            expect(sceneItem.position.x).to.not.equal(undefined);
+            sceneItem.position = {x: 120, y: 240};
+            sceneItem.rotation = 45;
+
+            expect(sceneItem.position.x).to.equal(120);
+            expect(sceneItem.position.y).to.equal(240);
+            expect(sceneItem.transformInfo.rotation).to.equal(45);
+            sceneItem.remove();
+        });
+
+        it('Read back a transform of an item in a private duplicate', () => {
+            const scene = osn.SceneFactory.fromName(sceneName);
+            const source = createInputSource('image_source', 'cache_private_source');
+            scene.add(source);
+
+            const duplicate = scene.duplicate('cache_private_scene', osn.ESceneDupType.PrivateRefs);
+            const sceneItem = duplicate.findItem('cache_private_source');
+            expect(sceneItem).to.not.equal(undefined);
+
+            expect(sceneItem.position.x).to.not.equal(undefined);
+            sceneItem.position = {x: 30, y: 60};
+            sceneItem.rotation = 90;
+
+            expect(sceneItem.position.x).to.equal(30);
+            expect(sceneItem.position.y).to.equal(60);
+            expect(sceneItem.transformInfo.rotation).to.equal(90);
+
+            duplicate.release();
+            scene.findItem('cache_private_source').remove();
+        });
+    });
 });
\ No newline at end of file
@@ -462,4 +462,140 @@ describe('osn-source', () => {
             });
         });
     });
+
+    context('# Incremental GetProperties', () => {
+        it('Reflect setting changes in properties fetched again', () => {
+            const input = osn.InputFactory.create('color_source', 'properties_diff_input', { color: 1 });
+
+            // First fetch is a full one, later ones only carry the changes
+            expect(input.properties.get('color').value).to.equal(1);
+            expect(input.properties.get('color').value).to.equal(1);
+
+            input.update({ color: 2 });
+            const properties = input.properties;
+            expect(properties.get('color').value).to.equal(2);
+            expect(properties.count()).to.not.equal(0);
+
+            input.release();
+        });
+    });
+
+    context('# Property arena', () => {
+        it('Decode every property of a full fetch', () => {
+            const input = osn.InputFactory.create('ffmpeg_source', 'properties_arena_input');
+            const properties = input.properties;
+
+            let count = 0;
+            for (let property = properties.first(); property; property = property.next()) {
+                expect(property.name).to.not.equal('');
+                expect(properties.get(property.name).type).to.equal(property.type);
+                count++;
+            }
+            expect(count).to.equal(properties.count());
+
+            input.release();
+        });
+    });
+
+    context('# Binary settings', () => {
+        it('Keep settings types through create, update and get', () => {
+            const input = osn.InputFactory.create('color_source', 'binary_settings_input', {
+                color: 5,
+                nested: { ratio: 1.5, label: 'label', flag: true },
+                list: [{ value: 1 }, { value: 2 }]
+            });
+
+            let settings = input.settings;
+            expect(settings.color).to.equal(5);
+            expect(settings.nested).to.deep.equal({ ratio: 1.5, label: 'label', flag: true });
+            expect(settings.list).to.deep.equal([{ value: 1 }, { value: 2 }]);
+
+            input.update({ color: 6, text: 'üñíçødé' });
+            settings = input.settings;
+            expect(settings.color).to.equal(6);
+            expect(settings.text).to.equal('üñíçødé');
+
+            input.release();
+        });
+
+        it('Fail to update with settings that throw while read', () => {
+            const input = osn.InputFactory.create('color_source', 'binary_settings_throw', { color: 3 });
+            const settings = {
+                get color(): number {
+                    throw new Error('unreadable setting');
+                }
+            };
+
+            expect(function() {
+                input.update(settings);
+            }).to.throw('unreadable setting');
+            expect(input.settings.color).to.equal(3);
+
+            input.release();
+        });
+
+        it('Fail to update with settings that contain themselves', () => {
+            const input = osn.InputFactory.create('color_source', 'binary_settings_cycle', { color: 3 });
+            const settings: any = { color: 4, nested: { flag: true } };
+            settings.nested.parent = settings;
+
+            expect(function() {
+                input.update(settings);
+            }).to.throw(TypeError);
+            expect(input.settings.color).to.equal(3);
+
+            // The same object twice is not a cycle
+            const shared = { flag: true };
+            input.update({ color: 5, first: shared, second: shared });
+            expect(input.settings.second).to.deep.equal({ flag: true });
+
+            input.release();
+        });
+    });
+
+    context('# Settings patch', () => {
+        it('Patch top level and nested settings', () => {
+            const input = osn.InputFactory.create('color_source', 'settings_patch_input', {
+                color: 5,
+                nested: { ratio: 1.5, label: 'label' }
+            });
+
+            input.patchSettings([
+                { path: 'color', value: 7 },
+                { path: 'nested.label', value: 'patched' },
+                { path: 'text', value: 'added' }
+            ]);
+
+            // Pending patches are applied before settings are read
+            const settings = input.settings;
+            expect(settings.color).to.equal(7);
+            expect(settings.nested).to.deep.equal({ ratio: 1.5, label: 'patched' });
+            expect(settings.text).to.equal('added');
+
+            input.release();
+        });
+
+        it('Keep the last value of merged patches', () => {
+            const input = osn.InputFactory.create('color_source', 'settings_patch_merge');
+
+            for (let i = 0; i < 100; i++) {
+                input.patchSettings([{ path: 'color', value: i }]);
+            }
+
+            expect(input.settings.color).to.equal(99);
+            input.release();
+        });
+
+        it('Fail to patch with malformed operations', () => {
+            const input = osn.InputFactory.create('color_source', 'settings_patch_invalid', { color: 5 });
+
+            expect(function() {
+                input.patchSettings([{ path: 'color', value: 9 }, { value: 1 } as any]);
+            }).to.throw();
+
+            // None of the operations of a rejected patch are applied
+            expect(input.settings.color).to.equal(5);
+            input.release();
+        });
+    });
 });
\ No newline at end of file